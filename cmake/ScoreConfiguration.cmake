@@ -31,6 +31,7 @@ option(SCORE_INSTALL_HEADERS "Install headers" OFF)
 
 option(SCORE_FX_DESIGNER "FX GUI designer" OFF)
 option(SCORE_FAST_DEV_BUILD "Disables some features for faster development" OFF)
+option(SCORE_DEBUG_AUDIO_ALLOCATIONS "Trap on heap allocations in the audio thread" OFF)
 set(CMAKE_DEBUG_POSTFIX "")
 if(APPLE)
   set(SCORE_OPENGL ON)
@@ -47,6 +48,10 @@ endif()
 add_definitions(-DQT_DISABLE_DEPRECATED_BEFORE=0x050800)
 add_definitions(-DQT_NO_KEYWORDS)
 
+if(SCORE_DEBUG_AUDIO_ALLOCATIONS)
+  add_definitions(-DSCORE_DEBUG_AUDIO_ALLOCATIONS)
+endif()
+
 if(UNIX AND NOT APPLE AND SCORE_DEPLOYMENT_BUILD)
   set(SCORE_BUILD_FOR_PACKAGE_MANAGER ON)
 endif()
@@ -110,8 +110,7 @@ public:
       delete &m;
 
     m_map.clear();
-    m_map.m_map = std::move(new_map.m_map);
-    m_map.m_order = std::move(new_map.m_order);
+    m_map.assign(std::move(new_map));
 
     replaced();
   }
@@ -28,6 +28,7 @@ public:
       , m_id{std::move(id)}
   {
     m_id.m_ptr = this;
+    this->updateIdentity();
   }
 
   template <typename Visitor>
@@ -37,6 +38,7 @@ public:
     using vis_type = typename std::remove_reference_t<Visitor>::type;
     TSerializer<vis_type, IdentifiedObject<model>>::writeTo(v, *this);
     m_id.m_ptr = this;
+    this->updateIdentity();
   }
 
   ~IdentifiedObject() override = default;
@@ -50,6 +52,7 @@ public:
     m_id = id;
     m_path_cache.unsafePath().vec().clear();
     m_id.m_ptr = this;
+    this->updateIdentity();
   }
 
   void setId(id_type&& id) noexcept
@@ -57,6 +60,7 @@ public:
     m_id = std::move(id);
     m_path_cache.unsafePath().vec().clear();
     m_id.m_ptr = this;
+    this->updateIdentity();
   }
 
   void resetCache() const noexcept override { m_path_cache.unsafePath().vec().clear(); }
@@ -2,9 +2,116 @@
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include "IdentifiedObjectAbstract.hpp"
 
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/detail/hash.hpp>
+#include <ossia/detail/small_vector.hpp>
+
+#include <mutex>
+#include <unordered_map>
+
 #include <wobjectimpl.h>
 W_OBJECT_IMPL(IdentifiedObjectAbstract)
+
+namespace
+{
+struct IdentityKey
+{
+  const QObject* parent{};
+  int32_t id{};
+
+  bool operator==(const IdentityKey& other) const noexcept
+  {
+    return parent == other.parent && id == other.id;
+  }
+};
+
+struct IdentityKeyHash
+{
+  std::size_t operator()(const IdentityKey& k) const noexcept
+  {
+    std::size_t seed = std::hash<const QObject*>{}(k.parent);
+    ossia::hash_combine(seed, k.id);
+    return seed;
+  }
+};
+
+/**
+ * @brief Maps (parent, id) to the identified objects.
+ *
+ * Children of different types can share an identifier, e.g. the intervals
+ * and states of a scenario, thus they are disambiguated by object name.
+ */
+struct IdentityRegistry
+{
+  std::mutex mutex;
+  std::unordered_map<
+      IdentityKey, ossia::small_vector<IdentifiedObjectAbstract*, 2>, IdentityKeyHash>
+      objects;
+
+  static IdentityRegistry& instance() noexcept
+  {
+    // Leaked on purpose: objects may still be destroyed during static destruction
+    static auto& reg = *new IdentityRegistry;
+    return reg;
+  }
+};
+}
+
 IdentifiedObjectAbstract::~IdentifiedObjectAbstract()
 {
+  unregisterIdentity();
   identified_object_destroyed(this);
 }
+
+IdentifiedObjectAbstract* IdentifiedObjectAbstract::findIdentifiedChild(
+    const QObject* parent, const QString& name, int32_t id) noexcept
+{
+  auto& reg = IdentityRegistry::instance();
+  std::lock_guard l{reg.mutex};
+
+  auto it = reg.objects.find(IdentityKey{parent, id});
+  if(it == reg.objects.end())
+    return nullptr;
+
+  for(auto obj : it->second)
+  {
+    // The parent or name may have changed since the object was registered
+    if(obj->parent() == parent && obj->objectName() == name)
+      return obj;
+  }
+  return nullptr;
+}
+
+void IdentifiedObjectAbstract::updateIdentity() noexcept
+{
+  const QObject* parent = this->parent();
+  const int32_t id = id_val();
+  if(m_registered && m_registeredParent == parent && m_registeredId == id)
+    return;
+
+  unregisterIdentity();
+
+  auto& reg = IdentityRegistry::instance();
+  std::lock_guard l{reg.mutex};
+  reg.objects[IdentityKey{parent, id}].push_back(this);
+  m_registeredParent = parent;
+  m_registeredId = id;
+  m_registered = true;
+}
+
+void IdentifiedObjectAbstract::unregisterIdentity() noexcept
+{
+  if(!m_registered)
+    return;
+
+  auto& reg = IdentityRegistry::instance();
+  std::lock_guard l{reg.mutex};
+  if(auto it = reg.objects.find(IdentityKey{m_registeredParent, m_registeredId});
+     it != reg.objects.end())
+  {
+    ossia::remove_erase(it->second, this);
+    if(it->second.empty())
+      reg.objects.erase(it);
+  }
+  m_registered = false;
+}
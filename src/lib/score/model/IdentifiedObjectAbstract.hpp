@@ -29,6 +29,26 @@ public:
 
   virtual void resetCache() const noexcept = 0;
 
+  /**
+   * @brief Look for a child of parent with a given object name and identifier.
+   *
+   * This uses a registry of all the identified objects, indexed by
+   * parent and identifier, instead of going through the children of parent.
+   *
+   * @return nullptr if the object is not registered with this parent:
+   * objects which changed parent after their last registration are only
+   * found again once updateIdentity is called.
+   */
+  static IdentifiedObjectAbstract*
+  findIdentifiedChild(const QObject* parent, const QString& name, int32_t id) noexcept;
+
+  /**
+   * @brief Register the current parent and identifier of the object.
+   *
+   * Called by IdentifiedObject when constructed and when the identifier changes.
+   */
+  void updateIdentity() noexcept;
+
 protected:
   using QObject::QObject;
   IdentifiedObjectAbstract(const QString& name, QObject* parent) noexcept
@@ -36,6 +56,13 @@ protected:
     QObject::setObjectName(name);
     QObject::setParent(parent);
   }
+
+private:
+  void unregisterIdentity() noexcept;
+
+  const QObject* m_registeredParent{};
+  int32_t m_registeredId{};
+  bool m_registered{};
 };
 
 W_REGISTER_ARGTYPE(IdentifiedObjectAbstract*)
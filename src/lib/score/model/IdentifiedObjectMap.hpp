@@ -4,7 +4,8 @@
 
 #include <tsl/hopscotch_map.h>
 
-#include <list>
+#include <algorithm>
+#include <iterator>
 #include <vector>
 // This file contains a fast map for items based on their identifier,
 // based on boost's multi-index maps.
@@ -20,15 +21,70 @@ class IdContainer
 // We have to write two implementations since const_mem_fun does not handle
 // inheritance.
 
+/**
+ * @brief Iterator over the elements of an IdContainer.
+ *
+ * It stores an index instead of a pointer so that it stays valid when
+ * elements are added to the container, and skips the removed elements.
+ */
+template <typename Element, bool Reverse>
+struct id_container_iterator
+{
+  using self_type = id_container_iterator;
+  using value_type = Element;
+  using reference = Element&;
+  using pointer = Element*;
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+
+  const std::vector<Element*>* storage{};
+  std::ptrdiff_t index{};
+
+  // Elements are stored in the reverse of the iteration order
+  static constexpr std::ptrdiff_t step = Reverse ? 1 : -1;
+
+  void skip_removed() noexcept
+  {
+    const auto N = std::ptrdiff_t(storage->size());
+    while(index >= 0 && index < N && !(*storage)[index])
+      index += step;
+  }
+
+  self_type& operator++() noexcept
+  {
+    index += step;
+    skip_removed();
+    return *this;
+  }
+  self_type operator++(int) noexcept
+  {
+    self_type i = *this;
+    ++*this;
+    return i;
+  }
+
+  Element& operator*() const noexcept { return *(*storage)[index]; }
+  Element* operator->() const noexcept { return (*storage)[index]; }
+  bool operator==(const self_type& rhs) const noexcept { return index == rhs.index; }
+  bool operator!=(const self_type& rhs) const noexcept { return index != rhs.index; }
+};
+
 /** This map is for classes which inherit from
  * IdentifiedObject<T> and don't have an id() method by themselves, e.g. all
  * the model objects.
  *
  * Additionally, items are ordered; iteration occurs on the ordered iterators.
+ * New items come first.
  *
  * In the implementation :
- * * `get<0>()` gets the hashed (like std::unordered_map) iterator.
- * * `get<1>()` gets the ordered (like std::vector) iterator.
+ * * `m_map` maps identifiers to the items and their position in `m_order`.
+ * * `m_order` stores the items contiguously, in the reverse of the iteration
+ *   order so that insertion is an append. Removal leaves a null tombstone
+ *   which is skipped by iterators ; tombstones are compacted away on insertion
+ *   when they outnumber the items.
+ *
+ * Iterators stay valid across insertions and removals, unless an insertion
+ * triggers a compaction.
  */
 template <typename Element, typename Model>
 class IdContainer<
@@ -37,17 +93,16 @@ class IdContainer<
 {
 public:
   using model_type = Model;
-  using order_t = std::list<Element*>;
-  using map_t
-      = tsl::hopscotch_map<Id<Model>, std::pair<Element*, typename order_t::iterator>>;
+  using order_t = std::vector<Element*>;
+  using map_t = tsl::hopscotch_map<Id<Model>, std::pair<Element*, std::size_t>>;
   map_t m_map;
   order_t m_order;
+  std::size_t m_tombstones{};
 
   using value_type = Element;
-  using iterator = score::indirect_iterator<typename order_t::iterator>;
-  using const_iterator = score::indirect_iterator<typename order_t::const_iterator>;
-  using const_reverse_iterator
-      = score::indirect_iterator<typename order_t::const_reverse_iterator>;
+  using iterator = id_container_iterator<Element, false>;
+  using const_iterator = id_container_iterator<Element, false>;
+  using const_reverse_iterator = id_container_iterator<Element, true>;
 
   IdContainer() INLINE_EXPORT = default;
   IdContainer(const IdContainer& other) = delete;
@@ -58,38 +113,31 @@ public:
   ~IdContainer() INLINE_EXPORT
   {
     // To ensure that children are deleted before their parents
-    for(auto elt : m_order)
+    for(auto it = m_order.rbegin(); it != m_order.rend(); ++it)
     {
-      delete elt;
+      delete *it;
     }
   }
 
-  auto& ordered() INLINE_EXPORT { return m_order; }
-
   const_iterator begin() const INLINE_EXPORT
   {
-    return score::make_indirect_iterator(this->m_order.begin());
+    const_iterator it{&m_order, std::ptrdiff_t(m_order.size()) - 1};
+    it.skip_removed();
+    return it;
   }
   const_reverse_iterator rbegin() const INLINE_EXPORT
   {
-    return score::make_indirect_iterator(this->m_order.rbegin());
-  }
-  const_iterator cbegin() const INLINE_EXPORT
-  {
-    return score::make_indirect_iterator(this->m_order.cbegin());
-  }
-  const_iterator end() const INLINE_EXPORT
-  {
-    return score::make_indirect_iterator(this->m_order.end());
+    const_reverse_iterator it{&m_order, 0};
+    it.skip_removed();
+    return it;
   }
+  const_iterator cbegin() const INLINE_EXPORT { return begin(); }
+  const_iterator end() const INLINE_EXPORT { return const_iterator{&m_order, -1}; }
   const_reverse_iterator rend() const INLINE_EXPORT
   {
-    return score::make_indirect_iterator(this->m_order.rend());
-  }
-  const_iterator cend() const INLINE_EXPORT
-  {
-    return score::make_indirect_iterator(this->m_order.cend());
+    return const_reverse_iterator{&m_order, std::ptrdiff_t(m_order.size())};
   }
+  const_iterator cend() const INLINE_EXPORT { return end(); }
 
   std::size_t size() const INLINE_EXPORT { return m_map.size(); }
 
@@ -97,19 +145,29 @@ public:
 
   std::vector<Element*> as_vec() const INLINE_EXPORT
   {
-    return std::vector<Element*>(m_order.begin(), m_order.end());
+    std::vector<Element*> v;
+    v.reserve(size());
+    for(auto it = begin(); it != end(); ++it)
+      v.push_back(&*it);
+    return v;
   }
 
   score::IndirectContainer<Element> as_indirect_vec() const INLINE_EXPORT
   {
-    return score::IndirectContainer<Element>(m_order.begin(), m_order.end());
+    score::IndirectContainer<Element> v;
+    for(auto it = begin(); it != end(); ++it)
+      v.push_back(&*it);
+    return v;
   }
 
   void insert(value_type* t) INLINE_EXPORT
   {
     SCORE_ASSERT(m_map.find(t->id()) == m_map.end());
-    m_order.push_front(t);
-    m_map.insert({t->id(), {t, m_order.begin()}});
+    if(m_tombstones > 16 && m_tombstones > m_map.size())
+      compact();
+
+    m_order.push_back(t);
+    m_map.insert({t->id(), {t, m_order.size() - 1}});
   }
 
   void remove(typename map_t::iterator it) INLINE_EXPORT
@@ -118,7 +176,7 @@ public:
 
     if(it != this->m_map.end())
     {
-      m_order.erase(it->second.second);
+      erase_from_order(it->second.second);
       m_map.erase(it);
     }
   }
@@ -128,7 +186,7 @@ public:
 
     if(it != this->m_map.end())
     {
-      m_order.erase(it->second.second);
+      erase_from_order(it->second.second);
       m_map.erase(it);
     }
   }
@@ -139,22 +197,60 @@ public:
   {
     m_map.clear();
     m_order.clear();
+    m_tombstones = 0;
     // TODO why no delete ?!
     // e.g. in some cases (Curve::Model::clear()) it deletes afterwards
     // but not in Scenario destructor
   }
 
+  //! Take the items of another container, which is left empty.
+  void assign(IdContainer&& other) INLINE_EXPORT
+  {
+    m_map = std::move(other.m_map);
+    m_order = std::move(other.m_order);
+    m_tombstones = other.m_tombstones;
+    other.clear();
+  }
+
+  /**
+   * @brief Moves an item in the iteration order.
+   *
+   * @param next The item will come right before this one, or last if not set.
+   */
+  void put_before(const Id<Model>& id, const Id<Model>* next) INLINE_EXPORT
+  {
+    compact();
+
+    auto it = m_map.find(id);
+    SCORE_ASSERT(it != m_map.end());
+    Element* elt = it->second.first;
+    m_order.erase(m_order.begin() + it->second.second);
+
+    if(next)
+    {
+      auto next_it = m_map.find(*next);
+      SCORE_ASSERT(next_it != m_map.end());
+      auto pos = std::find(m_order.begin(), m_order.end(), next_it->second.first);
+      m_order.insert(pos + 1, elt);
+    }
+    else
+    {
+      m_order.insert(m_order.begin(), elt);
+    }
+
+    reindex();
+  }
+
   const_iterator find(const Id<Model>& id) const INLINE_EXPORT
   {
     auto it = this->m_map.find(id);
     if(it != this->m_map.end())
     {
-      return score::make_indirect_iterator(
-          (typename order_t::const_iterator)it->second.second);
+      return const_iterator{&m_order, std::ptrdiff_t(it->second.second)};
     }
     else
     {
-      return score::make_indirect_iterator(this->m_order.end());
+      return end();
     }
   }
 
@@ -171,6 +267,37 @@ public:
     id.m_ptr = item->second.first;
     return safe_cast<Element&>(*item->second.first);
   }
+
+private:
+  void erase_from_order(std::size_t index) noexcept
+  {
+    m_order[index] = nullptr;
+    m_tombstones++;
+
+    // Removing the first items, e.g. when clearing, does not leave tombstones
+    while(!m_order.empty() && !m_order.back())
+    {
+      m_order.pop_back();
+      m_tombstones--;
+    }
+  }
+
+  void compact() noexcept
+  {
+    if(m_tombstones == 0)
+      return;
+
+    m_order.erase(
+        std::remove(m_order.begin(), m_order.end(), nullptr), m_order.end());
+    m_tombstones = 0;
+    reindex();
+  }
+
+  void reindex() noexcept
+  {
+    for(std::size_t i = 0, N = m_order.size(); i < N; i++)
+      m_map.find(m_order[i]->id()).value().second = i;
+  }
 };
 
 /** This specialization is for classes which directly have an id() method
@@ -147,6 +147,32 @@ QString ObjectPath::toString() const noexcept
   return s;
 }
 
+static IdentifiedObjectAbstract*
+findChild(const QObject* parent, const ObjectIdentifier& identifier) noexcept
+{
+  // Fast path: look into the registry of identified objects
+  if(auto obj = IdentifiedObjectAbstract::findIdentifiedChild(
+         parent, identifier.objectName(), identifier.id()))
+    return obj;
+
+  // The object may have been moved to another parent since it was registered:
+  // look for it among the children and register it again.
+  for(QObject* child : parent->children())
+  {
+    if(child->objectName() == identifier.objectName())
+    {
+      auto itf = safe_cast<IdentifiedObjectAbstract*>(child);
+      if(itf->id_val() == identifier.id())
+      {
+        itf->updateIdentity();
+        return itf;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
 QObject* ObjectPath::find_impl(const score::DocumentContext& ctx) const
 {
   using namespace score;
@@ -155,28 +181,9 @@ QObject* ObjectPath::find_impl(const score::DocumentContext& ctx) const
 
   for(const auto& currentObjIdentifier : m_objectIdentifiers)
   {
-    const QObjectList& children = obj->children();
-    QObject* found = nullptr;
-
-    for(int i = 0; i < children.size(); ++i)
-    {
-      obj = children.at(i);
-      SCORE_ASSERT(obj);
-      if(obj->objectName() == currentObjIdentifier.objectName())
-      {
-        auto itf = safe_cast<IdentifiedObjectAbstract*>(obj);
-        if(itf->id_val() == currentObjIdentifier.id())
-        {
-          found = itf;
-          break;
-        }
-      }
-    }
-
-    if(found)
+    if(auto found = findChild(obj, currentObjIdentifier))
     {
       obj = found;
-      SCORE_ASSERT(obj);
     }
     else
     {
@@ -198,24 +205,7 @@ QObject* ObjectPath::find_impl_unsafe(const score::DocumentContext& ctx) const n
 
   for(const auto& currentObjIdentifier : m_objectIdentifiers)
   {
-    const QObjectList& children = obj->children();
-    QObject* found = nullptr;
-
-    for(int i = 0; i < children.size(); ++i)
-    {
-      obj = children.at(i);
-      if(obj->objectName() == currentObjIdentifier.objectName())
-      {
-        auto itf = safe_cast<IdentifiedObjectAbstract*>(obj);
-        if(itf->id_val() == currentObjIdentifier.id())
-        {
-          found = itf;
-          break;
-        }
-      }
-    }
-
-    if(found)
+    if(auto found = findChild(obj, currentObjIdentifier))
     {
       obj = found;
     }
@@ -0,0 +1,129 @@
+#include "AllocationTrap.hpp"
+
+#if defined(SCORE_DEBUG_AUDIO_ALLOCATIONS) && __has_include(<execinfo.h>)
+#define SCORE_ALLOCATION_TRAP 1
+#include <execinfo.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#endif
+
+namespace Execution
+{
+#if defined(SCORE_ALLOCATION_TRAP)
+static thread_local bool g_trapArmed{};
+
+static void reportAllocation(std::size_t size) noexcept
+{
+  // Nothing here may allocate: write directly to stderr
+  g_trapArmed = false;
+
+  char msg[96];
+  const int n = std::snprintf(
+      msg, sizeof(msg), "\n[score] heap allocation of %zu bytes in audio tick:\n",
+      size);
+  if(n > 0)
+    ::write(STDERR_FILENO, msg, std::min(std::size_t(n), sizeof(msg) - 1));
+
+  void* frames[64];
+  const int count = ::backtrace(frames, 64);
+  ::backtrace_symbols_fd(frames, count, STDERR_FILENO);
+
+  std::raise(SIGTRAP);
+  g_trapArmed = true;
+}
+
+static void* trappedAlloc(std::size_t size)
+{
+  if(g_trapArmed)
+    reportAllocation(size);
+
+  if(size == 0)
+    size = 1;
+  if(auto p = std::malloc(size))
+    return p;
+  throw std::bad_alloc{};
+}
+
+static void* trappedAlignedAlloc(std::size_t size, std::align_val_t al)
+{
+  if(g_trapArmed)
+    reportAllocation(size);
+
+  const auto align = std::max(std::size_t(al), sizeof(void*));
+  void* p{};
+  if(::posix_memalign(&p, align, size == 0 ? 1 : size) == 0)
+    return p;
+  throw std::bad_alloc{};
+}
+
+ScopedAllocationTrap::ScopedAllocationTrap() noexcept
+    : m_previous{g_trapArmed}
+{
+  // backtrace() loads its unwinder on the first call, which allocates
+  static const bool warmup = [] {
+    void* frames[1];
+    ::backtrace(frames, 1);
+    return true;
+  }();
+  (void)warmup;
+
+  g_trapArmed = true;
+}
+
+ScopedAllocationTrap::~ScopedAllocationTrap()
+{
+  g_trapArmed = m_previous;
+}
+
+ScopedAllocationTrap::Allow::Allow() noexcept
+    : m_previous{g_trapArmed}
+{
+  g_trapArmed = false;
+}
+
+ScopedAllocationTrap::Allow::~Allow()
+{
+  g_trapArmed = m_previous;
+}
+#else
+ScopedAllocationTrap::ScopedAllocationTrap() noexcept { }
+ScopedAllocationTrap::~ScopedAllocationTrap() { }
+ScopedAllocationTrap::Allow::Allow() noexcept { }
+ScopedAllocationTrap::Allow::~Allow() { }
+#endif
+}
+
+#if defined(SCORE_ALLOCATION_TRAP)
+// Replacements of the global allocation functions.
+// The nothrow and array versions of the standard library forward to these.
+void* operator new(std::size_t size)
+{
+  return Execution::trappedAlloc(size);
+}
+void* operator new(std::size_t size, std::align_val_t al)
+{
+  return Execution::trappedAlignedAlloc(size, al);
+}
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+#endif
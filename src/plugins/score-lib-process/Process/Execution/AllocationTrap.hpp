@@ -0,0 +1,37 @@
+#pragma once
+#include <score_lib_process_export.h>
+
+namespace Execution
+{
+/**
+ * @brief Traps on heap allocations done on the audio thread during a tick.
+ *
+ * Only active in builds configured with SCORE_DEBUG_AUDIO_ALLOCATIONS, which
+ * replace the global operator new: while a ScopedAllocationTrap exists on a
+ * thread, any allocation on that thread prints a backtrace on stderr and raises
+ * SIGTRAP, so that the debugger stops on the offending call.
+ * In other builds this does nothing.
+ */
+struct SCORE_LIB_PROCESS_EXPORT ScopedAllocationTrap
+{
+  ScopedAllocationTrap() noexcept;
+  ~ScopedAllocationTrap();
+  ScopedAllocationTrap(const ScopedAllocationTrap&) = delete;
+  ScopedAllocationTrap& operator=(const ScopedAllocationTrap&) = delete;
+
+  //! Lets a known allocation through, e.g. when reporting an error.
+  struct SCORE_LIB_PROCESS_EXPORT Allow
+  {
+    Allow() noexcept;
+    ~Allow();
+    Allow(const Allow&) = delete;
+    Allow& operator=(const Allow&) = delete;
+
+  private:
+    bool m_previous{};
+  };
+
+private:
+  bool m_previous{};
+};
+}
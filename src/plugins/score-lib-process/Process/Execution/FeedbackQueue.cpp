@@ -0,0 +1,71 @@
+#include "FeedbackQueue.hpp"
+
+#include <array>
+
+namespace Execution
+{
+FeedbackQueue::FeedbackQueue()
+{
+  m_pending.reserve(1024);
+  m_index.reserve(1024);
+}
+
+FeedbackQueue::~FeedbackQueue() = default;
+
+void FeedbackQueue::fetch()
+{
+  std::array<Update, 64> batch;
+  std::size_t n = 0;
+  while((n = m_queue.try_dequeue_bulk(batch.begin(), batch.size())) > 0)
+  {
+    for(std::size_t i = 0; i < n; i++)
+    {
+      auto& update = batch[i];
+      auto [it, inserted] = m_index.emplace(update.target, m_pending.size());
+      if(inserted)
+        m_pending.push_back(std::move(update));
+      else
+        m_pending[it->second].cmd = std::move(update.cmd);
+    }
+  }
+}
+
+bool FeedbackQueue::apply(std::chrono::steady_clock::time_point deadline)
+{
+  fetch();
+
+  std::size_t applied = 0;
+  const std::size_t N = m_pending.size();
+  while(applied < N)
+  {
+    m_pending[applied++].cmd();
+    if(std::chrono::steady_clock::now() >= deadline)
+      break;
+  }
+
+  if(applied == N)
+  {
+    m_pending.clear();
+    m_index.clear();
+    return true;
+  }
+
+  // Keep the remaining updates in their order for the next frame
+  m_pending.erase(m_pending.begin(), m_pending.begin() + applied);
+  m_index.clear();
+  for(std::size_t i = 0; i < m_pending.size(); i++)
+    m_index.emplace(m_pending[i].target, i);
+  return false;
+}
+
+void FeedbackQueue::applyAll()
+{
+  fetch();
+
+  for(auto& update : m_pending)
+    update.cmd();
+
+  m_pending.clear();
+  m_index.clear();
+}
+}
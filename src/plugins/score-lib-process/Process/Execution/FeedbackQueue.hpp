@@ -0,0 +1,64 @@
+#pragma once
+#include <Process/ExecutionContext.hpp>
+
+#include <ossia/detail/hash_map.hpp>
+
+#include <score_lib_process_export.h>
+
+#include <chrono>
+#include <vector>
+
+namespace Execution
+{
+/**
+ * @brief Updates of the user interface sent by the execution thread.
+ *
+ * Each update is keyed by the object it applies to, for instance an interval
+ * for its play position: when an object receives new updates before the GUI
+ * thread got to apply the previous ones, only the latest is applied.
+ *
+ * Updates which must all be applied in order go through the edition queue instead.
+ */
+class SCORE_LIB_PROCESS_EXPORT FeedbackQueue
+{
+public:
+  FeedbackQueue();
+  ~FeedbackQueue();
+
+  //! Called from the execution thread
+  void enqueue(const void* target, ExecutionCommand&& cmd)
+  {
+    m_queue.enqueue(Update{target, std::move(cmd)});
+  }
+
+  /**
+   * @brief Called from the GUI thread: applies the pending updates until the deadline.
+   *
+   * At least one update is applied on each call. The others are kept, in order,
+   * for the next call.
+   * @return false if some updates are still pending.
+   */
+  bool apply(std::chrono::steady_clock::time_point deadline);
+
+  //! Called from the GUI thread: applies all the pending updates.
+  void applyAll();
+
+  //! Number of updates waiting for the next call to apply.
+  std::size_t pending() const noexcept { return m_pending.size(); }
+
+private:
+  struct Update
+  {
+    const void* target{};
+    ExecutionCommand cmd;
+  };
+
+  void fetch();
+
+  moodycamel::ConcurrentQueue<Update> m_queue{1024};
+
+  // GUI thread only
+  std::vector<Update> m_pending;
+  ossia::hash_map<const void*, std::size_t> m_index;
+};
+}
@@ -0,0 +1,100 @@
+#include "FusedNode.hpp"
+
+namespace Execution
+{
+FusedNode::FusedNode(std::vector<ossia::node_ptr> members, std::vector<Link> links)
+    : m_members{std::move(members)}
+    , m_links{std::move(links)}
+{
+  for(auto& node : m_members)
+  {
+    for(auto* inl : node->root_inputs())
+      m_inlets.push_back(inl);
+    for(auto* outl : node->root_outputs())
+      m_outlets.push_back(outl);
+  }
+}
+
+FusedNode::~FusedNode() = default;
+
+void FusedNode::startTick() noexcept
+{
+  for(auto& link : m_links)
+    link.copied = 0;
+
+  const bool mute = muted();
+  for(auto& node : m_members)
+  {
+    node->requested_tokens.clear();
+    node->set_mute(mute);
+    node->set_executed(false);
+  }
+}
+
+void FusedNode::finishTick() noexcept
+{
+  // The graph clears the tokens of its own nodes once they have run:
+  // the members must not keep theirs when they go back in the graph.
+  for(auto& node : m_members)
+  {
+    node->requested_tokens.clear();
+    node->set_executed(true);
+  }
+}
+
+void FusedNode::run(const ossia::token_request& t, ossia::exec_state_facade e) noexcept
+{
+  const auto* first = requested_tokens.data();
+  const auto* last = first + requested_tokens.size();
+  const bool requested = &t >= first && &t < last;
+  if(requested && &t == first)
+    startTick();
+
+  // Every process of the chain requests the same tokens: they are run once
+  bool duplicate = false;
+  if(requested)
+  {
+    for(auto* other = first; other != &t; ++other)
+    {
+      if(other->prev_date == t.prev_date && other->date == t.date
+         && other->offset == t.offset)
+      {
+        duplicate = true;
+        break;
+      }
+    }
+  }
+
+  if(!duplicate)
+  {
+    const std::size_t n = m_members.size();
+    for(std::size_t i = 0; i < n; i++)
+    {
+      if(i > 0)
+        forward(m_links[i - 1]);
+
+      auto& node = *m_members[i];
+      if(requested)
+      {
+        node.requested_tokens.push_back(t);
+        node.run(node.requested_tokens.back(), e);
+      }
+      else
+      {
+        node.run(t, e);
+      }
+    }
+  }
+
+  if(requested && &t == last - 1)
+    finishTick();
+}
+
+void FusedNode::forward(Link& link) noexcept
+{
+  const auto& data = link.source->get_data();
+  for(std::size_t i = link.copied; i < data.size(); i++)
+    link.sink->write_value(data[i].value, data[i].timestamp);
+  link.copied = data.size();
+}
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <ossia/dataflow/graph_node.hpp>
+#include <ossia/dataflow/port.hpp>
+
+#include <score_lib_process_export.h>
+
+#include <vector>
+
+namespace Execution
+{
+/**
+ * @brief Runs a chain of nodes as a single node of the graph.
+ *
+ * The ports of the members are exposed as the ports of this node, so that the
+ * cables going in and out of the chain are connected to it.
+ * The values written on the cables between two members are forwarded directly
+ * after the first member has run.
+ *
+ * The processes of the members all request their tokens and set their mute
+ * state on this node: the members get them back before running, and are
+ * marked as executed afterwards, as the graph would do.
+ */
+class SCORE_LIB_PROCESS_EXPORT FusedNode final : public ossia::nonowning_graph_node
+{
+public:
+  struct Link
+  {
+    ossia::value_port* source{};
+    ossia::value_port* sink{};
+    std::size_t copied{};
+  };
+
+  FusedNode(std::vector<ossia::node_ptr> members, std::vector<Link> links);
+  ~FusedNode();
+
+  void run(const ossia::token_request& t, ossia::exec_state_facade e) noexcept override;
+
+private:
+  void startTick() noexcept;
+  void finishTick() noexcept;
+  static void forward(Link& link) noexcept;
+
+  std::vector<ossia::node_ptr> m_members;
+  std::vector<Link> m_links;
+};
+}
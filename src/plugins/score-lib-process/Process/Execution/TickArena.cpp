@@ -0,0 +1,57 @@
+#include "TickArena.hpp"
+
+#include <cstdint>
+
+namespace Execution
+{
+static thread_local TickArena* g_currentArena{};
+
+TickArena::TickArena(std::size_t capacity)
+    : m_buffer{new std::byte[capacity]}
+    , m_capacity{capacity}
+{
+}
+
+TickArena::~TickArena() = default;
+
+TickArena* TickArena::current() noexcept
+{
+  return g_currentArena;
+}
+
+void* TickArena::allocate(std::size_t bytes, std::size_t align) noexcept
+{
+  const auto base = reinterpret_cast<std::uintptr_t>(m_buffer.get());
+  const auto start = (base + m_used + align - 1) & ~(std::uintptr_t(align) - 1);
+  const std::size_t end = start - base + bytes;
+  if(end <= m_capacity)
+  {
+    m_used = end;
+    return reinterpret_cast<void*>(start);
+  }
+
+  // Does not fit: going to the heap here would happen during the tick
+  m_overflows.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+void TickArena::reset() noexcept
+{
+  if(m_used > m_peak.load(std::memory_order_relaxed))
+    m_peak.store(m_used, std::memory_order_relaxed);
+  m_used = 0;
+}
+
+TickArena::Scope::Scope(TickArena& arena) noexcept
+    : m_arena{arena}
+    , m_previous{g_currentArena}
+{
+  g_currentArena = &arena;
+}
+
+TickArena::Scope::~Scope()
+{
+  g_currentArena = m_previous;
+  m_arena.reset();
+}
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include <Process/Execution/AllocationTrap.hpp>
+
+#include <score_lib_process_export.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Execution
+{
+/**
+ * @brief Bump allocator for memory which only lives for the duration of a tick.
+ *
+ * The audio tick owns one arena, makes it current on the audio thread while the
+ * graph executes, and resets it once the tick is done: nodes can use it through
+ * TickAllocator for their temporary per-tick payloads instead of the heap.
+ *
+ * Allocating never locks nor calls malloc. Past the capacity, allocate()
+ * returns nullptr and the failure is counted in overflows(), which tells that
+ * the capacity should be raised. peak() and overflows() can be read from any
+ * thread, and are reported with the execution benchmarks.
+ */
+class SCORE_LIB_PROCESS_EXPORT TickArena
+{
+public:
+  static constexpr std::size_t defaultCapacity = 1024 * 1024;
+
+  explicit TickArena(std::size_t capacity = defaultCapacity);
+  TickArena(const TickArena&) = delete;
+  TickArena& operator=(const TickArena&) = delete;
+  ~TickArena();
+
+  //! Arena of the tick executing on the calling thread, or nullptr.
+  static TickArena* current() noexcept;
+
+  //! Returns nullptr if the arena is full.
+  void* allocate(
+      std::size_t bytes, std::size_t align = alignof(std::max_align_t)) noexcept;
+
+  bool owns(const void* p) const noexcept
+  {
+    auto b = static_cast<const std::byte*>(p);
+    return b >= m_buffer.get() && b < m_buffer.get() + m_capacity;
+  }
+
+  //! Gives back all the memory allocated since the last reset.
+  void reset() noexcept;
+
+  std::size_t capacity() const noexcept { return m_capacity; }
+
+  //! Largest amount of memory used during a tick.
+  std::size_t peak() const noexcept { return m_peak.load(std::memory_order_relaxed); }
+
+  //! Allocations which did not fit in the arena.
+  std::size_t overflows() const noexcept
+  {
+    return m_overflows.load(std::memory_order_relaxed);
+  }
+
+  //! Makes the arena current on this thread and resets it when going out of scope.
+  struct Scope
+  {
+    explicit Scope(TickArena& arena) noexcept;
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    TickArena& m_arena;
+    TickArena* m_previous{};
+  };
+
+private:
+  std::unique_ptr<std::byte[]> m_buffer;
+  std::size_t m_capacity{};
+  std::size_t m_used{};
+  std::atomic<std::size_t> m_peak{};
+  std::atomic<std::size_t> m_overflows{};
+};
+
+/**
+ * @brief Standard allocator over the current TickArena.
+ *
+ * Containers using it must not outlive the tick. Outside of a tick, for instance
+ * on the worker threads of a parallel graph, or when the arena is full, it uses
+ * the heap.
+ */
+template <typename T>
+struct TickAllocator
+{
+  using value_type = T;
+
+  TickAllocator() noexcept
+      : arena{TickArena::current()}
+  {
+  }
+  template <typename U>
+  TickAllocator(const TickAllocator<U>& other) noexcept
+      : arena{other.arena}
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    if(arena)
+    {
+      if(auto p = arena->allocate(n * sizeof(T), alignof(T)))
+        return static_cast<T*>(p);
+
+      // Already reported by the arena in overflows()
+      ScopedAllocationTrap::Allow allow;
+      return std::allocator<T>{}.allocate(n);
+    }
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    if(!arena || !arena->owns(p))
+      std::allocator<T>{}.deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const TickAllocator<U>& other) const noexcept
+  {
+    return arena == other.arena;
+  }
+
+  TickArena* arena{};
+};
+
+template <typename T>
+using tick_vector = std::vector<T, TickAllocator<T>>;
+}
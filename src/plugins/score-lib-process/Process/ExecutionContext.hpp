@@ -56,6 +56,7 @@ namespace Execution
 class ProcessComponent;
 class ProcessComponentFactory;
 class ProcessComponentFactoryList;
+class FeedbackQueue;
 struct SetupContext;
 namespace Settings
 {
@@ -108,6 +109,7 @@ struct SCORE_LIB_PROCESS_EXPORT Context
   ExecutionCommandQueue& executionQueue;
   EditionCommandQueue& editionQueue;
   GCCommandQueue& gcQueue;
+  FeedbackQueue& feedbackQueue;
   SetupContext& setup;
 
   const std::shared_ptr<ossia::graph_interface>& execGraph;
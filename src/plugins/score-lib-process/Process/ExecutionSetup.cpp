@@ -2,11 +2,16 @@
 
 #include <Process/Dataflow/Cable.hpp>
 #include <Process/Dataflow/Port.hpp>
+#include <Process/Execution/FusedNode.hpp>
+#include <Process/Execution/ProcessComponent.hpp>
 #include <Process/ExecutionContext.hpp>
 #include <Process/ExecutionFunctions.hpp>
 #include <Process/ExecutionSetup.hpp>
 #include <Process/Process.hpp>
 
+#include <score/model/ComponentUtils.hpp>
+#include <score/model/EntityMap.hpp>
+
 #include <ossia/dataflow/execution_state.hpp>
 #include <ossia/dataflow/for_each_port.hpp>
 #include <ossia/dataflow/graph/graph_interface.hpp>
@@ -59,8 +64,283 @@ std::optional<ossia::destination> makeDestination(
   return ossia::destination{*p, qual.accessors, qual.unit};
 }
 
+namespace
+{
+bool isFusable(const Process::ProcessModel& proc) noexcept
+{
+  if(!(proc.flags() & Process::ProcessFlags::Fusable))
+    return false;
+
+  // Looping and offsets change the tokens of the process
+  if(proc.loops() || proc.startOffset() != TimeVal::zero())
+    return false;
+
+  for(auto* inl : proc.inlets())
+    if(inl->type() != Process::PortType::Message)
+      return false;
+  for(auto* outl : proc.outlets())
+    if(outl->type() != Process::PortType::Message)
+      return false;
+  return true;
+}
+}
+
+void SetupContext::fuseControlChains(const score::EntityMap<Process::Cable>& cables)
+{
+  struct Candidate
+  {
+    FusedLink link;
+    const ossia::graph_node* source{};
+    const ossia::graph_node* sink{};
+  };
+
+  score::hash_map<const ossia::graph_node*, int> incoming;
+  score::hash_map<const ossia::graph_node*, ossia::node_ptr> nodes;
+  std::vector<Candidate> candidates;
+  for(const auto& cable : cables)
+  {
+    auto port_src = cable.source().try_find(context.doc);
+    auto port_snk = cable.sink().try_find(context.doc);
+    if(!port_src || !port_snk)
+      continue;
+
+    auto src_it = outlets.find(port_src);
+    auto snk_it = inlets.find(port_snk);
+    if(src_it == outlets.end() || snk_it == inlets.end())
+      continue;
+
+    const auto& [source_node, source_port] = src_it->second;
+    const auto& [sink_node, sink_port] = snk_it->second;
+    incoming[sink_node.get()]++;
+
+    // Delayed cables need the graph to keep the values until the next tick
+    const auto type = cable.type();
+    if(type != Process::CableType::ImmediateStrict
+       && type != Process::CableType::ImmediateGlutton)
+      continue;
+
+    nodes[source_node.get()] = source_node;
+    nodes[sink_node.get()] = sink_node;
+    candidates.push_back(
+        {{cable.id(), source_port, sink_port}, source_node.get(), sink_node.get()});
+  }
+
+  // A node is chained to the next one if it is the only one feeding it.
+  // Each node has at most one next and one previous node in its chain.
+  score::hash_map<const ossia::graph_node*, const Candidate*> next;
+  score::hash_map<const ossia::graph_node*, const Candidate*> prev;
+  for(const auto& c : candidates)
+  {
+    if(c.source == c.sink || incoming[c.sink] != 1 || next.contains(c.source))
+      continue;
+
+    auto src_proc = proc_map.find(c.source);
+    auto snk_proc = proc_map.find(c.sink);
+    if(src_proc == proc_map.end() || snk_proc == proc_map.end())
+      continue;
+    if(src_proc->second->parent() != snk_proc->second->parent())
+      continue;
+    if(!isFusable(*src_proc->second) || !isFusable(*snk_proc->second))
+      continue;
+
+    next[c.source] = &c;
+    prev[c.sink] = &c;
+  }
+
+  for(const auto& [head, first] : next)
+  {
+    if(prev.contains(head))
+      continue;
+
+    std::vector<ossia::node_ptr> members{nodes[head]};
+    std::vector<FusedLink> links;
+    for(auto c = first; c;)
+    {
+      members.push_back(nodes[c->sink]);
+      links.push_back(c->link);
+
+      auto it = next.find(c->sink);
+      c = it != next.end() ? it->second : nullptr;
+    }
+
+    fuse(members, links, cables);
+  }
+}
+
+void SetupContext::fuse(
+    const std::vector<std::shared_ptr<ossia::graph_node>>& members,
+    const std::vector<FusedLink>& links, const score::EntityMap<Process::Cable>& cables)
+{
+  auto chain = std::make_unique<FusedChain>();
+  chain->members = members;
+  for(auto& node : members)
+  {
+    auto proc = proc_map.at(node.get());
+    auto comp = score::findComponent<Execution::ProcessComponent>(proc->components());
+    if(!comp || !comp->OSSIAProcessPtr())
+      return;
+    chain->processes.push_back(comp->OSSIAProcessPtr());
+  }
+
+  auto is_member = [&](const ossia::node_ptr& node) {
+    return ossia::contains(members, node);
+  };
+
+  std::vector<FusedNode::Link> fused_links;
+  for(auto& link : links)
+  {
+    auto src = link.source->target<ossia::value_port>();
+    auto snk = link.sink->target<ossia::value_port>();
+    if(!src || !snk)
+      return;
+    fused_links.push_back({src, snk});
+    chain->links.push_back(link.cable);
+  }
+
+  // Any other cable inside the chain would make the fused node loop on itself
+  for(const auto& cable : cables)
+  {
+    auto port_src = cable.source().try_find(context.doc);
+    auto port_snk = cable.sink().try_find(context.doc);
+    auto src_it = port_src ? outlets.find(port_src) : outlets.end();
+    auto snk_it = port_snk ? inlets.find(port_snk) : inlets.end();
+    const bool from_chain = src_it != outlets.end() && is_member(src_it->second.first);
+    const bool to_chain = snk_it != inlets.end() && is_member(snk_it->second.first);
+    if(from_chain && to_chain && !ossia::contains(chain->links, cable.id()))
+      return;
+    if(from_chain || to_chain)
+      chain->cables.emplace_back(cable.id(), cable);
+  }
+
+  auto node = std::make_shared<FusedNode>(members, std::move(fused_links));
+  chain->node = node;
+
+  // The ports of the members are now reached through the fused node
+  for(auto it = inlets.begin(); it != inlets.end(); ++it)
+  {
+    if(is_member(it->second.first))
+    {
+      chain->inlets.emplace_back(it->first, it->second.first);
+      it.value().first = node;
+    }
+  }
+  for(auto it = outlets.begin(); it != outlets.end(); ++it)
+  {
+    if(is_member(it->second.first))
+    {
+      chain->outlets.emplace_back(it->first, it->second.first);
+      it.value().first = node;
+    }
+  }
+
+  auto ptr = chain.get();
+  for(auto& m : members)
+  {
+    m_fusedNodes[m.get()] = ptr;
+
+    auto proc = proc_map.at(m.get());
+    auto split = [this, ptr] { unfuse(*ptr); };
+    chain->connections.push_back(
+        connect(proc, &Process::ProcessModel::loopsChanged, this, split));
+    chain->connections.push_back(
+        connect(proc, &Process::ProcessModel::startOffsetChanged, this, split));
+  }
+  m_fusedNodes[node.get()] = ptr;
+  for(auto& [id, path] : chain->cables)
+    m_fusedCables[id] = ptr;
+
+  std::weak_ptr<ossia::graph_interface> wg = context.execGraph;
+  context.executionQueue.enqueue(
+      [wg, node, members = chain->members, processes = chain->processes] {
+    if(auto g = wg.lock())
+    {
+      for(auto& m : members)
+        g->remove_node(m);
+      g->add_node(node);
+    }
+    for(auto& p : processes)
+      p->node = node;
+  });
+
+  m_chains.push_back(std::move(chain));
+}
+
+void SetupContext::unfuse(const ossia::graph_node* node)
+{
+  if(auto it = m_fusedNodes.find(node); it != m_fusedNodes.end())
+    unfuse(*it->second);
+}
+
+void SetupContext::unfuse(FusedChain& chain)
+{
+  for(auto& con : chain.connections)
+    QObject::disconnect(con);
+
+  for(auto& [port, node] : chain.inlets)
+  {
+    auto it = inlets.find(port);
+    if(it != inlets.end() && it->second.first == chain.node)
+      it.value().first = node;
+  }
+  for(auto& [port, node] : chain.outlets)
+  {
+    auto it = outlets.find(port);
+    if(it != outlets.end() && it->second.first == chain.node)
+      it.value().first = node;
+  }
+
+  // The edges which go to the fused node are created again on the members
+  std::vector<ossia::edge_ptr> edges;
+  for(auto& [id, path] : chain.cables)
+  {
+    if(auto it = m_cables.find(id); it != m_cables.end())
+    {
+      edges.push_back(it->second);
+      m_cables.erase(it);
+    }
+    m_fusedCables.erase(id);
+  }
+
+  for(auto& m : chain.members)
+    m_fusedNodes.erase(m.get());
+  m_fusedNodes.erase(chain.node.get());
+
+  std::weak_ptr<ossia::graph_interface> wg = context.execGraph;
+  context.executionQueue.enqueue(
+      [wg, node = chain.node, members = chain.members, processes = chain.processes,
+       edges = std::move(edges)] {
+    if(auto g = wg.lock())
+    {
+      for(auto& e : edges)
+        g->disconnect(e);
+      g->remove_node(node);
+      for(auto& m : members)
+        g->add_node(m);
+    }
+    for(std::size_t i = 0; i < processes.size(); i++)
+      processes[i]->node = members[i];
+  });
+
+  auto cables = std::move(chain.cables);
+  auto it = ossia::find_if(m_chains, [&](auto& c) { return c.get() == &chain; });
+  SCORE_ASSERT(it != m_chains.end());
+  m_chains.erase(it);
+
+  for(auto& [id, path] : cables)
+    if(auto cable = path.try_find(context.doc))
+      connectCable(*cable);
+}
+
 void SetupContext::on_cableCreated(Process::Cable& c)
 {
+  // A new cable on a chain may change which nodes can be fused
+  if(auto port = c.source().try_find(context.doc))
+    if(auto it = outlets.find(port); it != outlets.end())
+      unfuse(it->second.first.get());
+  if(auto port = c.sink().try_find(context.doc))
+    if(auto it = inlets.find(port); it != inlets.end())
+      unfuse(it->second.first.get());
+
   connectCable(c);
 }
 
@@ -68,6 +348,9 @@ void SetupContext::on_cableRemoved(const Process::Cable& c)
 {
   if(!context.created)
     return;
+  if(auto chain = m_fusedCables.find(c.id()); chain != m_fusedCables.end())
+    unfuse(*chain->second);
+
   auto it = m_cables.find(c.id());
   if(it != m_cables.end())
   {
@@ -80,6 +363,12 @@ void SetupContext::connectCable(Process::Cable& cable)
 {
   if(!context.created)
     return;
+
+  // Values on the cables inside a chain are forwarded by the fused node
+  if(auto it = m_fusedCables.find(cable.id()); it != m_fusedCables.end())
+    if(ossia::contains(it->second->links, cable.id()))
+      return;
+
   ossia::node_ptr source_node{}, sink_node{};
   ossia::outlet_ptr source_port{};
   ossia::inlet_ptr sink_port{};
@@ -518,6 +807,15 @@ void SetupContext::replace_node(
     const std::shared_ptr<ossia::time_process>& process,
     const std::shared_ptr<ossia::graph_node>& node, Transaction& commands)
 {
+  for(auto& chain : m_chains)
+  {
+    if(ossia::contains(chain->processes, process))
+    {
+      unfuse(*chain);
+      break;
+    }
+  }
+
   commands.push_back([p = process, n = node]() mutable {
     using namespace std;
     swap(p->node, n);
@@ -530,6 +828,8 @@ void SetupContext::unregister_node(
 {
   if(node)
   {
+    unfuse(node.get());
+
     std::weak_ptr<ossia::graph_interface> wg = context.execGraph;
     std::weak_ptr<ossia::execution_state> ws = context.execState;
     context.executionQueue.enqueue([wg, ws, node] {
@@ -563,6 +863,8 @@ void SetupContext::unregister_node(
 {
   if(node)
   {
+    unfuse(node.get());
+
     std::weak_ptr<ossia::graph_interface> wg = context.execGraph;
     std::weak_ptr<ossia::execution_state> ws = context.execState;
     vec.push_back([wg, ws, node] {
@@ -595,6 +897,8 @@ void SetupContext::unregister_node_soft(
 {
   if(node)
   {
+    unfuse(node.get());
+
     std::weak_ptr<ossia::execution_state> ws = context.execState;
     vec.push_back([ws, node] {
       if(auto s = ws.lock())
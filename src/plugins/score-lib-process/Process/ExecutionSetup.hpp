@@ -2,6 +2,7 @@
 #include <Process/Dataflow/Cable.hpp>
 #include <Process/ExecutionContext.hpp>
 
+#include <score/model/path/Path.hpp>
 #include <score/tools/std/HashMap.hpp>
 
 #include <ossia/detail/flat_map.hpp>
@@ -16,6 +17,12 @@ namespace ossia
 class time_process;
 }
 
+namespace score
+{
+template <typename T>
+class EntityMap;
+}
+
 namespace Process
 {
 class ProcessModel;
@@ -154,6 +161,19 @@ struct SCORE_LIB_PROCESS_EXPORT SetupContext final
   void on_cableRemoved(const Process::Cable& c);
   void connectCable(Process::Cable& cable);
 
+  /**
+   * @brief Merges chains of message-only nodes into single graph nodes.
+   *
+   * A node is merged with the node that follows it when one of its outlets
+   * is the only source of data of the next node.
+   * The graph then has to sort and schedule a single node for the whole chain.
+   *
+   * Must be called once the nodes are registered, before the cables are
+   * connected. A chain is split again as soon as one of its nodes, or the
+   * cables around it, change.
+   */
+  void fuseControlChains(const score::EntityMap<Process::Cable>& cables);
+
   score::hash_map<Process::Outlet*, std::pair<ossia::node_ptr, ossia::outlet_ptr>>
       outlets;
   score::hash_map<Process::Inlet*, std::pair<ossia::node_ptr, ossia::inlet_ptr>> inlets;
@@ -177,6 +197,45 @@ struct SCORE_LIB_PROCESS_EXPORT SetupContext final
   score::hash_map<const ossia::graph_node*, const Process::ProcessModel*> proc_map;
 
 private:
+  struct FusedChain
+  {
+    std::shared_ptr<ossia::graph_node> node;
+    std::vector<std::shared_ptr<ossia::graph_node>> members;
+    std::vector<std::shared_ptr<ossia::time_process>> processes;
+
+    // Ports of the members, which were registered with their own node
+    std::vector<std::pair<Process::Inlet*, std::shared_ptr<ossia::graph_node>>>
+        inlets;
+    std::vector<std::pair<Process::Outlet*, std::shared_ptr<ossia::graph_node>>>
+        outlets;
+
+    // Cables between the members, which are handled by the fused node
+    std::vector<Id<Process::Cable>> links;
+
+    // Every cable connected to a member
+    std::vector<std::pair<Id<Process::Cable>, Path<Process::Cable>>> cables;
+
+    std::vector<QMetaObject::Connection> connections;
+  };
+
+  struct FusedLink
+  {
+    Id<Process::Cable> cable;
+    ossia::outlet* source{};
+    ossia::inlet* sink{};
+  };
+
+  void fuse(
+      const std::vector<std::shared_ptr<ossia::graph_node>>& members,
+      const std::vector<FusedLink>& links,
+      const score::EntityMap<Process::Cable>& cables);
+  void unfuse(FusedChain& chain);
+  void unfuse(const ossia::graph_node* node);
+
+  std::vector<std::unique_ptr<FusedChain>> m_chains;
+  score::hash_map<const ossia::graph_node*, FusedChain*> m_fusedNodes;
+  score::hash_map<Id<Process::Cable>, FusedChain*> m_fusedCables;
+
   template <typename Impl>
   void register_node_impl(
       const Process::Inlets& inlets, const Process::Outlets& outlets,
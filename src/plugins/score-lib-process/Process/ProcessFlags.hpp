@@ -52,6 +52,11 @@ enum ProcessFlags : int64_t
   //! The process is recordable
   Recordable = SCORE_FLAG(11),
 
+  //! The execution node only handles messages, its state only depends on the
+  //! messages it received and it is never replaced while playing:
+  //! it can be merged with the nodes it is chained with
+  Fusable = SCORE_FLAG(12),
+
   SupportsLasting = SupportsTemporal | TimeIndependent,
   ExternalEffect
   = SupportsTemporal | TimeIndependent | RequiresCustomData | ControlSurface,
@@ -0,0 +1,158 @@
+#include <Process/Execution/FusedNode.hpp>
+
+#include <ossia/dataflow/execution_state.hpp>
+#include <ossia/dataflow/graph/graph_interface.hpp>
+#include <ossia/dataflow/graph_edge.hpp>
+#include <ossia/dataflow/port.hpp>
+#include <ossia/network/value/value_conversion.hpp>
+
+#define CATCH_CONFIG_MAIN 1
+#if __has_include(<catch2/catch.hpp>)
+#include <catch2/catch.hpp>
+
+namespace
+{
+struct Source final : ossia::nonowning_graph_node
+{
+  Source() { m_outlets.push_back(&out); }
+
+  void run(const ossia::token_request& t, ossia::exec_state_facade) noexcept override
+  {
+    for(int i = 0; i < 3; i++)
+      out->write_value(float(t.date.impl + i), i);
+  }
+
+  ossia::value_outlet out;
+};
+
+struct Affine final : ossia::nonowning_graph_node
+{
+  Affine(float a, float b)
+      : a{a}
+      , b{b}
+  {
+    m_inlets.push_back(&in);
+    m_outlets.push_back(&out);
+  }
+
+  void run(const ossia::token_request&, ossia::exec_state_facade) noexcept override
+  {
+    for(auto& v : in->get_data())
+    {
+      const float res = a * ossia::convert<float>(v.value) + b;
+      out->write_value(res, v.timestamp);
+      received.push_back(res);
+    }
+  }
+
+  float a{}, b{};
+  ossia::value_inlet in;
+  ossia::value_outlet out;
+  std::vector<float> received;
+};
+
+struct Chain
+{
+  std::shared_ptr<Source> source = std::make_shared<Source>();
+  std::shared_ptr<Affine> first = std::make_shared<Affine>(2.f, 1.f);
+  std::shared_ptr<Affine> second = std::make_shared<Affine>(-0.5f, 3.f);
+};
+
+ossia::token_request token(int64_t prev, int64_t date)
+{
+  ossia::token_request t{};
+  t.prev_date = ossia::time_value{prev};
+  t.date = ossia::time_value{date};
+  return t;
+}
+
+void connect(
+    ossia::graph_interface& g, const ossia::node_ptr& src, ossia::outlet& outl,
+    const ossia::node_ptr& snk, ossia::inlet& inl)
+{
+  g.connect(
+      g.allocate_edge(ossia::immediate_strict_connection{}, &outl, &inl, src, snk));
+}
+}
+
+TEST_CASE("test_fused_chain", "test_fused_chain")
+{
+  ossia::execution_state st;
+  const ossia::token_request ticks[] = {token(0, 64), token(64, 128), token(128, 192)};
+
+  // Reference: the chain is run by the graph
+  Chain graph_chain;
+  auto g = ossia::make_graph(ossia::graph_setup_options{});
+  g->add_node(graph_chain.source);
+  g->add_node(graph_chain.first);
+  g->add_node(graph_chain.second);
+  connect(
+      *g, graph_chain.source, graph_chain.source->out, graph_chain.first,
+      graph_chain.first->in);
+  connect(
+      *g, graph_chain.first, graph_chain.first->out, graph_chain.second,
+      graph_chain.second->in);
+
+  for(auto& t : ticks)
+  {
+    graph_chain.source->request(t);
+    graph_chain.first->request(t);
+    graph_chain.second->request(t);
+    g->state(st);
+  }
+
+  // The same chain in a single node: each process requests its tokens on it
+  Chain fused_chain;
+  auto fused = std::make_shared<Execution::FusedNode>(
+      std::vector<ossia::node_ptr>{
+          fused_chain.source, fused_chain.first, fused_chain.second},
+      std::vector<Execution::FusedNode::Link>{
+          {&*fused_chain.source->out, &*fused_chain.first->in},
+          {&*fused_chain.first->out, &*fused_chain.second->in}});
+  auto fg = ossia::make_graph(ossia::graph_setup_options{});
+  fg->add_node(fused);
+
+  for(auto& t : ticks)
+  {
+    for(int i = 0; i < 3; i++)
+      fused->request(t);
+    fg->state(st);
+
+    for(ossia::graph_node* m :
+        {(ossia::graph_node*)fused_chain.source.get(), fused_chain.first.get(),
+         fused_chain.second.get()})
+    {
+      REQUIRE(m->executed());
+      REQUIRE(m->requested_tokens.empty());
+    }
+  }
+
+  REQUIRE(!graph_chain.second->received.empty());
+  REQUIRE(fused_chain.first->received == graph_chain.first->received);
+  REQUIRE(fused_chain.second->received == graph_chain.second->received);
+}
+
+TEST_CASE("test_fused_chain_mute", "test_fused_chain_mute")
+{
+  ossia::execution_state st;
+  Chain chain;
+  auto fused = std::make_shared<Execution::FusedNode>(
+      std::vector<ossia::node_ptr>{chain.source, chain.first},
+      std::vector<Execution::FusedNode::Link>{
+          {&*chain.source->out, &*chain.first->in}});
+  auto g = ossia::make_graph(ossia::graph_setup_options{});
+  g->add_node(fused);
+
+  fused->set_mute(true);
+  fused->request(token(0, 64));
+  g->state(st);
+  REQUIRE(chain.source->muted());
+  REQUIRE(chain.first->muted());
+
+  fused->set_mute(false);
+  fused->request(token(64, 128));
+  g->state(st);
+  REQUIRE(!chain.source->muted());
+  REQUIRE(!chain.first->muted());
+}
+#endif
@@ -1,5 +1,6 @@
 #pragma once
 #include <Audio/Settings/Model.hpp>
+#include <Process/Execution/AllocationTrap.hpp>
 
 #include <ossia/dataflow/audio_port.hpp>
 #include <ossia/dataflow/graph_node.hpp>
@@ -8,9 +9,10 @@
 #include <ossia/detail/flat_map.hpp>
 #include <ossia/network/value/value.hpp>
 
-#include <Gist.h>
+#include <Analysis/SpectralCache.hpp>
 
-#include <mutex>
+#include <algorithm>
+#include <memory>
 
 namespace ossia::safe_nodes
 {
@@ -24,20 +26,22 @@ struct GistState
 {
   // For efficiency we take a reference to the vector<value> member
   // of the ossia variant
-  explicit GistState(int bufferSize, int rate)
+  explicit GistState(int bufferSize, int rate, int channels = 2)
       : out_val{std::vector<ossia::value>{}}
       , output{out_val.v.m_impl.m_value8}
       , bufferSize{bufferSize}
       , rate{rate}
   {
-    output.reserve(2);
-    gist.reserve(2);
-    gist.emplace_back(bufferSize, rate);
-    gist.emplace_back(bufferSize, rate);
+    output.reserve(channels);
+    analyzers.reserve(channels);
+    for(int i = 0; i < channels; i++)
+      analyzers.push_back(std::make_unique<SpectralCache::Entry>(bufferSize, rate));
   }
 
   explicit GistState(Audio::Settings::Model& settings)
-      : GistState{settings.getBufferSize(), settings.getRate()}
+      : GistState{
+          settings.getBufferSize(), settings.getRate(),
+          std::max({2, settings.getDefaultIn(), settings.getDefaultOut()})}
   {
   }
 
@@ -46,19 +50,46 @@ struct GistState
   {
   }
 
-  ~GistState() { gist.clear(); }
-
   void preprocess(const ossia::audio_port& audio)
   {
-    const auto N = audio.channels();
-    output.resize(N);
-    if(gist.size() < N)
+    const std::size_t channels = audio.channels();
+    if(channels > analyzers.size())
     {
-      gist.clear();
-      gist.reserve(N);
-      while(gist.size() < N)
-        gist.emplace_back(bufferSize, rate);
+      // Only happens the first time a signal has more channels than the
+      // audio interface: the process then keeps the analyzers.
+      Execution::ScopedAllocationTrap::Allow allow;
+      output.reserve(channels);
+      while(analyzers.size() < channels)
+        analyzers.push_back(std::make_unique<SpectralCache::Entry>(bufferSize, rate));
     }
+    output.resize(channels);
+  }
+
+  // The FFT of a given frame is computed only once per tick across all the
+  // analysis processes which receive the same signal, see SpectralCache.
+  template <auto Func>
+  SpectralCache::Entry* analyze(
+      std::size_t channel, const ossia::audio_channel& samples,
+      const ossia::exec_state_facade& e)
+  {
+    return SpectralCache::instance().analyze<Func>(
+        analyzer(channel), samples.data(), samples.size(), 1.f, 0.f, false,
+        e.currentDate());
+  }
+
+  template <auto Func>
+  SpectralCache::Entry* analyze(
+      std::size_t channel, const ossia::audio_channel& samples, float gain,
+      float gate, const ossia::exec_state_facade& e)
+  {
+    return SpectralCache::instance().analyze<Func>(
+        analyzer(channel), samples.data(), samples.size(), gain, gate, true,
+        e.currentDate());
+  }
+
+  SpectralCache::Entry* analyzer(std::size_t channel) const noexcept
+  {
+    return channel < analyzers.size() ? analyzers[channel].get() : nullptr;
   }
 
   // No gain //
@@ -69,18 +100,8 @@ struct GistState
   {
     float ret = 0.f;
     auto& c0 = audio.get()[0];
-    auto& g0 = gist[0];
-    {
-      const auto samples = std::ssize(c0);
-      if(samples > 0)
-      {
-        if(g0.getAudioFrameSize() != samples)
-          g0.setAudioFrameSize(samples);
-
-        g0.processAudioFrame(c0.data(), samples);
-        ret = (g0.*Func)();
-      }
-    }
+    if(!c0.empty())
+      ret = SpectralCache::feature<Func>(analyze<Func>(0, c0, e));
 
     const auto [tick_start, d] = e.timings(tk);
     out_port.write_value(ret, tick_start);
@@ -93,31 +114,11 @@ struct GistState
   {
     ossia::vec2f ret = {0.f, 0.f};
     auto& c0 = audio.get()[0];
-    auto& g0 = gist[0];
-    {
-      const auto samples = std::ssize(c0);
-      if(samples > 0)
-      {
-        if(g0.getAudioFrameSize() != samples)
-          g0.setAudioFrameSize(samples);
-
-        g0.processAudioFrame(c0.data(), samples);
-        ret[0] = (g0.*Func)();
-      }
-    }
+    if(!c0.empty())
+      ret[0] = SpectralCache::feature<Func>(analyze<Func>(0, c0, e));
     auto& c1 = audio.get()[1];
-    auto& g1 = gist[1];
-    {
-      const auto samples = std::ssize(c1);
-      if(samples > 0)
-      {
-        if(g1.getAudioFrameSize() != samples)
-          g1.setAudioFrameSize(samples);
-
-        g1.processAudioFrame(c0.data(), samples);
-        ret[1] = (g1.*Func)();
-      }
-    }
+    if(!c1.empty())
+      ret[1] = SpectralCache::feature<Func>(analyze<Func>(1, c1, e));
 
     const auto [tick_start, d] = e.timings(tk);
     out_port.write_value(ret, tick_start);
@@ -129,24 +130,19 @@ struct GistState
       const ossia::token_request& tk, const ossia::exec_state_facade& e)
   {
     auto it = output.begin();
-    auto git = gist.begin();
+    std::size_t i = 0;
     for(auto& channel : audio.get())
     {
-      const auto samples = std::ssize(channel);
-      if(samples > 0)
+      if(!channel.empty())
       {
-        if(git->getAudioFrameSize() != samples)
-          git->setAudioFrameSize(samples);
-
-        git->processAudioFrame(channel.data(), samples);
-        *it = float(((*git).*Func)());
+        *it = float(SpectralCache::feature<Func>(analyze<Func>(i, channel, e)));
       }
       else
       {
         *it = 0.f;
       }
       ++it;
-      ++git;
+      ++i;
     }
 
     const auto [tick_start, d] = e.timings(tk);
@@ -162,18 +158,8 @@ struct GistState
   {
     float ret = 0.f;
     auto& c0 = audio.get()[0];
-    auto& g0 = gist[0];
-    {
-      const auto samples = std::ssize(c0);
-      if(samples > 0)
-      {
-        if(g0.getAudioFrameSize() != samples)
-          g0.setAudioFrameSize(samples);
-
-        g0.processAudioFrame(c0.data(), samples, gain, gate);
-        ret = (g0.*Func)();
-      }
-    }
+    if(!c0.empty())
+      ret = SpectralCache::feature<Func>(analyze<Func>(0, c0, gain, gate, e));
 
     const auto [tick_start, d] = e.timings(tk);
     out_port.write_value(ret, tick_start);
@@ -187,31 +173,11 @@ struct GistState
   {
     ossia::vec2f ret = {0.f, 0.f};
     auto& c0 = audio.get()[0];
-    auto& g0 = gist[0];
-    {
-      const auto samples = std::ssize(c0);
-      if(samples > 0)
-      {
-        if(g0.getAudioFrameSize() != samples)
-          g0.setAudioFrameSize(samples);
-
-        g0.processAudioFrame(c0.data(), samples, gain, gate);
-        ret[0] = (g0.*Func)();
-      }
-    }
+    if(!c0.empty())
+      ret[0] = SpectralCache::feature<Func>(analyze<Func>(0, c0, gain, gate, e));
     auto& c1 = audio.get()[1];
-    auto& g1 = gist[1];
-    {
-      const auto samples = std::ssize(c1);
-      if(samples > 0)
-      {
-        if(g1.getAudioFrameSize() != samples)
-          g1.setAudioFrameSize(samples);
-
-        g1.processAudioFrame(c0.data(), samples, gain, gate);
-        ret[1] = (g1.*Func)();
-      }
-    }
+    if(!c1.empty())
+      ret[1] = SpectralCache::feature<Func>(analyze<Func>(1, c1, gain, gate, e));
 
     const auto [tick_start, d] = e.timings(tk);
     out_port.write_value(ret, tick_start);
@@ -224,25 +190,20 @@ struct GistState
       const ossia::exec_state_facade& e)
   {
     auto it = output.begin();
-    auto git = gist.begin();
+    std::size_t i = 0;
     for(auto& channel : audio.get())
     {
-      const auto samples = std::ssize(channel);
-      if(samples > 0)
+      if(!channel.empty())
       {
-        if(git->getAudioFrameSize() != samples)
-          git->setAudioFrameSize(samples);
-
-        git->processAudioFrame(channel.data(), samples, gain, gate);
-        float r{};
-        *it = r = float(((*git).*Func)());
+        auto entry = analyze<Func>(i, channel, gain, gate, e);
+        *it = float(SpectralCache::feature<Func>(entry));
       }
       else
       {
         *it = 0.f;
       }
       ++it;
-      ++git;
+      ++i;
     }
 
     const auto [tick_start, d] = e.timings(tk);
@@ -258,18 +219,8 @@ struct GistState
   {
     float ret = 0.f;
     auto& c0 = audio.get()[0];
-    auto& g0 = gist[0];
-    {
-      const auto samples = std::ssize(c0);
-      if(samples > 0)
-      {
-        if(g0.getAudioFrameSize() != samples)
-          g0.setAudioFrameSize(samples);
-
-        g0.processAudioFrame(c0.data(), samples, gain, gate);
-        ret = (g0.*Func)();
-      }
-    }
+    if(!c0.empty())
+      ret = SpectralCache::feature<Func>(analyze<Func>(0, c0, gain, gate, e));
 
     const auto [tick_start, d] = e.timings(tk);
     out_port.write_value(ret, tick_start);
@@ -286,31 +237,11 @@ struct GistState
   {
     ossia::vec2f ret = {0.f, 0.f};
     auto& c0 = audio.get()[0];
-    auto& g0 = gist[0];
-    {
-      const auto samples = std::ssize(c0);
-      if(samples > 0)
-      {
-        if(g0.getAudioFrameSize() != samples)
-          g0.setAudioFrameSize(samples);
-
-        g0.processAudioFrame(c0.data(), samples, gain, gate);
-        ret[0] = (g0.*Func)();
-      }
-    }
+    if(!c0.empty())
+      ret[0] = SpectralCache::feature<Func>(analyze<Func>(0, c0, gain, gate, e));
     auto& c1 = audio.get()[1];
-    auto& g1 = gist[1];
-    {
-      const auto samples = std::ssize(c1);
-      if(samples > 0)
-      {
-        if(g1.getAudioFrameSize() != samples)
-          g1.setAudioFrameSize(samples);
-
-        g1.processAudioFrame(c0.data(), samples, gain, gate);
-        ret[1] = (g1.*Func)();
-      }
-    }
+    if(!c1.empty())
+      ret[1] = SpectralCache::feature<Func>(analyze<Func>(1, c1, gain, gate, e));
 
     const auto [tick_start, d] = e.timings(tk);
     out_port.write_value(ret, tick_start);
@@ -326,18 +257,14 @@ struct GistState
   {
     bool bang = false;
     auto it = output.begin();
-    auto git = gist.begin();
+    std::size_t i = 0;
     for(auto& channel : audio.get())
     {
-      const auto samples = std::ssize(channel);
-      if(samples > 0)
+      if(!channel.empty())
       {
-        if(git->getAudioFrameSize() != samples)
-          git->setAudioFrameSize(samples);
-
-        git->processAudioFrame(channel.data(), samples, gain, gate);
         float r{};
-        *it = r = float(((*git).*Func)());
+        auto entry = analyze<Func>(i, channel, gain, gate, e);
+        *it = r = float(SpectralCache::feature<Func>(entry));
         bang |= (r >= 1.f);
       }
       else
@@ -345,7 +272,7 @@ struct GistState
         *it = 0.f;
       }
       ++it;
-      ++git;
+      ++i;
     }
 
     const auto [tick_start, d] = e.timings(tk);
@@ -380,23 +307,16 @@ struct GistState
       const ossia::audio_port& audio, ossia::audio_port& mfcc,
       const ossia::token_request& tk, const ossia::exec_state_facade& e)
   {
-    while(gist.size() < audio.channels())
-      gist.emplace_back(bufferSize, rate);
-
+    preprocess(audio);
     mfcc.set_channels(audio.channels());
     auto it = mfcc.get().begin();
-    auto git = gist.begin();
+    std::size_t i = 0;
     for(auto& channel : audio.get())
     {
-      const auto samples = std::ssize(channel);
-      if(samples > 0)
+      auto entry = channel.empty() ? nullptr : analyze<Func>(i, channel, e);
+      if(entry)
       {
-        if(git->getAudioFrameSize() != samples)
-          git->setAudioFrameSize(samples);
-
-        git->processAudioFrame(channel.data(), samples);
-
-        auto& res = ((*git).*Func)();
+        auto& res = (entry->gist.*Func)();
         it->assign(res.begin(), res.end());
       }
       else
@@ -405,7 +325,7 @@ struct GistState
       }
 
       ++it;
-      ++git;
+      ++i;
     }
   }
 
@@ -414,23 +334,16 @@ struct GistState
       const ossia::audio_port& audio, float gain, float gate, ossia::audio_port& mfcc,
       const ossia::token_request& tk, const ossia::exec_state_facade& e)
   {
-    while(gist.size() < audio.channels())
-      gist.emplace_back(bufferSize, rate);
-
+    preprocess(audio);
     mfcc.set_channels(audio.channels());
     auto it = mfcc.get().begin();
-    auto git = gist.begin();
+    std::size_t i = 0;
     for(auto& channel : audio.get())
     {
-      const auto samples = std::ssize(channel);
-      if(samples > 0)
+      auto entry = channel.empty() ? nullptr : analyze<Func>(i, channel, gain, gate, e);
+      if(entry)
       {
-        if(git->getAudioFrameSize() != samples)
-          git->setAudioFrameSize(samples);
-
-        git->processAudioFrame(channel.data(), samples, gain, gate);
-
-        auto& res = ((*git).*Func)();
+        auto& res = (entry->gist.*Func)();
         it->assign(res.begin(), res.end());
       }
       else
@@ -439,13 +352,13 @@ struct GistState
       }
 
       ++it;
-      ++git;
+      ++i;
     }
   }
 
-  ossia::small_vector<Gist<double>, 2> gist;
   ossia::value out_val;
   std::vector<ossia::value>& output;
+  std::vector<std::unique_ptr<SpectralCache::Entry>> analyzers;
   int bufferSize{};
   int rate{};
 };
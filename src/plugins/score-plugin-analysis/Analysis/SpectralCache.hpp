@@ -0,0 +1,179 @@
+#pragma once
+#include <Gist.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace Analysis
+{
+template <auto Func>
+inline constexpr char feature_key{};
+
+//! Features which depend on the previous frames analyzed by their Gist instance
+template <auto Func>
+inline constexpr bool history_feature = false;
+template <>
+inline constexpr bool history_feature<&Gist<double>::energyDifference> = true;
+template <>
+inline constexpr bool history_feature<&Gist<double>::spectralDifference> = true;
+template <>
+inline constexpr bool history_feature<&Gist<double>::spectralDifferenceHWR> = true;
+template <>
+inline constexpr bool history_feature<&Gist<double>::complexSpectralDifference> = true;
+template <>
+inline constexpr bool history_feature<&Gist<double>::pitch> = true;
+
+/**
+ * @brief Analysis shared across the analysis processes running on a thread.
+ *
+ * When several descriptors are applied to the same signal (e.g. centroid,
+ * flatness and rolloff of the same input), the first one to run during a tick
+ * performs the windowing and the FFT ; the following ones find the entry by
+ * comparing their input frame with the analyzed one and reuse its magnitude
+ * spectrum instead of computing it again.
+ *
+ * Features which depend on the previous frames (onset detection, pitch) are
+ * never taken from the entry of another process: it may not have analyzed the
+ * same frames before, e.g. when both inputs were silent until now. The
+ * processes computing them always analyze their own entry, which keeps its
+ * history in step with their input.
+ *
+ * The entries are owned by the processes, which allocate one per channel when
+ * they are created, with the buffer size of the engine. A frame of another
+ * size, e.g. the end of a token, is zero-padded or truncated to the last
+ * samples: the size of the analysis window does not change and nothing gets
+ * allocated on the audio thread.
+ * It is thread_local : nodes executing in parallel never share an entry and no
+ * locking is needed on the audio thread.
+ */
+class SpectralCache
+{
+public:
+  struct Entry
+  {
+    Entry(int frameSize, int rate)
+        : gist{frameSize, rate}
+        , frame(frameSize)
+    {
+    }
+
+    Gist<double> gist;
+    std::vector<double> frame;
+
+    // Features past the capacity are just not memoized
+    std::array<std::pair<const void*, double>, 16> features;
+    std::size_t featureCount{};
+
+    int64_t date{-1};
+    float gain{};
+    float gate{};
+    bool scaled{};
+
+    bool matches(
+        const double* data, std::size_t samples, float gain, float gate,
+        bool scaled) const noexcept
+    {
+      return this->scaled == scaled && this->gain == gain && this->gate == gate
+             && frame.size() == samples
+             && std::memcmp(frame.data(), data, samples * sizeof(double)) == 0;
+    }
+
+    void analyze(
+        const double* data, std::size_t samples, float gain, float gate, bool scaled,
+        int64_t date) noexcept
+    {
+      const std::size_t n = frame.size();
+      if(samples >= n)
+      {
+        std::copy_n(data + samples - n, n, frame.data());
+      }
+      else
+      {
+        std::copy_n(data, samples, frame.data());
+        std::fill(frame.begin() + samples, frame.end(), 0.);
+      }
+
+      if(scaled)
+        gist.processAudioFrame(frame.data(), n, gain, gate);
+      else
+        gist.processAudioFrame(frame.data(), n);
+
+      featureCount = 0;
+      this->date = date;
+      this->gain = gain;
+      this->gate = gate;
+      this->scaled = scaled;
+    }
+  };
+
+  static SpectralCache& instance() noexcept
+  {
+    static thread_local SpectralCache cache;
+    return cache;
+  }
+
+  /**
+   * @brief Returns an entry holding the analysis of the given frame.
+   *
+   * The entry of the caller is only analyzed when no other process did it
+   * during this tick, unless Func depends on the previous frames.
+   *
+   * @param date Identifies the current tick.
+   */
+  template <auto Func>
+  Entry* analyze(
+      Entry* own, const double* data, std::size_t samples, float gain, float gate,
+      bool scaled, int64_t date) noexcept
+  {
+    if(date != m_date)
+    {
+      // The entries of the previous tick must not be accessed anymore:
+      // their process may have been removed since.
+      m_count = 0;
+      m_date = date;
+    }
+
+    if constexpr(!history_feature<Func>)
+    {
+      for(std::size_t i = 0; i < m_count; i++)
+        if(m_entries[i]->matches(data, samples, gain, gate, scaled))
+          return m_entries[i];
+    }
+
+    if(!own)
+      return nullptr;
+
+    const bool registered = own->date == date;
+    own->analyze(data, samples, gain, gate, scaled, date);
+    if(!registered && m_count < m_entries.size())
+      m_entries[m_count++] = own;
+    return own;
+  }
+
+  template <auto Func>
+  static double feature(Entry* e) noexcept
+  {
+    if(!e)
+      return 0.;
+
+    const void* key = &feature_key<Func>;
+    for(std::size_t i = 0; i < e->featureCount; i++)
+      if(e->features[i].first == key)
+        return e->features[i].second;
+
+    const double res = (e->gist.*Func)();
+    if(e->featureCount < e->features.size())
+      e->features[e->featureCount++] = {key, res};
+    return res;
+  }
+
+private:
+  std::array<Entry*, 64> m_entries{};
+  std::size_t m_count{};
+  int64_t m_date{-1};
+};
+}
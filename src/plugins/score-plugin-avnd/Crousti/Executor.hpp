@@ -705,42 +705,65 @@ public:
       ProcessModel<Node>& element, const ::Execution::Context& ctx,
       std::shared_ptr<safe_node<Node>>& ptr)
   {
-    // Custom UI messages to engine
+    // Messages go through preallocated typed channels: nothing gets allocated
+    // or freed on the execution thread when they are exchanged.
     avnd::effect_container<Node>& eff = ptr->impl;
+
+    // Custom UI messages to engine
     if constexpr(avnd::has_gui_to_processor_bus<Node>)
     {
-      element.from_ui = [p = QPointer{this}, &eff](QByteArray b) {
+      using message_type = gui_to_processor_message_t<Node>;
+      auto channel = std::make_shared<MessageChannel<message_type>>();
+      element.from_ui
+          = [p = QPointer{this}, channel, &eff](const message_type& msg) {
         if(!p)
           return;
 
-        p->in_exec([mess = std::move(b), &eff] {
-          using refl = avnd::function_reflection<&Node::process_message>;
-          static_assert(refl::count <= 1);
+        if(!channel->write([&](message_type& slot) { slot = msg; }))
+          return;
 
-          if constexpr(refl::count == 0)
-          {
-            // no arguments, just call it
-            eff.effect.process_message();
-          }
-          else if constexpr(refl::count == 1)
-          {
-            using arg_type = avnd::first_argument<&Node::process_message>;
-            std::decay_t<arg_type> arg;
-            MessageBusReader b{mess};
-            b(arg);
-            eff.effect.process_message(std::move(arg));
-          }
+        p->in_exec([channel, &eff] {
+          channel->consume([&](message_type& msg) {
+            using refl = avnd::function_reflection<&Node::process_message>;
+            static_assert(refl::count <= 1);
+
+            if constexpr(refl::count == 0)
+            {
+              // no arguments, just call it
+              eff.effect.process_message();
+            }
+            else if constexpr(std::is_reference_v<
+                                  avnd::first_argument<&Node::process_message>>)
+            {
+              eff.effect.process_message(msg);
+            }
+            else
+            {
+              eff.effect.process_message(std::move(msg));
+            }
+          });
         });
       };
     }
 
+    // Engine messages to custom UI, forwarded at the GUI refresh rate
     if constexpr(avnd::has_processor_to_gui_bus<Node>)
     {
-      eff.effect.send_message = [this](auto b) mutable {
-        this->in_edit([this, bb = std::move(b)]() mutable {
-          MessageBusSender{this->process().to_ui}(std::move(bb));
-        });
+      using message_type = processor_to_gui_message_t<Node>;
+      auto channel = std::make_shared<MessageChannel<message_type>>();
+      eff.effect.send_message = [channel]<typename T>(T&& msg) {
+        channel->write(
+            [&](message_type& slot) { convert_message(std::forward<T>(msg), slot); });
       };
+
+      con(
+          ctx.doc.coarseUpdateTimer, &QTimer::timeout, this,
+          [this, channel] {
+        channel->consume([this](const message_type& msg) {
+          this->process().to_ui(msg);
+        });
+          },
+          Qt::QueuedConnection);
     }
   }
 
@@ -820,7 +843,7 @@ public:
   {
     if constexpr(requires { this->process().from_ui; })
     {
-      this->process().from_ui = [](QByteArray arr) {};
+      this->process().from_ui = [](const auto&) {};
     }
     // FIXME cleanup eff.effect.send_message too ?
 
@@ -252,13 +252,25 @@ private:
       if constexpr(avnd::has_gui_to_processor_bus<Info>)
       {
         // ui -> engine
-        ptr->bus.send_message = MessageBusSender{proc.from_ui};
+        ptr->bus.send_message = [&proc]<typename T>(T&& msg) {
+          using message_type = gui_to_processor_message_t<Info>;
+          if constexpr(std::is_same_v<std::remove_cvref_t<T>, message_type>)
+          {
+            proc.from_ui(msg);
+          }
+          else
+          {
+            message_type m;
+            convert_message(std::forward<T>(msg), m);
+            proc.from_ui(m);
+          }
+        };
       }
 
       if constexpr(avnd::has_processor_to_gui_bus<Info>)
       {
         // engine -> ui
-        proc.to_ui = [ptr](QByteArray mess) {
+        proc.to_ui = [ptr](const processor_to_gui_message_t<Info>& mess) {
           if constexpr(requires { ptr->bus.process_message(); })
           {
             ptr->bus.process_message();
@@ -267,11 +279,14 @@ private:
           {
             ptr->bus.process_message(ptr->ui);
           }
+          else if constexpr(requires { ptr->bus.process_message(ptr->ui, mess); })
+          {
+            ptr->bus.process_message(ptr->ui, mess);
+          }
           else if constexpr(requires { ptr->bus.process_message(ptr->ui, {}); })
           {
-            avnd::second_argument<&Info::ui::bus::process_message> arg;
-            MessageBusReader b{mess};
-            b(arg);
+            std::decay_t<avnd::second_argument<&Info::ui::bus::process_message>> arg;
+            convert_message(mess, arg);
             ptr->bus.process_message(ptr->ui, std::move(arg));
           }
           else
@@ -3,6 +3,12 @@
 
 #include <boost/pfr.hpp>
 
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
 namespace oscr
 {
 
@@ -112,4 +118,128 @@ struct MessageBusReader
   }
 };
 
+
+//! Converts a message to the type expected on the other side of the bus.
+template <typename To, typename From>
+void convert_message(From&& from, To& to)
+{
+  if constexpr(std::is_assignable_v<To&, From&&>)
+  {
+    to = std::forward<From>(from);
+  }
+  else
+  {
+    // Different types with the same layout: go through the serialized form
+    std::function<void(QByteArray)> read
+        = [&to](QByteArray mess) { MessageBusReader{mess}(to); };
+    MessageBusSender{read}(from);
+  }
+}
+
+/**
+ * @brief Single-producer, single-consumer queue of messages.
+ *
+ * All the slots are constructed upfront and reused: writing a message assigns
+ * it in place, so that buffers kept by the message (e.g. a std::vector of
+ * spectrum bins) are recycled once they have reached their size.
+ * Messages are dropped when the consumer does not keep up.
+ */
+template <typename T, std::size_t Capacity = 64>
+class MessageQueue
+{
+  static_assert((Capacity & (Capacity - 1)) == 0);
+
+public:
+  template <typename F>
+  bool write(F&& f) noexcept(noexcept(f(std::declval<T&>())))
+  {
+    const auto w = m_write.load(std::memory_order_relaxed);
+    if(w - m_read.load(std::memory_order_acquire) == Capacity)
+      return false;
+
+    f(m_slots[w % Capacity]);
+    m_write.store(w + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename F>
+  void consume(F&& f)
+  {
+    auto r = m_read.load(std::memory_order_relaxed);
+    const auto w = m_write.load(std::memory_order_acquire);
+    for(; r != w; ++r)
+    {
+      f(m_slots[r % Capacity]);
+      m_read.store(r + 1, std::memory_order_release);
+    }
+  }
+
+private:
+  std::unique_ptr<T[]> m_slots{new T[Capacity]};
+  alignas(64) std::atomic<std::size_t> m_write{};
+  alignas(64) std::atomic<std::size_t> m_read{};
+};
+
+/**
+ * @brief Keeps only the last message written, for "latest value" messages.
+ *
+ * Triple buffer: the producer never waits and never drops the newest message,
+ * the consumer only sees the last one written since it last looked.
+ */
+template <typename T>
+class LatestMessage
+{
+public:
+  template <typename F>
+  bool write(F&& f) noexcept(noexcept(f(std::declval<T&>())))
+  {
+    f(m_slots[m_back]);
+    m_back = m_middle.exchange(m_back | dirty, std::memory_order_acq_rel) & ~dirty;
+    return true;
+  }
+
+  template <typename F>
+  void consume(F&& f)
+  {
+    if(!(m_middle.load(std::memory_order_relaxed) & dirty))
+      return;
+
+    m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & ~dirty;
+    f(m_slots[m_front]);
+  }
+
+private:
+  static constexpr int dirty = 4;
+
+  T m_slots[3]{};
+  int m_back{0};
+  alignas(64) std::atomic<int> m_middle{1};
+  alignas(64) int m_front{2};
+};
+
+/**
+ * Message structs can opt into coalescing by declaring a latest_value flag,
+ * e.g. with halp_flag(latest_value): meters, scopes, spectra...
+ */
+template <typename T>
+concept latest_value_message = requires { T::latest_value; };
+
+template <typename T>
+using MessageChannel = std::conditional_t<
+    latest_value_message<T>, LatestMessage<T>, MessageQueue<T>>;
+
+//! Type of the message carried by a std::function-like send_message.
+template <typename F>
+struct bus_function_argument;
+
+template <typename R, typename Arg>
+struct bus_function_argument<std::function<R(Arg)>>
+{
+  using type = std::remove_cvref_t<Arg>;
+};
+
+//! Used when process_message takes no argument.
+struct EmptyMessage
+{
+};
 }
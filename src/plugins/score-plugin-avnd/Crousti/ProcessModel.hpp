@@ -8,6 +8,7 @@
 
 #include <Crousti/Attributes.hpp>
 #include <Crousti/Concepts.hpp>
+#include <Crousti/MessageBus.hpp>
 #include <Crousti/Metadatas.hpp>
 #include <Media/Sound/Drop/SoundDrop.hpp>
 
@@ -16,6 +17,7 @@
 #include <boost/pfr.hpp>
 
 #include <avnd/common/for_nth.hpp>
+#include <avnd/common/function_reflection.hpp>
 #include <avnd/concepts/gfx.hpp>
 #include <avnd/concepts/ui.hpp>
 #include <avnd/introspection/messages.hpp>
@@ -413,6 +415,28 @@ struct OutletInitFunc
   }
 };
 
+//! Type of the messages sent by the processor to its UI.
+template <typename Info>
+using processor_to_gui_message_t = typename bus_function_argument<
+    std::remove_cvref_t<decltype(std::declval<Info&>().send_message)>>::type;
+
+//! Type of the messages received by the processor from its UI.
+template <typename Info>
+struct gui_to_processor_message
+{
+  using type = EmptyMessage;
+};
+
+template <typename Info>
+  requires(avnd::function_reflection<&Info::process_message>::count == 1)
+struct gui_to_processor_message<Info>
+{
+  using type = std::decay_t<avnd::first_argument<&Info::process_message>>;
+};
+
+template <typename Info>
+using gui_to_processor_message_t = typename gui_to_processor_message<Info>::type;
+
 template <typename Info>
 struct MessageBusWrapperToUi
 {
@@ -425,13 +449,13 @@ struct MessageBusWrapperFromUi
 template <avnd::has_processor_to_gui_bus Info>
 struct MessageBusWrapperToUi<Info>
 {
-  std::function<void(QByteArray)> to_ui;
+  std::function<void(const processor_to_gui_message_t<Info>&)> to_ui;
 };
 
 template <avnd::has_gui_to_processor_bus Info>
 struct MessageBusWrapperFromUi<Info>
 {
-  std::function<void(QByteArray)> from_ui;
+  std::function<void(const gui_to_processor_message_t<Info>&)> from_ui;
 };
 
 template <typename Info>
@@ -458,11 +482,11 @@ public:
 
     if constexpr(requires { this->from_ui; })
     {
-      this->from_ui = [](QByteArray arr) {};
+      this->from_ui = [](const auto&) {};
     }
     if constexpr(requires { this->to_ui; })
     {
-      this->to_ui = [](QByteArray arr) {};
+      this->to_ui = [](const auto&) {};
     }
   }
   ProcessModel(
@@ -478,11 +502,11 @@ public:
 
     if constexpr(requires { this->from_ui; })
     {
-      this->from_ui = [](QByteArray arr) {};
+      this->from_ui = [](const auto&) {};
     }
     if constexpr(requires { this->to_ui; })
     {
-      this->to_ui = [](QByteArray arr) {};
+      this->to_ui = [](const auto&) {};
     }
 
     if constexpr(avnd::file_input_introspection<Info>::size > 0)
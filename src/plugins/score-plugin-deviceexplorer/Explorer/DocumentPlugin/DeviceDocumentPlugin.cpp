@@ -15,6 +15,7 @@
 #include <Explorer/DocumentPlugin/DeviceDocumentPluginFactory.hpp>
 #include <Explorer/DocumentPlugin/NodeUpdateProxy.hpp>
 #include <Explorer/Listening/ListeningHandlerFactoryList.hpp>
+#include <Explorer/Settings/ExplorerModel.hpp>
 
 #include <score/application/ApplicationContext.hpp>
 #include <score/application/GUIApplicationContext.hpp>
@@ -44,8 +45,13 @@
 
 #include <wobjectimpl.h>
 
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
 W_OBJECT_IMPL(Explorer::DeviceDocumentPlugin)
 namespace Explorer
 {
@@ -62,9 +68,27 @@ DeviceDocumentPlugin::~DeviceDocumentPlugin()
 {
   m_processMessages = false;
   m_asioContext->context.stop();
+  for(auto& t : m_networkThreads)
+    t.context->context.stop();
 
 #if !defined(__EMSCRIPTEN__)
   m_asioThread.join();
+  for(auto& t : m_networkThreads)
+    t.thread.join();
+#endif
+}
+
+static void setThreadAffinity(std::thread& t, int core)
+{
+#if defined(__linux__)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(core, &cpus);
+  pthread_setaffinity_np(t.native_handle(), sizeof(cpu_set_t), &cpus);
+#else
+  // Not supported
+  (void)t;
+  (void)core;
 #endif
 }
 
@@ -95,9 +119,46 @@ void DeviceDocumentPlugin::init()
       m_asioContext->run();
     }
   }};
+
+  auto& set = m_context.app.settings<Explorer::Settings::Model>();
+  const int threads = set.getNetworkThreads();
+  const bool pin = set.getPinNetworkThreads();
+  const int cores = std::max(1, (int)std::thread::hardware_concurrency());
+
+  m_networkThreads.resize(std::max(0, threads));
+  for(std::size_t i = 0; i < m_networkThreads.size(); i++)
+  {
+    auto& t = m_networkThreads[i];
+    t.context = std::make_shared<ossia::net::network_context>();
+    t.thread = std::thread{[this, ctx = t.context] {
+      while(m_processMessages)
+      {
+        ctx->run();
+      }
+    }};
+
+    // Keep core 0 for the GUI and the system
+    if(pin)
+      setThreadAffinity(t.thread, 1 + i % std::max(1, cores - 1));
+  }
 #endif
 }
 
+const ossia::net::network_context_ptr& DeviceDocumentPlugin::newDeviceContext() const
+{
+  if(m_networkThreads.empty())
+    return m_asioContext;
+
+  // The protocols running on a thread keep a reference to its context: this
+  // counts the devices actually using it, until they are disconnected.
+  const auto least = std::min_element(
+      m_networkThreads.begin(), m_networkThreads.end(),
+      [](const NetworkThread& lhs, const NetworkThread& rhs) {
+    return lhs.context.use_count() < rhs.context.use_count();
+  });
+  return least->context;
+}
+
 void DeviceDocumentPlugin::asyncConnect(Device::DeviceInterface& newdev)
 {
   const auto w = score::GUIAppContext().mainWindow;
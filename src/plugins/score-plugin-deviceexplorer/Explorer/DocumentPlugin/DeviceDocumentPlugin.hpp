@@ -81,6 +81,16 @@ public:
     return m_asioContext;
   }
 
+  /**
+   * @brief Context on which the network device being created should run.
+   *
+   * When network threads are enabled in the settings, devices are spread across
+   * them: this is the context of the thread used by the fewest protocols, as
+   * counted by the owners of its context. Otherwise this is the shared
+   * networkContext().
+   */
+  const ossia::net::network_context_ptr& newDeviceContext() const;
+
 private:
   void initDevice(Device::DeviceInterface&);
   void on_valueUpdated(const State::Address& addr, const ossia::value& v);
@@ -91,6 +101,14 @@ private:
   std::thread m_asioThread;
   ossia::net::network_context_ptr m_asioContext;
 
+  struct NetworkThread
+  {
+    ossia::net::network_context_ptr context;
+    std::thread thread;
+  };
+  // Allocated once in init() so that references to the contexts stay valid
+  std::vector<NetworkThread> m_networkThreads;
+
   mutable std::unique_ptr<Explorer::ListeningHandler> m_listening;
   DeviceExplorerModel* m_explorer{};
   ossia::fast_hash_map<Device::DeviceInterface*, std::vector<QMetaObject::Connection>>
@@ -13,10 +13,14 @@ namespace Parameters
 SETTINGS_PARAMETER_IMPL(LocalTree){QStringLiteral("score_plugin_LocalTree"), true};
 SETTINGS_PARAMETER_IMPL(LogLevel){
     QStringLiteral("score_plugin_engine/LogLevel"), DeviceLogLevel{}.logEverything};
+SETTINGS_PARAMETER_IMPL(NetworkThreads){
+    QStringLiteral("score_plugin_deviceexplorer/NetworkThreads"), 0};
+SETTINGS_PARAMETER_IMPL(PinNetworkThreads){
+    QStringLiteral("score_plugin_deviceexplorer/PinNetworkThreads"), false};
 
 static auto list()
 {
-  return std::tie(LocalTree, LogLevel);
+  return std::tie(LocalTree, LogLevel, NetworkThreads, PinNetworkThreads);
 }
 }
 
@@ -27,6 +31,8 @@ Model::Model(QSettings& set, const score::ApplicationContext& ctx)
 
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, LocalTree)
 SCORE_SETTINGS_PARAMETER_CPP(QString, Model, LogLevel)
+SCORE_SETTINGS_PARAMETER_CPP(int, Model, NetworkThreads)
+SCORE_SETTINGS_PARAMETER_CPP(bool, Model, PinNetworkThreads)
 }
 
 namespace Explorer::ProjectSettings
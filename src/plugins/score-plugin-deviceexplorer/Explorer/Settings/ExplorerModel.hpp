@@ -21,15 +21,22 @@ class SCORE_PLUGIN_DEVICEEXPLORER_EXPORT Model : public score::SettingsDelegateM
 
   bool m_LocalTree = false;
   QString m_LogLevel;
+  int m_NetworkThreads{};
+  bool m_PinNetworkThreads{};
 
 public:
   Model(QSettings& set, const score::ApplicationContext& ctx);
 
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_DEVICEEXPLORER_EXPORT, bool, LocalTree)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_DEVICEEXPLORER_EXPORT, QString, LogLevel)
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_DEVICEEXPLORER_EXPORT, int, NetworkThreads)
+  SCORE_SETTINGS_PARAMETER_HPP(
+      SCORE_PLUGIN_DEVICEEXPLORER_EXPORT, bool, PinNetworkThreads)
 };
 
 SCORE_SETTINGS_PARAMETER(Model, LogLevel)
+SCORE_SETTINGS_PARAMETER(Model, NetworkThreads)
+SCORE_SETTINGS_PARAMETER(Model, PinNetworkThreads)
 SCORE_SETTINGS_DEFERRED_PARAMETER(Model, LocalTree)
 }
 
@@ -9,6 +9,7 @@
 
 #include <QCheckBox>
 #include <QFormLayout>
+#include <QSpinBox>
 namespace Explorer::Settings
 {
 View::View()
@@ -22,6 +23,14 @@ View::View()
   lay->addRow(m_cb);
 
   connect(m_cb, &QCheckBox::stateChanged, this, [this](int b) { localTreeChanged(b); });
+
+  SETTINGS_UI_SPINBOX_SETUP("Network threads", NetworkThreads);
+  m_NetworkThreads->setRange(0, 64);
+  m_NetworkThreads->setToolTip(
+      tr("Number of threads dedicated to the network devices (OSC, OSCQuery, "
+         "Art-Net, serial...), which get spread across them. With 0, all the devices "
+         "share a single thread. Applies to documents opened afterwards."));
+  SETTINGS_UI_TOGGLE_SETUP("Pin network threads to CPU cores", PinNetworkThreads);
 }
 
 void View::setLocalTree(bool val)
@@ -36,6 +45,8 @@ QWidget* View::getWidget()
 }
 
 SETTINGS_UI_COMBOBOX_IMPL(LogLevel)
+SETTINGS_UI_SPINBOX_IMPL(NetworkThreads)
+SETTINGS_UI_TOGGLE_IMPL(PinNetworkThreads)
 }
 
 namespace Explorer::ProjectSettings
@@ -4,6 +4,7 @@
 
 #include <verdigris>
 class QCheckBox;
+class QSpinBox;
 namespace score
 {
 class FormWidget;
@@ -22,6 +23,8 @@ public:
   void localTreeChanged(bool arg_1) W_SIGNAL(localTreeChanged, arg_1);
 
   SETTINGS_UI_COMBOBOX_HPP(LogLevel)
+  SETTINGS_UI_SPINBOX_HPP(NetworkThreads)
+  SETTINGS_UI_TOGGLE_HPP(PinNetworkThreads)
 
 private:
   QWidget* getWidget() override;
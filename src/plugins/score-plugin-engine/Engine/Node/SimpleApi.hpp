@@ -44,6 +44,15 @@ struct Meta_base : public ossia::safe_nodes::base_metadata
       Process::ProcessFlags::SupportsLasting | Process::ProcessFlags::ControlSurface);
 };
 
+//! For the nodes which only read and write messages, and whose state only
+//! depends on the messages they received: they can be run in the same graph
+//! node as the ones they are chained with.
+struct Meta_fusable : Meta_base
+{
+  static const constexpr Process::ProcessFlags flags
+      = Process::ProcessFlags(Meta_base::flags | Process::ProcessFlags::Fusable);
+};
+
 template <typename Node>
 using ProcessFactory = Process::ProcessFactory_T<ControlProcess<Node>>;
 
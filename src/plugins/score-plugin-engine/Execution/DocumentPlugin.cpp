@@ -38,7 +38,9 @@
 #include <ossia/editor/scenario/time_interval.hpp>
 #include <ossia/network/common/path.hpp>
 
-#include <QCoreApplication>
+#include <QDebug>
+#include <QGuiApplication>
+#include <QScreen>
 
 #include <wobjectimpl.h>
 W_REGISTER_ARGTYPE(ossia::bench_map)
@@ -49,8 +51,8 @@ DocumentPlugin::ContextData::ContextData(const score::DocumentContext& ctx)
     : setupContext{context}
     , context
 {
-  {}, ctx, m_created, {}, {}, m_execQueue, m_editionQueue, m_gcQueue, setupContext,
-      execGraph, execState
+  {}, ctx, m_created, {}, {}, m_execQueue, m_editionQueue, m_gcQueue, m_feedbackQueue,
+      setupContext, execGraph, execState
 #if(__cplusplus > 201703L) && !defined(_MSC_VER)
       ,
   {
@@ -143,9 +145,23 @@ void DocumentPlugin::on_finished()
       ExecutionCommand cmd;
       while(m_ctxData->m_editionQueue.try_dequeue(cmd))
         cmd();
-      GCCommand gc;
-      while(m_ctxData->m_gcQueue.try_dequeue(gc))
-        ;
+      m_ctxData->m_feedbackQueue.applyAll();
+    }
+
+    // The execution thread is not ticking anymore
+    m_ctxData->reclaimer.setRunning(false);
+
+    if(settings.getBench())
+    {
+      const auto gc = m_ctxData->reclaimer.metrics();
+      qDebug() << "Execution GC:" << gc.reclaimed << "objects freed in"
+               << gc.busyTime / 1e6 << "ms, longest batch:" << gc.longestBatch / 1e6
+               << "ms," << gc.pending << "pending";
+
+      const auto& arena = m_ctxData->tickArena;
+      qDebug() << "Tick arena:" << arena.peak() << "bytes used at most out of"
+               << arena.capacity() << "bytes," << arena.overflows()
+               << "allocations did not fit";
     }
   }
 
@@ -180,12 +196,15 @@ void DocumentPlugin::initExecState()
 
 void DocumentPlugin::timerEvent(QTimerEvent* event)
 {
+  const auto start = std::chrono::steady_clock::now();
+
   ExecutionCommand cmd;
   while(m_ctxData->m_editionQueue.try_dequeue(cmd))
     cmd();
-  GCCommand gc;
-  while(m_ctxData->m_gcQueue.try_dequeue(gc))
-    ;
+
+  // The updates which did not fit in the budget are applied on the next frames
+  const auto budget = m_frameDuration * settings.getGuiUpdateBudget() / 100;
+  m_ctxData->m_feedbackQueue.apply(start + budget);
 }
 
 void DocumentPlugin::registerDevice(ossia::net::device_base* d)
@@ -304,6 +323,9 @@ void DocumentPlugin::reload(Scenario::IntervalModel& cst)
   m_ctxData->m_created = true;
 
   auto& model = context().doc.model<Scenario::ScenarioDocumentModel>();
+  if(settings.getControlFusion())
+    m_ctxData->setupContext.fuseControlChains(model.cables);
+
   for(auto& cable : model.cables)
   {
     m_ctxData->setupContext.connectCable(cable);
@@ -319,7 +341,17 @@ void DocumentPlugin::reload(Scenario::IntervalModel& cst)
     }
   }
 
-  m_tid = startTimer(32);
+  m_ctxData->reclaimer.setRunning(true);
+
+  // Feedback from the execution is applied once per displayed frame
+  double refreshRate = 60.;
+  if(qobject_cast<QGuiApplication*>(qApp))
+    if(auto screen = QGuiApplication::primaryScreen())
+      refreshRate = std::clamp(screen->refreshRate(), 1., 1000.);
+  m_frameDuration = std::chrono::microseconds(int64_t(1e6 / refreshRate));
+  m_tid = startTimer(
+      std::chrono::duration_cast<std::chrono::milliseconds>(m_frameDuration),
+      Qt::PreciseTimer);
   // runAllCommands();
 }
 
@@ -1,7 +1,10 @@
 #pragma once
 #include "BaseScenarioComponent.hpp"
+#include "Reclaimer.hpp"
 
 #include <Process/Dataflow/Port.hpp>
+#include <Process/Execution/FeedbackQueue.hpp>
+#include <Process/Execution/TickArena.hpp>
 #include <Process/ExecutionAction.hpp>
 #include <Process/ExecutionContext.hpp>
 #include <Process/ExecutionSetup.hpp>
@@ -14,6 +17,7 @@
 #include <ossia/network/generic/generic_device.hpp>
 #include <ossia/network/local/local.hpp>
 
+#include <chrono>
 #include <memory>
 #include <verdigris>
 
@@ -67,6 +71,9 @@ public:
     ExecutionCommandQueue m_execQueue{1024};
     EditionCommandQueue m_editionQueue{1024};
     GCCommandQueue m_gcQueue{1024};
+    Reclaimer reclaimer{m_gcQueue};
+    TickArena tickArena;
+    FeedbackQueue m_feedbackQueue;
     std::atomic_bool m_created{};
 
     std::shared_ptr<ossia::graph_interface> execGraph;
@@ -130,5 +137,6 @@ private:
   std::vector<ExecutionAction*> m_actions;
 
   int m_tid{};
+  std::chrono::microseconds m_frameDuration{};
 };
 }
@@ -1,3 +1,6 @@
+#include <Process/Execution/AllocationTrap.hpp>
+#include <Process/Execution/TickArena.hpp>
+
 #include <Scenario/Document/Interval/IntervalExecution.hpp>
 
 #include <Audio/AudioTick.hpp>
@@ -80,6 +83,8 @@ struct AudioTickHelper
 
   void dequeueCommands() const
   {
+    m_context->reclaimer.nextEpoch();
+
     // Run some commands if they have been submitted.
     Execution::ExecutionCommand c;
     while(m_context->m_execQueue.try_dequeue(c))
@@ -153,9 +158,15 @@ struct AudioTickHelper
   void main(const ossia::audio_tick_state& t) const
   try
   {
+    // Per-tick payloads are released at the end of the tick
+    TickArena::Scope arena{m_context->tickArena};
+
     // Match the audio_protocol with the actual I/O
     m_proto->setup_buffers(t);
 
+    // From here on nothing should hit the heap
+    ScopedAllocationTrap trap;
+
     // The actual tick
     for(auto act : m_actions)
       act->startTick(t);
@@ -0,0 +1,95 @@
+#include "Reclaimer.hpp"
+
+#include <QThread>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace Execution
+{
+static constexpr std::size_t batchSize = 256;
+
+Reclaimer::Reclaimer(GCCommandQueue& queue)
+    : m_queue{queue}
+{
+  m_thread.reset(QThread::create([this] { run(); }));
+  m_thread->setObjectName("Execution GC");
+  m_thread->start(QThread::LowestPriority);
+}
+
+Reclaimer::~Reclaimer()
+{
+  m_stop = true;
+  m_running = false;
+  m_thread->wait();
+
+  // The execution thread is gone by now
+  std::vector<GCCommand> batch(batchSize);
+  while(auto n = m_queue.try_dequeue_bulk(batch.begin(), batch.size()))
+    reclaim(batch, n);
+}
+
+void Reclaimer::setRunning(bool running) noexcept
+{
+  // When stopped, everything retired until now can be freed right away
+  m_running.store(running, std::memory_order_release);
+}
+
+Reclaimer::Metrics Reclaimer::metrics() const noexcept
+{
+  Metrics m;
+  m.pending = m_queue.size_approx() + m_inFlight.load(std::memory_order_relaxed);
+  m.reclaimed = m_reclaimed.load(std::memory_order_relaxed);
+  m.busyTime = m_busyTime.load(std::memory_order_relaxed);
+  m.longestBatch = m_longestBatch.load(std::memory_order_relaxed);
+  return m;
+}
+
+void Reclaimer::run()
+{
+  std::vector<GCCommand> batch(batchSize);
+  std::chrono::milliseconds idle{1};
+  while(!m_stop)
+  {
+    const auto n = m_queue.try_dequeue_bulk(batch.begin(), batch.size());
+    if(n == 0)
+    {
+      std::this_thread::sleep_for(idle);
+      idle = std::min(idle * 2, std::chrono::milliseconds{32});
+      continue;
+    }
+    idle = std::chrono::milliseconds{1};
+    m_inFlight.store(n, std::memory_order_relaxed);
+
+    // Everything taken from the queue was retired during the current epoch
+    // at the latest
+    waitEpoch(m_epoch.load(std::memory_order_acquire));
+    reclaim(batch, n);
+  }
+}
+
+void Reclaimer::waitEpoch(uint64_t epoch)
+{
+  using namespace std::chrono_literals;
+  while(!m_stop && m_running.load(std::memory_order_acquire)
+        && m_epoch.load(std::memory_order_acquire) == epoch)
+    std::this_thread::sleep_for(1ms);
+}
+
+void Reclaimer::reclaim(std::vector<GCCommand>& batch, std::size_t count)
+{
+  const auto t0 = std::chrono::steady_clock::now();
+  batch.clear();
+  const auto t1 = std::chrono::steady_clock::now();
+  batch.resize(batchSize);
+
+  const int64_t ns
+      = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+  m_inFlight.store(0, std::memory_order_relaxed);
+  m_reclaimed.fetch_add(count, std::memory_order_relaxed);
+  m_busyTime.fetch_add(ns, std::memory_order_relaxed);
+  if(ns > m_longestBatch.load(std::memory_order_relaxed))
+    m_longestBatch.store(ns, std::memory_order_relaxed);
+}
+}
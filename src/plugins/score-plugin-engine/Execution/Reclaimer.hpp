@@ -0,0 +1,71 @@
+#pragma once
+#include <Process/ExecutionContext.hpp>
+
+#include <score_plugin_engine_export.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class QThread;
+namespace Execution
+{
+/**
+ * @brief Frees the objects retired by the execution thread.
+ *
+ * The commands run by the execution thread are moved to the GC queue once
+ * done, as destroying them can release large objects: audio buffers, decoded
+ * files, plug-in instances, graph nodes...
+ * They are destroyed here on a low-priority thread, instead of the GUI one.
+ *
+ * The execution thread starts a new epoch at each tick: objects taken from the
+ * queue are only freed once the epoch has changed, that is once the tick
+ * during which they were retired is over, or when the execution is stopped.
+ * The execution thread only does a lock-free enqueue: the queue is polled
+ * here, less often while nothing is retired.
+ */
+class SCORE_PLUGIN_ENGINE_EXPORT Reclaimer
+{
+public:
+  struct Metrics
+  {
+    //! Objects retired but not freed yet
+    std::size_t pending{};
+    //! Objects freed since the creation of the document
+    std::size_t reclaimed{};
+    //! Time spent freeing objects, in nanoseconds
+    int64_t busyTime{};
+    //! Longest time spent freeing a single batch, in nanoseconds
+    int64_t longestBatch{};
+  };
+
+  explicit Reclaimer(GCCommandQueue& queue);
+  ~Reclaimer();
+
+  //! Called by the execution thread at the beginning of each tick.
+  void nextEpoch() noexcept { m_epoch.fetch_add(1, std::memory_order_release); }
+
+  //! Whether the execution thread is ticking.
+  void setRunning(bool running) noexcept;
+
+  Metrics metrics() const noexcept;
+
+private:
+  void run();
+  void reclaim(std::vector<GCCommand>& batch, std::size_t count);
+  void waitEpoch(uint64_t epoch);
+
+  GCCommandQueue& m_queue;
+  std::unique_ptr<QThread> m_thread;
+
+  std::atomic<uint64_t> m_epoch{};
+  std::atomic_bool m_running{};
+  std::atomic_bool m_stop{};
+
+  std::atomic<std::size_t> m_inFlight{};
+  std::atomic<std::size_t> m_reclaimed{};
+  std::atomic<int64_t> m_busyTime{};
+  std::atomic<int64_t> m_longestBatch{};
+};
+}
@@ -45,13 +45,17 @@ SETTINGS_PARAMETER_IMPL(ValueCompilation){
     QStringLiteral("score_plugin_engine/ValueCompilation"), true};
 SETTINGS_PARAMETER_IMPL(TransportValueCompilation){
     QStringLiteral("score_plugin_engine/TransportValueCompilation"), false};
+SETTINGS_PARAMETER_IMPL(ControlFusion){
+    QStringLiteral("score_plugin_engine/ControlFusion"), true};
+SETTINGS_PARAMETER_IMPL(GuiUpdateBudget){
+    QStringLiteral("score_plugin_engine/GuiUpdateBudget"), 25};
 
 static auto list()
 {
   return std::tie(
       Clock, Rate, Scheduling, Ordering, Merging, Commit, Tick, Parallel,
       ExecutionListening, Logging, Bench, ScoreOrder, ValueCompilation,
-      TransportValueCompilation);
+      TransportValueCompilation, ControlFusion, GuiUpdateBudget);
 }
 }
 
@@ -115,5 +119,7 @@ SCORE_SETTINGS_PARAMETER_CPP(bool, Model, Bench)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, ScoreOrder)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, ValueCompilation)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, TransportValueCompilation)
+SCORE_SETTINGS_PARAMETER_CPP(bool, Model, ControlFusion)
+SCORE_SETTINGS_PARAMETER_CPP(int, Model, GuiUpdateBudget)
 }
 }
@@ -73,6 +73,8 @@ class SCORE_PLUGIN_ENGINE_EXPORT Model : public score::SettingsDelegateModel
   bool m_ScoreOrder{};
   bool m_ValueCompilation{};
   bool m_TransportValueCompilation{};
+  bool m_ControlFusion{};
+  int m_GuiUpdateBudget{};
 
   const ClockFactoryList& m_clockFactories;
   const Transport::TransportInterfaceList& m_transportInterfaces;
@@ -104,6 +106,8 @@ public:
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, bool, ValueCompilation)
   SCORE_SETTINGS_PARAMETER_HPP(
       SCORE_PLUGIN_ENGINE_EXPORT, bool, TransportValueCompilation)
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, bool, ControlFusion)
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, int, GuiUpdateBudget)
 };
 
 SCORE_SETTINGS_PARAMETER(Model, Clock)
@@ -120,5 +124,7 @@ SCORE_SETTINGS_PARAMETER(Model, Bench)
 SCORE_SETTINGS_PARAMETER(Model, ScoreOrder)
 SCORE_SETTINGS_PARAMETER(Model, ValueCompilation)
 SCORE_SETTINGS_PARAMETER(Model, TransportValueCompilation)
+SCORE_SETTINGS_PARAMETER(Model, ControlFusion)
+SCORE_SETTINGS_PARAMETER(Model, GuiUpdateBudget)
 }
 }
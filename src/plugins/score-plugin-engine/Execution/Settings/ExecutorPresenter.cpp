@@ -35,6 +35,8 @@ Presenter::Presenter(Model& m, View& v, QObject* parent)
   //SETTINGS_PRESENTER(ScoreOrder);
   SETTINGS_PRESENTER(ValueCompilation);
   SETTINGS_PRESENTER(TransportValueCompilation);
+  SETTINGS_PRESENTER(ControlFusion);
+  SETTINGS_PRESENTER(GuiUpdateBudget);
 
   // Clock used
   std::map<QString, ClockFactory::ConcreteKey> clockMap;
@@ -8,6 +8,7 @@
 #include <QCheckBox>
 #include <QFormLayout>
 #include <QGroupBox>
+#include <QSpinBox>
 
 namespace Execution
 {
@@ -66,6 +67,17 @@ View::View()
       "Transport value compilation\nSame as above, but also when doing transport if we "
       "are already playing.",
       TransportValueCompilation);
+  SETTINGS_UI_TOGGLE_SETUP(
+      "Control fusion\nChains of message-only processes are run as a single node of "
+      "the execution graph. Changes to these chains during playback split them again.",
+      ControlFusion);
+
+  SETTINGS_UI_SPINBOX_SETUP("GUI update budget (% of a frame)", GuiUpdateBudget);
+  m_GuiUpdateBudget->setRange(1, 100);
+  m_GuiUpdateBudget->setToolTip(
+      tr("Share of each display frame which can be spent applying the updates sent "
+         "by the execution to the user interface. The remaining ones are applied on "
+         "the next frames."));
 }
 
 SETTINGS_UI_COMBOBOX_IMPL(Tick)
@@ -81,6 +93,8 @@ SETTINGS_UI_TOGGLE_IMPL(Logging)
 SETTINGS_UI_TOGGLE_IMPL(Bench)
 SETTINGS_UI_TOGGLE_IMPL(ValueCompilation)
 SETTINGS_UI_TOGGLE_IMPL(TransportValueCompilation)
+SETTINGS_UI_TOGGLE_IMPL(ControlFusion)
+SETTINGS_UI_SPINBOX_IMPL(GuiUpdateBudget)
 
 QWidget* View::getWidget()
 {
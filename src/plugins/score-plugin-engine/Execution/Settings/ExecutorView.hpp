@@ -33,6 +33,8 @@ public:
   SETTINGS_UI_TOGGLE_HPP(ScoreOrder)
   SETTINGS_UI_TOGGLE_HPP(ValueCompilation)
   SETTINGS_UI_TOGGLE_HPP(TransportValueCompilation)
+  SETTINGS_UI_TOGGLE_HPP(ControlFusion)
+  SETTINGS_UI_SPINBOX_HPP(GuiUpdateBudget)
 
 private:
   QWidget* getWidget() override;
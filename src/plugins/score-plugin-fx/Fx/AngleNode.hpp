@@ -6,7 +6,7 @@ namespace Direction
 {
 struct Node
 {
-  struct Metadata : Control::Meta_base
+  struct Metadata : Control::Meta_fusable
   {
     static const constexpr auto prettyName = "Angle mapper";
     static const constexpr auto objectKey = "AngleMapper";
@@ -6,7 +6,7 @@ namespace EmptyValueMapping
 {
 struct Node
 {
-  struct Metadata : Control::Meta_base
+  struct Metadata : Control::Meta_fusable
   {
     static const constexpr auto prettyName = "Empty value mapper";
     static const constexpr auto objectKey = "EmptyValueMapper";
@@ -0,0 +1,33 @@
+#include "MathCompiler.hpp"
+
+namespace Nodes
+{
+static std::atomic<MathCompiler*> g_mathCompiler{};
+
+MathCompiler::~MathCompiler() = default;
+
+void MathCompiler::setInstance(MathCompiler* compiler) noexcept
+{
+  g_mathCompiler.store(compiler, std::memory_order_release);
+}
+
+bool MathCompiler::request(const std::shared_ptr<Request>& request) noexcept
+{
+  auto compiler = g_mathCompiler.load(std::memory_order_acquire);
+  if(!compiler)
+    return true;
+
+  request->pending.store(true, std::memory_order_release);
+  if(compiler->compile(request))
+    return true;
+
+  request->pending.store(false, std::memory_order_relaxed);
+  return false;
+}
+
+void MathCompiler::collect()
+{
+  if(auto compiler = g_mathCompiler.load(std::memory_order_acquire))
+    compiler->collectUnused();
+}
+}
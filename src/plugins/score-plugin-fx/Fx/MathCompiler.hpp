@@ -0,0 +1,186 @@
+#pragma once
+#include <score_plugin_fx_export.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace Nodes
+{
+/**
+ * @brief Variables of the value expressions.
+ *
+ * The ExprTK symbol table and the compiled kernels share this storage, so that
+ * the state of an expression (m1, m2, m3...) is kept when switching from one
+ * to the other.
+ * The layout is mirrored by the generated code: members must only be appended.
+ */
+struct MathValueVariables
+{
+  double cur_time{};
+  double cur_deltatime{};
+  double cur_pos{};
+  double fs{44100};
+  double x{}, px{}, po{};
+  double a{}, b{}, c{};
+  double pa{}, pb{}, pc{};
+  double m1{}, m2{}, m3{};
+};
+
+//! Variables of the audio expressions, for one block of samples.
+struct MathAudioVariables
+{
+  double cur_time{};
+  double fs{44100};
+  double a{}, b{}, c{};
+  double* m1{};
+  double* m2{};
+  double* m3{};
+  double* prev_in{};
+  int channels{};
+};
+
+//! Evaluates the expression once and returns its value.
+using MathValueKernel = double(MathValueVariables& v);
+
+//! Evaluates the expression for each frame of a block. in is null for generators.
+using MathAudioKernel = void(
+    MathAudioVariables& v, const double* const* in, double* const* out,
+    int64_t frames);
+
+/**
+ * @brief Compiles math expressions to native kernels.
+ *
+ * A compiler is registered by the JIT plug-in when it is available.
+ * Compilation happens in the background: the nodes keep using the ExprTK
+ * interpreter until the kernel is ready, and for good if the expression uses
+ * something the compiler does not support.
+ */
+class SCORE_PLUGIN_FX_EXPORT MathCompiler
+{
+public:
+  enum Kind
+  {
+    Value,
+    AudioGenerator,
+    AudioFilter
+  };
+
+  //! Audio kernels are only used up to this number of channels.
+  static constexpr int maxChannels = 64;
+
+  /**
+   * @brief Compilation of the expression of one node.
+   *
+   * Allocated along with the node. The execution thread only writes the
+   * expression while no compilation is pending, and the compiler only reads it
+   * while one is.
+   */
+  struct Request
+  {
+    //! Longer expressions are not compiled, as copying them would allocate.
+    static constexpr std::size_t maxExpressionSize = 1024;
+
+    Request() { expression.reserve(maxExpressionSize); }
+
+    std::string expression;
+    Kind kind{};
+    std::atomic<MathValueKernel*> value{};
+    std::atomic<MathAudioKernel*> audio{};
+    std::atomic_bool pending{};
+
+    // Kernel used by the request, only accessed by the compiler
+    const void* compiled{};
+  };
+
+  virtual ~MathCompiler();
+
+  static void setInstance(MathCompiler* compiler) noexcept;
+
+  /**
+   * @brief Queues the compilation of the expression of the request.
+   *
+   * Lock-free: returns false if the compiler cannot accept it right now,
+   * in which case it can be tried again later.
+   */
+  static bool request(const std::shared_ptr<Request>& request) noexcept;
+
+  //! Lets the compiler free the kernels which are not used anymore.
+  static void collect();
+
+protected:
+  //! Called from the execution thread: must not block nor allocate.
+  virtual bool compile(const std::shared_ptr<Request>& request) noexcept = 0;
+  virtual void collectUnused() = 0;
+};
+
+/**
+ * @brief Native version of the expression of a node, if any.
+ */
+template <typename Kernel>
+class MathKernel
+{
+public:
+  MathKernel()
+      : m_request{std::make_shared<MathCompiler::Request>()}
+  {
+    m_expression.reserve(MathCompiler::Request::maxExpressionSize);
+  }
+
+  MathKernel(const MathKernel&)
+      : MathKernel{}
+  {
+  }
+  MathKernel& operator=(const MathKernel&) = delete;
+
+  ~MathKernel()
+  {
+    m_request.reset();
+    MathCompiler::collect();
+  }
+
+  void update(const std::string& expression, MathCompiler::Kind kind)
+  {
+    if(m_upToDate && expression == m_expression)
+      return;
+    m_upToDate = false;
+
+    // Stays interpreted: the copies below must fit in the storage reserved
+    // beforehand, as this runs on the execution thread
+    if(expression.size() > MathCompiler::Request::maxExpressionSize)
+      return;
+
+    // The compiler still reads the previous expression: try again on the next tick
+    if(m_request->pending.load(std::memory_order_acquire))
+      return;
+
+    m_request->value.store(nullptr, std::memory_order_relaxed);
+    m_request->audio.store(nullptr, std::memory_order_relaxed);
+    m_request->expression = expression;
+    m_request->kind = kind;
+    if(MathCompiler::request(m_request))
+    {
+      m_expression = expression;
+      m_upToDate = true;
+    }
+  }
+
+  Kernel* get() const noexcept
+  {
+    if(!m_upToDate)
+      return nullptr;
+    if constexpr(std::is_same_v<Kernel, MathValueKernel>)
+      return m_request->value.load(std::memory_order_acquire);
+    else
+      return m_request->audio.load(std::memory_order_acquire);
+  }
+
+private:
+  std::string m_expression;
+  std::shared_ptr<MathCompiler::Request> m_request;
+  bool m_upToDate{};
+};
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <Engine/Node/SimpleApi.hpp>
 
+#include <Fx/MathCompiler.hpp>
+
 #include <ossia/math/math_expression.hpp>
 
 #include <numeric>
@@ -124,28 +126,24 @@ struct Node
         Control::FloatSlider("Param (b)", 0., 1., 0.5),
         Control::FloatSlider("Param (c)", 0., 1., 0.5));
   };
-  struct State
+  struct State : MathValueVariables
   {
     State()
     {
       expr.add_variable("t", cur_time);
       expr.add_variable("dt", cur_deltatime);
       expr.add_variable("pos", cur_pos);
-      expr.add_variable("a", p1);
-      expr.add_variable("b", p2);
-      expr.add_variable("c", p3);
+      expr.add_variable("a", a);
+      expr.add_variable("b", b);
+      expr.add_variable("c", c);
       expr.add_variable("m1", m1);
       expr.add_variable("m2", m2);
       expr.add_variable("m3", m3);
       expr.add_constants();
       expr.register_symbol_table();
     }
-    double cur_time{};
-    double cur_deltatime{};
-    double cur_pos{};
-    double p1{}, p2{}, p3{};
-    double m1{}, m2{}, m3{};
     ossia::math_expression expr;
+    MathKernel<MathValueKernel> kernel;
     bool ok = false;
   };
 
@@ -156,15 +154,18 @@ struct Node
   {
     if(!self.expr.set_expression(expr))
       return;
+    self.kernel.update(expr, MathCompiler::Value);
 
     setMathExpressionTiming(self, tk, st);
-    self.p1 = a;
-    self.p2 = b;
-    self.p3 = c;
+    self.a = a;
+    self.b = b;
+    self.c = c;
 
-    auto res = self.expr.result();
     const auto [tick_start, d] = st.timings(tk);
-    output.write_value(res, tick_start);
+    if(auto kernel = self.kernel.get())
+      output.write_value(float(kernel(self)), tick_start);
+    else
+      output.write_value(self.expr.result(), tick_start);
   }
 
   template <typename... Args>
@@ -265,6 +266,7 @@ struct Node
     std::vector<double> m1, m2, m3;
     double fs{44100};
     ossia::math_expression expr;
+    MathKernel<MathAudioKernel> kernel;
     bool ok = false;
   };
 
@@ -295,6 +297,21 @@ struct Node
       self.p2 = b;
       self.p3 = c;
       const auto start_sample = (tk.prev_date * samplesRatio).impl;
+
+      self.kernel.update(expr, MathCompiler::AudioGenerator);
+      if(auto kernel = self.kernel.get())
+      {
+        MathAudioVariables v{
+            double(start_sample), self.fs, a, b, c, self.m1.data(), self.m2.data(),
+            self.m3.data(), nullptr, chans};
+        double* outs[chans];
+        for(int j = 0; j < chans; j++)
+          outs[j] = output.channel(j).data() + tick_start;
+
+        kernel(v, nullptr, outs, count);
+        return;
+      }
+
       for(int64_t i = 0; i < count; i++)
       {
         self.cur_time = start_sample + i;
@@ -48,7 +48,11 @@ struct GenericMathMapping
 
   static void exec_scalar(int64_t timestamp, State& self, ossia::value_port& output)
   {
-    auto res = self.expr.result();
+    ossia::value res;
+    if(auto kernel = self.kernel.get())
+      res = float(kernel(self));
+    else
+      res = self.expr.result();
 
     self.px = self.x;
     store_output(self, res);
@@ -234,7 +238,7 @@ namespace MathMapping
 {
 struct Node
 {
-  struct Metadata : Control::Meta_base
+  struct Metadata : Control::Meta_fusable
   {
     static const constexpr auto prettyName = "Expression Value Filter";
     static const constexpr auto objectKey = "MathMapping";
@@ -259,7 +263,7 @@ struct Node
         Control::FloatSlider("Param (b)", 0., 1., 0.5),
         Control::FloatSlider("Param (c)", 0., 1., 0.5));
   };
-  struct State
+  struct State : MathValueVariables
   {
     State()
     {
@@ -297,21 +301,8 @@ struct Node
     std::vector<double> pxv;
     std::vector<double> pov;
 
-    double x{};
-    double px{};
-    double po{};
-
-    double cur_time{};
-    double cur_deltatime{};
-    double cur_pos{};
-    double fs{44100};
-
-    double a{}, b{}, c{};
-    double pa{}, pb{}, pc{};
-
-    double m1{}, m2{}, m3{};
-
     ossia::math_expression expr;
+    MathKernel<MathValueKernel> kernel;
     int64_t last_value_time{};
 
     bool ok = false;
@@ -325,6 +316,7 @@ struct Node
   {
     if(!self.expr.set_expression(expr))
       return;
+    self.kernel.update(expr, MathCompiler::Value);
 
     self.a = a;
     self.b = b;
@@ -457,6 +449,7 @@ struct Node
     std::vector<double> m1, m2, m3;
     double fs{44100};
     ossia::math_expression expr;
+    MathKernel<MathAudioKernel> kernel;
     bool ok = false;
   };
 
@@ -495,6 +488,25 @@ struct Node
       self.p2 = b;
       self.p3 = c;
       const auto start_sample = (tk.prev_date * samplesRatio).impl;
+
+      self.kernel.update(expr, MathCompiler::AudioFilter);
+      if(auto kernel = self.kernel.get(); kernel && chans <= MathCompiler::maxChannels)
+      {
+        MathAudioVariables v{
+            double(start_sample), self.fs, a, b, c, self.m1.data(), self.m2.data(),
+            self.m3.data(), self.prev_in.data(), chans};
+        const double* ins[MathCompiler::maxChannels];
+        double* outs[MathCompiler::maxChannels];
+        for(int j = 0; j < chans; j++)
+        {
+          ins[j] = input.channel(j).data() + tick_start;
+          outs[j] = output.channel(j).data() + tick_start;
+        }
+
+        kernel(v, ins, outs, min_count);
+        return;
+      }
+
       for(int64_t i = 0; i < min_count; i++)
       {
         for(int j = 0; j < chans; j++)
@@ -528,7 +540,7 @@ namespace MicroMapping
 {
 struct Node
 {
-  struct Metadata : Control::Meta_base
+  struct Metadata : Control::Meta_fusable
   {
     static const constexpr auto prettyName = "Micromap";
     static const constexpr auto objectKey = "MicroMapping";
@@ -546,7 +558,7 @@ struct Node
     static const constexpr auto controls
         = tuplet::make_tuple(Control::LineEdit("Expression", "x / 127"));
   };
-  struct State
+  struct State : MathValueVariables
   {
     State()
     {
@@ -573,15 +585,8 @@ struct Node
     std::vector<double> pxv;
     std::vector<double> pov;
 
-    double x{};
-    double px{};
-    double po{};
-
-    double cur_time{};
-    double cur_deltatime{};
-    double cur_pos{};
-
     ossia::math_expression expr;
+    MathKernel<MathValueKernel> kernel;
     int64_t last_value_time{};
 
     //bool ok = false;
@@ -595,6 +600,7 @@ struct Node
   {
     if(!self.expr.set_expression(expr))
       return;
+    self.kernel.update(expr, MathCompiler::Value);
 
     if(self.expr.has_variable("xv"))
       GenericMathMapping<State>::run_array(input, output, tk, st, self);
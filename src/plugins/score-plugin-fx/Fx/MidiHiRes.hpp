@@ -9,7 +9,7 @@ namespace MidiHiRes
 {
 struct Input
 {
-  struct Metadata : Control::Meta_base
+  struct Metadata : Control::Meta_fusable
   {
     static const constexpr auto prettyName = "Midi hi-res input";
     static const constexpr auto objectKey = "MidiHiResIn";
@@ -48,7 +48,7 @@ struct Input
 
 struct Output
 {
-  struct Metadata : Control::Meta_base
+  struct Metadata : Control::Meta_fusable
   {
     static const constexpr auto prettyName = "Midi hi-res output";
     static const constexpr auto objectKey = "MidiHiResOut";
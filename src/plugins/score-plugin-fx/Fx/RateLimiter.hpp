@@ -13,7 +13,7 @@ struct Node
   {
   };
 
-  struct Metadata : Control::Meta_base
+  struct Metadata : Control::Meta_fusable
   {
     static const constexpr auto prettyName = "Rate Limiter";
     static const constexpr auto objectKey = "RateLimiter";
@@ -182,7 +182,7 @@ namespace v1
 {
 struct Node
 {
-  struct Metadata : Control::Meta_base
+  struct Metadata : Control::Meta_fusable
   {
     static const constexpr auto prettyName = "Smooth (old)";
     static const constexpr auto objectKey = "ValueFilter";
@@ -278,7 +278,7 @@ namespace v2
 {
 struct Node
 {
-  struct Metadata : Control::Meta_base
+  struct Metadata : Control::Meta_fusable
   {
     static const constexpr auto prettyName = "Smooth";
     static const constexpr auto objectKey = "ValueFilter";
@@ -0,0 +1,114 @@
+#include <Process/Execution/FusedNode.hpp>
+
+#include <Fx/AngleNode.hpp>
+
+#include <ossia/dataflow/execution_state.hpp>
+#include <ossia/dataflow/graph/graph_interface.hpp>
+#include <ossia/dataflow/graph_edge.hpp>
+#include <ossia/dataflow/port.hpp>
+#include <ossia/network/value/value_conversion.hpp>
+
+#define CATCH_CONFIG_MAIN 1
+#if __has_include(<catch2/catch.hpp>)
+#include <catch2/catch.hpp>
+
+namespace
+{
+using Direction = ossia::safe_nodes::safe_node<Nodes::Direction::Node>;
+
+// Goes up and down, so that the angle mapper outputs all its values
+struct Source final : ossia::nonowning_graph_node
+{
+  Source() { m_outlets.push_back(&out); }
+
+  void run(const ossia::token_request& t, ossia::exec_state_facade) noexcept override
+  {
+    static constexpr float values[] = {0.f, 1.f, 1.f, 3.f, 2.f, -1.f, -1.f, 4.f};
+    for(int i = 0; i < 2; i++)
+      out->write_value(values[(t.date.impl / 64 * 2 + i) % 8], i);
+  }
+
+  ossia::value_outlet out;
+};
+
+struct Recorder final : ossia::nonowning_graph_node
+{
+  Recorder() { m_inlets.push_back(&in); }
+
+  void run(const ossia::token_request&, ossia::exec_state_facade) noexcept override
+  {
+    for(auto& v : in->get_data())
+      received.push_back(ossia::convert<int>(v.value));
+  }
+
+  ossia::value_inlet in;
+  std::vector<int> received;
+};
+
+struct Chain
+{
+  std::shared_ptr<Source> source = std::make_shared<Source>();
+  std::shared_ptr<Direction> direction = std::make_shared<Direction>();
+  std::shared_ptr<Recorder> recorder = std::make_shared<Recorder>();
+
+  auto& direction_in() { return *direction->root_inputs()[0]; }
+  auto& direction_out() { return *direction->root_outputs()[0]; }
+};
+
+ossia::token_request token(int64_t prev, int64_t date)
+{
+  ossia::token_request t{};
+  t.prev_date = ossia::time_value{prev};
+  t.date = ossia::time_value{date};
+  return t;
+}
+}
+
+TEST_CASE("test_fused_stateful_node", "test_fused_stateful_node")
+{
+  ossia::execution_state st;
+
+  // Reference: the chain is run by the graph
+  Chain graph_chain;
+  auto g = ossia::make_graph(ossia::graph_setup_options{});
+  g->add_node(graph_chain.source);
+  g->add_node(graph_chain.direction);
+  g->add_node(graph_chain.recorder);
+  g->connect(g->allocate_edge(
+      ossia::immediate_strict_connection{}, &graph_chain.source->out,
+      &graph_chain.direction_in(), graph_chain.source, graph_chain.direction));
+  g->connect(g->allocate_edge(
+      ossia::immediate_strict_connection{}, &graph_chain.direction_out(),
+      &graph_chain.recorder->in, graph_chain.direction, graph_chain.recorder));
+
+  // The same chain in a single node
+  Chain fused_chain;
+  auto fused = std::make_shared<Execution::FusedNode>(
+      std::vector<ossia::node_ptr>{
+          fused_chain.source, fused_chain.direction, fused_chain.recorder},
+      std::vector<Execution::FusedNode::Link>{
+          {&*fused_chain.source->out,
+           fused_chain.direction_in().target<ossia::value_port>()},
+          {fused_chain.direction_out().target<ossia::value_port>(),
+           &*fused_chain.recorder->in}});
+  auto fg = ossia::make_graph(ossia::graph_setup_options{});
+  fg->add_node(fused);
+
+  // The previous value kept by the angle mapper must carry over between ticks
+  for(int64_t i = 0; i < 8; i++)
+  {
+    const auto t = token(i * 64, (i + 1) * 64);
+    graph_chain.source->request(t);
+    graph_chain.direction->request(t);
+    graph_chain.recorder->request(t);
+    g->state(st);
+
+    for(int k = 0; k < 3; k++)
+      fused->request(t);
+    fg->state(st);
+  }
+
+  REQUIRE(graph_chain.recorder->received.size() == 15);
+  REQUIRE(fused_chain.recorder->received == graph_chain.recorder->received);
+}
+#endif
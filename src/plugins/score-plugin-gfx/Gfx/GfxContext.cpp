@@ -28,6 +28,8 @@ GfxContext::GfxContext(const score::DocumentContext& ctx)
       &GfxContext::recompute_graph);
   con(settings, &Gfx::Settings::Model::RateChanged, this, &GfxContext::recompute_graph);
   con(settings, &Gfx::Settings::Model::VSyncChanged, this, &GfxContext::recompute_graph);
+  con(settings, &Gfx::Settings::Model::SharedRenderingChanged, this,
+      &GfxContext::recompute_graph);
 
   m_graph = new score::gfx::Graph;
 
@@ -152,6 +154,7 @@ void GfxContext::recompute_graph()
   auto& settings = m_context.app.settings<Gfx::Settings::Model>();
   auto api = settings.graphicsApiEnum();
 
+  m_graph->setSharedRendering(settings.getSharedRendering());
   m_graph->createAllRenderLists(api);
 
   const bool vsync = settings.getVSync() && m_graph->canDoVSync();
@@ -145,6 +145,8 @@ void Graph::createAllRenderLists(GraphicsApi graphicsApi)
 
   m_renderers.reserve(ossia::max(16, std::ssize(m_outputs)));
 
+  updateMirrors();
+
   for(auto output : m_outputs)
   {
     initializeOutput(output, graphicsApi);
@@ -213,6 +215,53 @@ void Graph::recreateOutputRenderList(OutputNode& output)
   }
 }
 
+// Source ports of the edges going into each input of an output, in render order
+static std::vector<std::pair<int, Port*>> outputSources(const OutputNode& output)
+{
+  std::vector<std::pair<int, Port*>> sources;
+  for(int i = 0, N = std::ssize(output.input); i < N; i++)
+    for(auto edge : output.input[i]->edges)
+      sources.emplace_back(i, edge->source);
+  return sources;
+}
+
+std::vector<OutputNode*> Graph::updateMirrors()
+{
+  std::vector<OutputNode*> changed;
+  std::vector<std::pair<OutputNode*, std::vector<std::pair<int, Port*>>>> sources;
+
+  for(auto output : m_outputs)
+  {
+    OutputNode* mirror{};
+    if(m_sharedRendering)
+    {
+      auto src = outputSources(*output);
+      if(!src.empty())
+      {
+        for(auto& [other, other_src] : sources)
+        {
+          if(other_src == src && output->canMirror(*other))
+          {
+            mirror = other;
+            break;
+          }
+        }
+
+        if(!mirror)
+          sources.emplace_back(output, std::move(src));
+      }
+    }
+
+    if(output->mirrorSource() != mirror)
+    {
+      output->setMirrorSource(mirror);
+      changed.push_back(output);
+    }
+  }
+
+  return changed;
+}
+
 void Graph::initializeOutput(OutputNode* output, GraphicsApi graphicsApi)
 {
   output->updateGraphicsAPI(graphicsApi);
@@ -249,6 +298,8 @@ void Graph::initializeOutput(OutputNode* output, GraphicsApi graphicsApi)
 
 void Graph::relinkGraph()
 {
+  updateMirrors();
+
   for(auto r_it = m_renderers.begin(); r_it != m_renderers.end();)
   {
     auto& r = **r_it;
@@ -266,7 +317,8 @@ void Graph::relinkGraph()
     auto& model_nodes = r.nodes;
     {
       // In which order do we want to render stuff
-      graphwalk(model_nodes);
+      if(!r.output.mirrorSource())
+        graphwalk(model_nodes);
 
       if(model_nodes.size() > 1)
       {
@@ -377,8 +429,10 @@ Graph::createRenderList(OutputNode* output, std::shared_ptr<RenderState> state)
   {
     model_nodes.push_back(output);
 
-    // In which order do we want to render stuff
-    graphwalk(model_nodes);
+    // In which order do we want to render stuff.
+    // Mirrors do not render anything upstream.
+    if(!output->mirrorSource())
+      graphwalk(model_nodes);
 
     // Now we have the nodes in the order in which they are going to
     // be init'd (e.g. output node first to create the render targets)
@@ -480,7 +534,11 @@ void Graph::addAndLinkEdge(Port* source, Port* sink)
   auto output = dynamic_cast<OutputNode*>(sink->node);
   SCORE_ASSERT(output);
 
+  auto mirrors = updateMirrors();
   recreateOutputRenderList(*output);
+  for(auto mirror : mirrors)
+    if(mirror != output)
+      recreateOutputRenderList(*mirror);
 }
 
 void Graph::unlinkAndRemoveEdge(Port* source, Port* sink)
@@ -489,7 +547,11 @@ void Graph::unlinkAndRemoveEdge(Port* source, Port* sink)
   auto output = dynamic_cast<OutputNode*>(sink->node);
   SCORE_ASSERT(output);
 
+  auto mirrors = updateMirrors();
   recreateOutputRenderList(*output);
+  for(auto mirror : mirrors)
+    if(mirror != output)
+      recreateOutputRenderList(*mirror);
 }
 
 void Graph::destroyOutputRenderList(score::gfx::OutputNode& output)
@@ -517,6 +579,11 @@ void Graph::destroyOutputRenderList(score::gfx::OutputNode& output)
   }
 
   ossia::remove_erase(m_outputs, &output);
+  output.setMirrorSource(nullptr);
+
+  // The outputs which were showing this one now have to render by themselves
+  for(auto mirror : updateMirrors())
+    recreateOutputRenderList(*mirror);
 }
 
 }
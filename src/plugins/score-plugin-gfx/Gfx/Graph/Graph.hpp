@@ -84,6 +84,15 @@ struct SCORE_PLUGIN_GFX_EXPORT Graph
    */
   void setVSyncCallback(std::function<void()>);
 
+  /**
+   * @brief Render the graph only once for outputs fed by the same ports.
+   *
+   * The outputs which support it then show the frames rendered for the first of
+   * them instead of rendering the upstream nodes again.
+   * Takes effect on the next call to createAllRenderLists.
+   */
+  void setSharedRendering(bool b) noexcept { m_sharedRendering = b; }
+
   /**
    * @brief True if the graph supports being driven by the screen vertical synchronization.
    */
@@ -98,6 +107,7 @@ private:
   void initializeOutput(OutputNode* output, GraphicsApi graphicsApi);
   void createOutputRenderList(OutputNode& output);
   void recreateOutputRenderList(OutputNode& output);
+  std::vector<OutputNode*> updateMirrors();
   std::shared_ptr<RenderList>
   createRenderList(OutputNode*, std::shared_ptr<RenderState> state);
 
@@ -109,5 +119,7 @@ private:
   std::vector<Edge*> m_edges;
 
   std::vector<OutputNode*> m_outputs;
+
+  bool m_sharedRendering{};
 };
 }
@@ -2,12 +2,14 @@
 #include <Gfx/Graph/NodeRenderer.hpp>
 #include <Gfx/Graph/RenderList.hpp>
 #include <Gfx/Graph/RenderState.hpp>
-#include <Gfx/Images/Process.hpp>
+#include <Gfx/Images/ImageStreamer.hpp>
 
 #include <ossia/detail/math.hpp>
 #include <ossia/gfx/port_index.hpp>
 #include <ossia/network/value/value_conversion.hpp>
 
+#include <list>
+
 namespace score::gfx
 {
 static int imageIndex(int idx, int size)
@@ -148,6 +150,7 @@ void main ()
 }
 )_";
 ImagesNode::ImagesNode()
+    : streamer{std::make_unique<Gfx::ImageStreamer>()}
 {
   input.push_back(new Port{this, &ubo.currentImageIndex, Types::Int, {}});
   input.push_back(new Port{this, &ubo.opacity, Types::Float, {}});
@@ -177,14 +180,8 @@ void ImagesNode::process(Message&& msg)
               [this, sink](const auto& v) { ProcessNode::process(sink.port, v); },
               std::move(m));
 
-          if(linearImages.size() > 0)
-          {
-            const int idx = imageIndex(ubo.currentImageIndex, linearImages.size());
-            auto sz = linearImages[idx]->size();
-            ubo.imageSize[0] = sz.width();
-            ubo.imageSize[1] = sz.height();
-          }
-
+          m_baseIndex = ubo.currentImageIndex;
+          updateImageSize();
           break;
         }
         case 1: // Opacity
@@ -225,24 +222,13 @@ void ImagesNode::process(Message&& msg)
         case 5: // Images
         {
           {
-            linearImages.clear();
-            Gfx::releaseImages(images);
-            images = Gfx::getImages(*val);
-            for(auto& img : images)
-            {
-              for(auto& frame : img.frames)
-              {
-                linearImages.push_back(&frame);
-              }
-            }
-
-            if(linearImages.size() > 0)
-            {
-              const int idx = imageIndex(ubo.currentImageIndex, linearImages.size());
-              auto sz = linearImages[idx]->size();
-              ubo.imageSize[0] = sz.width();
-              ubo.imageSize[1] = sz.height();
-            }
+            std::vector<QString> paths;
+            for(auto& path : ossia::convert<std::vector<ossia::value>>(*val))
+              paths.push_back(QString::fromStdString(ossia::convert<std::string>(path)));
+            streamer->setPaths(paths);
+
+            m_sizeIndex = -1;
+            updateImageSize();
 
             ++this->imagesChanged;
           }
@@ -257,16 +243,47 @@ void ImagesNode::process(Message&& msg)
           }
           break;
         }
+
+        case 7: // Frame rate
+        {
+          m_frameRate = std::max(ossia::convert<float>(*val), 0.f);
+          break;
+        }
       }
     }
 
     p++;
   }
+
+  // Play the images as a sequence, starting from the index set by the user
+  if(m_frameRate > 0.f)
+    ubo.currentImageIndex = m_baseIndex + int(standardUBO.time * m_frameRate);
+
+  // Also picks up the size of an image which was still being decoded
+  updateImageSize();
+}
+
+void ImagesNode::updateImageSize()
+{
+  const int count = streamer->frameCount();
+  if(count <= 0)
+    return;
+
+  const int idx = imageIndex(ubo.currentImageIndex, count);
+  if(idx == m_sizeIndex)
+    return;
+
+  // The previous size is kept until the image is decoded
+  if(const auto sz = streamer->frameSize(idx); sz.isValid())
+  {
+    ubo.imageSize[0] = sz.width();
+    ubo.imageSize[1] = sz.height();
+    m_sizeIndex = idx;
+  }
 }
 
 ImagesNode::~ImagesNode()
 {
-  Gfx::releaseImages(images);
   m_materialData.release();
 }
 
@@ -298,37 +315,25 @@ static QRhiSampler* createSampler(ImageMode tile, QRhi& rhi)
   sampler->create();
   return sampler;
 }
-class ImagesNode::PreloadedRenderer : public GenericNodeRenderer
+class ImagesNode::Renderer : public GenericNodeRenderer
 {
 public:
   using GenericNodeRenderer::GenericNodeRenderer;
 
 private:
-  ~PreloadedRenderer() { }
+  ~Renderer() { }
 
-  int imagesChanged = -1;
-  ImageMode tile{};
+  // Maximum number of images kept on the GPU
+  static constexpr std::size_t textureCacheSize = 16;
 
-  void recreateTextures(QRhi& rhi)
+  struct CachedTexture
   {
-    auto& n = static_cast<const ImagesNode&>(this->node);
-
-    const int limits_min = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMin);
-    const int limits_max = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMax);
-
-    for(const QImage* frame : n.linearImages)
-    {
-      const QSize sz = frame->size();
-      auto tex = rhi.newTexture(
-          QRhiTexture::BGRA8,
-          resizeTextureSize(QSize{sz.width(), sz.height()}, limits_min, limits_max), 1,
-          QRhiTexture::Flag{});
+    int index{-1};
+    QRhiTexture* texture{};
+  };
 
-      tex->setName("ImagesNode::tex");
-      tex->create();
-      m_textures.push_back(tex);
-    }
-  }
+  int imagesChanged = -1;
+  ImageMode tile{};
 
   TextureRenderTarget renderTargetForInput(const Port& p) override { return {}; }
   void init(RenderList& renderer, QRhiResourceUpdateBatch& res) override
@@ -340,12 +345,9 @@ private:
     processUBOInit(renderer);
     m_material.init(renderer, node.input, m_samplers);
 
-    m_prev_ubo.currentImageIndex = -1;
+    m_currentIndex = -1;
     QRhi& rhi = *renderer.state.rhi;
 
-    // Create GPU textures for each image
-    recreateTextures(rhi);
-
     tile = n.tile;
     QShader &v = m_vertexS, &f = m_fragmentS;
     if(!tile)
@@ -355,11 +357,12 @@ private:
       std::tie(v, f) = score::gfx::makeShaders(
           rs, TexturedTriangle{}.defaultVertexShader(), images_tiled_fragment_shader);
 
-    // Create the sampler in which we are going to put the texture
+    // Create the sampler in which we are going to put the texture.
+    // Images are uploaded in update(), as soon as they are decoded.
     {
       auto sampler = createSampler(tile, rhi);
-      auto tex = m_textures.empty() ? &renderer.emptyTexture() : m_textures.front();
-      m_samplers.push_back({sampler, tex});
+      m_currentTexture = &renderer.emptyTexture();
+      m_samplers.push_back({sampler, m_currentTexture});
     }
 
     // Initialize the passes for the "single" case
@@ -383,209 +386,56 @@ private:
     }
   }
 
-  void update(RenderList& renderer, QRhiResourceUpdateBatch& res) override
+  // Returns the texture of an image if it is on the GPU or could be uploaded,
+  // nullptr if the image is still being decoded.
+  QRhiTexture*
+  textureForIndex(RenderList& renderer, QRhiResourceUpdateBatch& res, int idx)
   {
     auto& n = static_cast<const ImagesNode&>(this->node);
 
-    if(n.tile != tile)
-    {
-      tile = n.tile;
-      auto [s, tex] = m_samplers[0];
-      m_samplers.clear();
-
-      // Create a new sampler
-      auto new_sampler = createSampler(tile, *renderer.state.rhi);
-      m_samplers.push_back({new_sampler, tex});
-
-      // Replace it in the render passes
-      auto replace_sampler = [](PassMap& passes, QRhiSampler* oldS, QRhiSampler* newS) {
-        for(auto& pass : passes)
-          score::gfx::replaceSampler(*pass.second.srb, oldS, newS);
-      };
-
-      replace_sampler(m_p, s, new_sampler);
-      replace_sampler(m_altPasses, s, new_sampler);
-
-      // Release the old sampler
-      s->deleteLater();
-    }
+    // Also keeps the decoding going ahead of the displayed image
+    auto img = n.streamer->frame(idx);
 
-    bool updateCurrentTexture = false;
-    if(n.imagesChanged > imagesChanged)
+    for(auto it = m_textures.begin(); it != m_textures.end(); ++it)
     {
-      imagesChanged = n.imagesChanged;
-      for(auto tex : m_textures)
+      if(it->index == idx)
       {
-        tex->deleteLater();
+        m_textures.splice(m_textures.begin(), m_textures, it);
+        return it->texture;
       }
-      m_textures.clear();
-
-      recreateTextures(*renderer.state.rhi);
-      m_uploaded = false;
     }
 
-    // If images haven't been uploaded yet, upload them.
-    if(!m_uploaded)
-    {
-      std::size_t k = 0;
-      for(const QImage* frame : n.linearImages)
-      {
-        res.uploadTexture(m_textures[k], renderer.adaptImage(*frame));
-        k++;
-      }
-      m_uploaded = true;
-      updateCurrentTexture = true;
-    }
+    if(!img)
+      return nullptr;
 
-    // If the current image being displayed by this renderer (in m_prev_ubo)
-    // is out of date with the image in the data model, we switch the texture
-    if(updateCurrentTexture || m_prev_ubo.currentImageIndex != n.ubo.currentImageIndex)
-    {
-      auto replace_texture
-          = [](PassMap& passes, QRhiSampler* sampler, QRhiTexture* tex) {
-        for(auto& pass : passes)
-          score::gfx::replaceTexture(*pass.second.srb, sampler, tex);
-      };
+    const QImage frame = renderer.adaptImage(*img);
+    QRhiTexture* tex{};
 
-      const int idx = imageIndex(n.ubo.currentImageIndex, m_textures.size());
-      QRhiSampler* sampler = m_samplers[0].sampler;
-      QRhiTexture* new_tex{};
-      if(ossia::valid_index(idx, m_textures))
-      {
-        new_tex = m_textures[idx];
-      }
-      else
-      {
-        new_tex = &renderer.emptyTexture();
-      }
-
-      replace_texture(m_p, sampler, new_tex);
-      replace_texture(m_altPasses, sampler, new_tex);
-
-      m_prev_ubo.currentImageIndex = n.ubo.currentImageIndex;
-    }
-
-    GenericNodeRenderer::update(renderer, res);
-  }
-
-  void runRenderPass(RenderList& renderer, QRhiCommandBuffer& cb, Edge& edge) override
-  {
-    const auto& mesh = renderer.defaultQuad();
-    if(tile == ImageMode::Single)
-      defaultRenderPass(renderer, mesh, cb, edge, m_p);
-    else
-      defaultRenderPass(renderer, mesh, cb, edge, m_altPasses);
-  }
-
-  void release(RenderList& r) override
-  {
-    for(auto tex : m_textures)
+    // Recycle the least recently used texture which is not displayed
+    if(m_textures.size() >= textureCacheSize)
     {
-      tex->deleteLater();
-    }
-    m_textures.clear();
+      auto it = std::prev(m_textures.end());
+      if(it->texture == m_currentTexture)
+        it = std::prev(it);
 
-    defaultRelease(r);
-
-    {
-      for(auto& pass : m_altPasses)
-        pass.second.release();
-      m_altPasses.clear();
+      if(it->texture->pixelSize() == frame.size())
+        tex = it->texture;
+      else
+        it->texture->deleteLater();
+      m_textures.erase(it);
     }
-  }
-
-  struct ImagesNode::UBO m_prev_ubo;
-  ossia::small_vector<std::pair<Edge*, Pipeline>, 2> m_altPasses;
-  std::vector<QRhiTexture*> m_textures;
-  bool m_uploaded = false;
-};
-
-class ImagesNode::OnTheFlyRenderer : public GenericNodeRenderer
-{
-public:
-  using GenericNodeRenderer::GenericNodeRenderer;
 
-private:
-  ~OnTheFlyRenderer() { }
-
-  int imagesChanged = -1;
-  ImageMode tile{};
-
-  void recreateTexture(QRhi& rhi)
-  {
-    auto& n = static_cast<const ImagesNode&>(this->node);
-
-    const int limits_min = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMin);
-    const int limits_max = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMax);
-
-    QSize maxSize{1, 1};
-    for(const QImage* frame : n.linearImages)
+    if(!tex)
     {
-      const auto sz = resizeTextureSize(frame->size(), limits_min, limits_max);
-
-      maxSize.setWidth(std::max(maxSize.width(), sz.width()));
-      maxSize.setHeight(std::max(maxSize.height(), sz.height()));
-    }
-
-    auto tex = rhi.newTexture(QRhiTexture::BGRA8, maxSize, 1, QRhiTexture::Flag{});
-
-    tex->setName("OnTheFlyRenderer::tex");
-    tex->create();
-
-    m_texture = tex;
-  }
-
-  TextureRenderTarget renderTargetForInput(const Port& p) override { return {}; }
-  void init(RenderList& renderer, QRhiResourceUpdateBatch& res) override
-  {
-    auto& n = static_cast<const ImagesNode&>(this->node);
-    const auto& rs = renderer.state;
-    const auto& mesh = renderer.defaultQuad();
-    defaultMeshInit(renderer, mesh, res);
-    processUBOInit(renderer);
-    m_material.init(renderer, node.input, m_samplers);
-
-    m_prev_ubo.currentImageIndex = -1;
-    QRhi& rhi = *renderer.state.rhi;
-
-    tile = n.tile;
-    QShader &v = m_vertexS, &f = m_fragmentS;
-    if(!tile)
-      std::tie(v, f) = score::gfx::makeShaders(
-          rs, images_single_vertex_shader, images_single_fragment_shader);
-    else
-      std::tie(v, f) = score::gfx::makeShaders(
-          rs, TexturedTriangle{}.defaultVertexShader(), images_tiled_fragment_shader);
-
-    // Create the sampler in which we are going to put the texture
-    {
-      auto sampler = createSampler(tile, rhi);
-
-      // Create GPU texture
-      recreateTexture(rhi);
-
-      m_samplers.push_back({sampler, m_texture});
+      tex = renderer.state.rhi->newTexture(
+          QRhiTexture::BGRA8, frame.size(), 1, QRhiTexture::Flag{});
+      tex->setName("ImagesNode::tex");
+      tex->create();
     }
 
-    // Initialize the passes for the "single" case
-    defaultPassesInit(renderer, mesh);
-
-    // Initialize the passes for the "tiled" case
-    {
-      auto [v, f] = score::gfx::makeShaders(
-          rs, TexturedTriangle{}.defaultVertexShader(), images_tiled_fragment_shader);
-      for(Edge* edge : this->node.output[0]->edges)
-      {
-        auto rt = renderer.renderTargetForOutput(*edge);
-        if(rt.renderTarget)
-        {
-          m_altPasses.emplace_back(
-              edge, score::gfx::buildPipeline(
-                        renderer, mesh, v, f, rt, m_processUBO, m_material.buffer,
-                        m_samplers));
-        }
-      }
-    }
+    res.uploadTexture(tex, frame);
+    m_textures.push_front({idx, tex});
+    return tex;
   }
 
   void update(RenderList& renderer, QRhiResourceUpdateBatch& res) override
@@ -596,7 +446,6 @@ private:
     {
       tile = n.tile;
       auto [s, tex] = m_samplers[0];
-
       m_samplers.clear();
 
       // Create a new sampler
@@ -619,37 +468,45 @@ private:
     if(n.imagesChanged > imagesChanged)
     {
       imagesChanged = n.imagesChanged;
-      m_texture->deleteLater();
-      m_texture = nullptr;
 
-      recreateTexture(*renderer.state.rhi);
-      m_uploaded = false;
+      // The indices now refer to other images: the textures will get recycled.
+      // The current one stays displayed until the new image is ready.
+      for(auto& cached : m_textures)
+        cached.index = -1;
+      m_currentIndex = -1;
+    }
+
+    // If the image being displayed by this renderer is out of date with
+    // the image in the data model, we switch the texture
+    QRhiTexture* new_tex{};
+    const int count = n.streamer->frameCount();
+    if(count > 0)
+    {
+      const int idx = imageIndex(n.ubo.currentImageIndex, count);
+      if(idx != m_currentIndex)
+      {
+        if((new_tex = textureForIndex(renderer, res, idx)))
+          m_currentIndex = idx;
+      }
+    }
+    else if(m_currentTexture != &renderer.emptyTexture())
+    {
+      new_tex = &renderer.emptyTexture();
+      m_currentIndex = -1;
+    }
 
+    if(new_tex && new_tex != m_currentTexture)
+    {
       auto replace_texture
           = [](PassMap& passes, QRhiSampler* sampler, QRhiTexture* tex) {
         for(auto& pass : passes)
           score::gfx::replaceTexture(*pass.second.srb, sampler, tex);
       };
 
-      auto sampler = m_samplers[0].sampler;
-      replace_texture(m_p, sampler, m_texture);
-      replace_texture(m_altPasses, sampler, m_texture);
-    }
-
-    // If the current image being displayed by this renderer (in m_prev_ubo)
-    // is out of date with the image in the data model, we switch the texture
-    if(!m_uploaded || m_prev_ubo.currentImageIndex != n.ubo.currentImageIndex)
-    {
-      const int idx = imageIndex(n.ubo.currentImageIndex, n.linearImages.size());
-      if(ossia::valid_index(idx, n.linearImages))
-      {
-        auto frame = n.linearImages[idx];
-
-        res.uploadTexture(m_texture, renderer.adaptImage(*frame));
-
-        m_prev_ubo.currentImageIndex = n.ubo.currentImageIndex;
-        m_uploaded = true;
-      }
+      QRhiSampler* sampler = m_samplers[0].sampler;
+      replace_texture(m_p, sampler, new_tex);
+      replace_texture(m_altPasses, sampler, new_tex);
+      m_currentTexture = new_tex;
     }
 
     GenericNodeRenderer::update(renderer, res);
@@ -666,8 +523,13 @@ private:
 
   void release(RenderList& r) override
   {
-    m_texture->deleteLater();
-    m_texture = nullptr;
+    for(auto& cached : m_textures)
+    {
+      cached.texture->deleteLater();
+    }
+    m_textures.clear();
+    m_currentTexture = nullptr;
+    m_currentIndex = -1;
 
     defaultRelease(r);
 
@@ -678,16 +540,18 @@ private:
     }
   }
 
-  struct ImagesNode::UBO m_prev_ubo;
   ossia::small_vector<std::pair<Edge*, Pipeline>, 2> m_altPasses;
-  QRhiTexture* m_texture{};
-  bool m_uploaded = false;
+
+  // Most recently used first
+  std::list<CachedTexture> m_textures;
+  QRhiTexture* m_currentTexture{};
+  int m_currentIndex{-1};
 };
 #include <Gfx/Qt5CompatPop> // clang-format: keep
 
 NodeRenderer* ImagesNode::createRenderer(RenderList& r) const noexcept
 {
-  return new PreloadedRenderer{*this};
+  return new Renderer{*this};
 }
 
 }
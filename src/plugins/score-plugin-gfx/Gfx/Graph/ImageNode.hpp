@@ -2,6 +2,11 @@
 
 #include <Gfx/Graph/Node.hpp>
 
+namespace Gfx
+{
+class ImageStreamer;
+}
+
 namespace score::gfx
 {
 enum ImageMode
@@ -23,8 +28,7 @@ public:
 
   score::gfx::NodeRenderer* createRenderer(RenderList& r) const noexcept override;
 
-  class PreloadedRenderer;
-  class OnTheFlyRenderer;
+  class Renderer;
 
 #pragma pack(push, 1)
   struct UBO
@@ -42,9 +46,14 @@ public:
 
 private:
   void process(Message&& msg) override;
+  void updateImageSize();
+
+  // Images are decoded on demand, and only a bounded number of them is kept in memory
+  std::unique_ptr<Gfx::ImageStreamer> streamer;
 
-  std::vector<score::gfx::Image> images;
-  std::vector<QImage*> linearImages;
+  int m_baseIndex{};
+  int m_sizeIndex{-1};
+  float m_frameRate{};
 };
 struct FullScreenImageNode : NodeModel
 {
@@ -194,6 +194,26 @@ void NodeRenderer::runInitialPasses(
 void NodeRenderer::runRenderPass(RenderList&, QRhiCommandBuffer& commands, Edge& edge) {
 }
 
+const void* NodeRenderer::batchKey() const noexcept
+{
+  return nullptr;
+}
+
+void NodeRenderer::runBatchedInitialPasses(
+    RenderList& renderer, QRhiCommandBuffer& commands, QRhiResourceUpdateBatch*& res,
+    tcb::span<RenderedEdge> batch)
+{
+  for(auto [edge, node] : batch)
+    node->runInitialPasses(renderer, commands, res, *edge);
+}
+
+void NodeRenderer::runBatchedRenderPass(
+    RenderList& renderer, QRhiCommandBuffer& commands, tcb::span<RenderedEdge> batch)
+{
+  for(auto [edge, node] : batch)
+    node->runRenderPass(renderer, commands, *edge);
+}
+
 void GenericNodeRenderer::defaultRenderPass(
     RenderList& renderer, const Mesh& mesh, QRhiCommandBuffer& cb, Edge& edge)
 {
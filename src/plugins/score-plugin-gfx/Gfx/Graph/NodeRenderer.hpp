@@ -1,8 +1,20 @@
 #pragma once
 #include <Gfx/Graph/Node.hpp>
 
+#include <ossia/detail/span.hpp>
+
 namespace score::gfx
 {
+class NodeRenderer;
+
+/**
+ * @brief A renderer, and the edge through which it is being rendered.
+ */
+struct RenderedEdge
+{
+  Edge* edge{};
+  NodeRenderer* renderer{};
+};
 
 /**
  * @brief Renderer for a given node.
@@ -29,6 +41,24 @@ public:
 
   virtual void runRenderPass(RenderList&, QRhiCommandBuffer& commands, Edge& edge);
 
+  /**
+   * @brief Key used to draw consecutive renderers together.
+   *
+   * Consecutive renderers of a render pass which return the same non-null key
+   * are rendered through the runBatched* methods of the first one, e.g. in
+   * order to draw them with a single pipeline and an instanced draw call.
+   */
+  virtual const void* batchKey() const noexcept;
+
+  //! By default, calls runInitialPasses for each renderer of the batch.
+  virtual void runBatchedInitialPasses(
+      RenderList&, QRhiCommandBuffer& commands, QRhiResourceUpdateBatch*& res,
+      tcb::span<RenderedEdge> batch);
+
+  //! By default, calls runRenderPass for each renderer of the batch.
+  virtual void runBatchedRenderPass(
+      RenderList&, QRhiCommandBuffer& commands, tcb::span<RenderedEdge> batch);
+
   virtual void release(RenderList&) = 0;
 };
 
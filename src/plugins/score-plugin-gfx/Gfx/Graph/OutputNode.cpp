@@ -8,8 +8,18 @@ OutputNode::~OutputNode() { }
 
 void OutputNode::updateGraphicsAPI(GraphicsApi) { }
 
+bool OutputNode::canMirror(const OutputNode& source) const noexcept
+{
+  return false;
+}
+
 OutputNodeRenderer::~OutputNodeRenderer() { }
 
 void OutputNodeRenderer::finishFrame(RenderList&, QRhiCommandBuffer& commands) { }
 
+QRhiTexture* OutputNodeRenderer::renderedTexture() const noexcept
+{
+  return nullptr;
+}
+
 }
@@ -12,6 +12,9 @@ class SCORE_PLUGIN_GFX_EXPORT OutputNodeRenderer : public score::gfx::NodeRender
 public:
   virtual ~OutputNodeRenderer();
   virtual void finishFrame(RenderList&, QRhiCommandBuffer& commands);
+
+  //! Texture in which the graph is rendered before being output, if any.
+  virtual QRhiTexture* renderedTexture() const noexcept;
 };
 
 class Window;
@@ -53,7 +56,26 @@ public:
 
   virtual Configuration configuration() const noexcept = 0;
 
+  /**
+   * @brief Whether this output is able to show the frames rendered by another one.
+   *
+   * This requires both outputs to use the same QRhi.
+   */
+  virtual bool canMirror(const OutputNode& source) const noexcept;
+
+  /**
+   * @brief Output whose frames are shown instead of rendering the graph again.
+   *
+   * Set by the Graph when rendering is shared, for outputs fed by exactly the
+   * same ports as another one.
+   */
+  OutputNode* mirrorSource() const noexcept { return m_mirrorSource; }
+  void setMirrorSource(OutputNode* source) noexcept { m_mirrorSource = source; }
+
 protected:
   explicit OutputNode();
+
+private:
+  OutputNode* m_mirrorSource{};
 };
 }
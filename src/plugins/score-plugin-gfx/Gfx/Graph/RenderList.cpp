@@ -11,6 +11,10 @@
 namespace score::gfx
 {
 #include <Gfx/Qt5CompatPush> // clang-format: keep
+RenderListResource::~RenderListResource() = default;
+
+void RenderListResource::update(RenderList& renderer, QRhiResourceUpdateBatch& res) { }
+
 MeshBuffers RenderList::initMeshBuffer(const Mesh& mesh, QRhiResourceUpdateBatch& res)
 {
   if(auto it = m_vertexBuffers.find(&mesh); it != m_vertexBuffers.end())
@@ -84,6 +88,12 @@ void RenderList::release()
     node->release(*this);
   }
 
+  for(auto& [key, res] : m_sharedResources)
+  {
+    res->release(*this);
+  }
+  m_sharedResources.clear();
+
   for(auto bufs : m_vertexBuffers)
   {
     delete bufs.second.mesh;
@@ -235,14 +245,12 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
   //    Render
   //  End pass
 
-  struct EdgePair
-  {
-    Edge* edge;
-    NodeRenderer* node;
-  };
+  ossia::small_pod_vector<RenderedEdge, 4> prevRenderers;
+  ossia::small_pod_vector<tcb::span<RenderedEdge>, 4> batches;
 
-  ossia::small_pod_vector<EdgePair, 4> prevRenderers;
-  for(auto it = this->nodes.rbegin(); it != this->nodes.rend(); ++it)
+  // Mirrors only show what was rendered for another output
+  const bool mirror = this->output.mirrorSource();
+  for(auto it = this->nodes.rbegin(); !mirror && it != this->nodes.rend(); ++it)
   {
     auto node = *it;
     for(auto input : node->input)
@@ -268,12 +276,27 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
           renderer->update(*this, *updateBatch);
         }
 
+        // Group the consecutive renderers which can be drawn together
+        batches.clear();
+        for(std::size_t i = 0, N = prevRenderers.size(); i < N;)
+        {
+          std::size_t j = i + 1;
+          if(auto key = prevRenderers[i].renderer->batchKey())
+          {
+            while(j < N && prevRenderers[j].renderer->batchKey() == key)
+              j++;
+          }
+          batches.push_back({prevRenderers.data() + i, j - i});
+          i = j;
+        }
+
         // For nodes that perform multiple rendering passes,
         // pre-computations in compute shaders, etc... run them now.
         // Most nodes don't do anything there.
-        for(auto [edge, renderer] : prevRenderers)
+        for(auto batch : batches)
         {
-          renderer->runInitialPasses(*this, commands, updateBatch, *edge);
+          batch.front().renderer->runBatchedInitialPasses(
+              *this, commands, updateBatch, batch);
         }
 
         // Then do the final render of each node on the edge sink's render target
@@ -287,9 +310,9 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
           commands.beginPass(rt.renderTarget, Qt::black, {1.0f, 0}, updateBatch);
 
           QRhiResourceUpdateBatch* res{};
-          for(auto [edge, node] : prevRenderers)
+          for(auto batch : batches)
           {
-            node->runRenderPass(*this, commands, *edge);
+            batch.front().renderer->runBatchedRenderPass(*this, commands, batch);
           }
 
           // Allow the node to do some actions, for instance if a readback
@@ -368,6 +391,11 @@ void RenderList::update(QRhiResourceUpdateBatch& res)
 
     res.updateDynamicBuffer(m_outputUBO, 0, sizeof(OutputUBO), &m_outputUBOData);
   }
+
+  for(auto& [key, shared] : m_sharedResources)
+  {
+    shared->update(*this, res);
+  }
 }
 
 #include <Gfx/Qt5CompatPop> // clang-format: keep
@@ -6,6 +6,25 @@ namespace score::gfx
 {
 
 class OutputNode;
+
+/**
+ * @brief GPU resources shared by all the renderers of a given kind in a RenderList.
+ *
+ * For instance, renderers which draw together with instancing keep their
+ * common pipeline, atlas and instance buffer in such a resource.
+ */
+class SCORE_PLUGIN_GFX_EXPORT RenderListResource
+{
+public:
+  virtual ~RenderListResource();
+
+  //! Called once per frame, before any node gets rendered.
+  virtual void update(RenderList& renderer, QRhiResourceUpdateBatch& res);
+
+  //! Called after the renderers have been released.
+  virtual void release(RenderList& renderer) = 0;
+};
+
 /**
  * @brief List of nodes to be rendered to an output.
  *
@@ -128,6 +147,21 @@ public:
 
   int samples() const noexcept { return m_samples; }
 
+  /**
+   * @brief Resource of type T shared by the renderers of this list.
+   *
+   * It is created on first use, and destroyed when the list is released.
+   */
+  template <typename T>
+  T& sharedResource()
+  {
+    static const char key{};
+    auto& res = m_sharedResources[&key];
+    if(!res)
+      res = std::make_unique<T>();
+    return static_cast<T&>(*res);
+  }
+
 private:
   OutputUBO m_outputUBOData;
 
@@ -141,6 +175,8 @@ private:
    */
   ossia::flat_map<const Mesh*, MeshBuffers> m_vertexBuffers;
 
+  ossia::flat_map<const void*, std::unique_ptr<RenderListResource>> m_sharedResources;
+
   /**
    * @brief Last size used by this renderer.
    */
@@ -35,6 +35,9 @@ struct RenderState
   std::weak_ptr<RenderList> renderer{};
 
   QOffscreenSurface* surface{};
+
+  //! State owning the QRhi when it is shared with other outputs, if any.
+  std::shared_ptr<RenderState> shared{};
   QSize renderSize{};
   QSize outputSize{};
   int samples{1};
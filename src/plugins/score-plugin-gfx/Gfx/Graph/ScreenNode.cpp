@@ -37,13 +37,10 @@
 
 namespace score::gfx
 {
-static std::shared_ptr<RenderState>
-createRenderState(QWindow& window, GraphicsApi graphicsApi)
+// window is null for a QRhi shared between windows
+static void createRhi(RenderState& state, QWindow* window)
 {
-  auto st = std::make_shared<RenderState>();
-  RenderState& state = *st;
-  state.api = graphicsApi;
-  state.samples = score::AppContext().settings<Gfx::Settings::Model>().getSamples();
+  const GraphicsApi graphicsApi = state.api;
 
 #ifndef QT_NO_OPENGL
   if(graphicsApi == OpenGL)
@@ -51,15 +48,14 @@ createRenderState(QWindow& window, GraphicsApi graphicsApi)
     state.surface = QRhiGles2InitParams::newFallbackSurface();
     QRhiGles2InitParams params;
     params.fallbackSurface = state.surface;
-    params.window = &window;
+    params.window = window;
 
     score::GLCapabilities caps;
     caps.setupFormat(params.format);
     params.format.setSamples(state.samples);
     state.version = caps.qShaderVersion;
     state.rhi = QRhi::create(QRhi::OpenGLES2, &params, QRhi::EnableDebugMarkers);
-    state.renderSize = window.size();
-    return st;
+    return;
   }
 #endif
 
@@ -67,12 +63,11 @@ createRenderState(QWindow& window, GraphicsApi graphicsApi)
   if(graphicsApi == Vulkan)
   {
     QRhiVulkanInitParams params;
-    params.inst = window.vulkanInstance();
-    params.window = &window;
+    params.inst = window ? window->vulkanInstance() : staticVulkanInstance();
+    params.window = window;
     state.version = QShaderVersion(100);
     state.rhi = QRhi::create(QRhi::Vulkan, &params, QRhi::EnableDebugMarkers);
-    state.renderSize = window.size();
-    return st;
+    return;
   }
 #endif
 
@@ -90,8 +85,7 @@ createRenderState(QWindow& window, GraphicsApi graphicsApi)
     // }
     state.version = QShaderVersion(50);
     state.rhi = QRhi::create(QRhi::D3D11, &params, {});
-    state.renderSize = window.size();
-    return st;
+    return;
   }
 #endif
 
@@ -101,8 +95,7 @@ createRenderState(QWindow& window, GraphicsApi graphicsApi)
     QRhiMetalInitParams params;
     state.version = QShaderVersion(12);
     state.rhi = QRhi::create(QRhi::Metal, &params, {});
-    state.renderSize = window.size();
-    return st;
+    return;
   }
 #endif
 
@@ -113,11 +106,49 @@ createRenderState(QWindow& window, GraphicsApi graphicsApi)
     QRhiNullInitParams params;
     state.version = QShaderVersion(120);
     state.rhi = QRhi::create(QRhi::Null, &params, {});
-    state.renderSize = window.size();
     state.api = GraphicsApi::Null;
+  }
+}
+
+static std::shared_ptr<RenderState>
+createRenderState(QWindow& window, GraphicsApi graphicsApi, bool shared)
+{
+  auto st = std::make_shared<RenderState>();
+  RenderState& state = *st;
+  state.api = graphicsApi;
+  state.samples = score::AppContext().settings<Gfx::Settings::Model>().getSamples();
+  state.renderSize = window.size();
+
+  if(!shared)
+  {
+    createRhi(state, &window);
     return st;
   }
 
+  // All the windows then render with the same QRhi, so that the textures
+  // rendered for one of them can be sampled by the others.
+  static std::weak_ptr<RenderState> g_shared;
+  static GraphicsApi g_sharedApi{};
+  auto common = g_shared.lock();
+  if(!common || g_sharedApi != graphicsApi || common->samples != state.samples)
+  {
+    common.reset(new RenderState, [](RenderState* s) {
+      delete s->rhi;
+      delete s->surface;
+      delete s;
+    });
+    common->api = graphicsApi;
+    common->samples = state.samples;
+    createRhi(*common, nullptr);
+
+    g_shared = common;
+    g_sharedApi = graphicsApi;
+  }
+
+  state.rhi = common->rhi;
+  state.api = common->api;
+  state.version = common->version;
+  state.shared = std::move(common);
   return st;
 }
 
@@ -160,8 +191,10 @@ ScreenNode::~ScreenNode()
   {
     delete m_window->state->renderPassDescriptor;
     m_window->state->renderPassDescriptor = nullptr;
-    delete m_window->state->rhi;
+    if(!m_window->state->shared)
+      delete m_window->state->rhi;
     m_window->state->rhi = nullptr;
+    m_window->state->shared.reset();
   }
 }
 
@@ -180,8 +213,9 @@ void ScreenNode::startRendering()
     m_window->onRender = [this](QRhiCommandBuffer& commands) {
       if(auto r = m_window->state->renderer.lock())
       {
-        m_window->m_canRender = r->renderers.size() > 1;
-        r->render(commands);
+        const bool mirror = mirrorSource();
+        m_window->m_canRender = mirror || r->renderers.size() > 1;
+        r->render(commands, mirror);
       }
     };
   }
@@ -195,7 +229,7 @@ void ScreenNode::onRendererChange()
   {
     if(auto r = m_window->state->renderer.lock())
     {
-      m_window->m_canRender = r->renderers.size() > 1;
+      m_window->m_canRender = mirrorSource() || r->renderers.size() > 1;
     }
     else
     {
@@ -312,7 +346,9 @@ void ScreenNode::createOutput(
   });
   m_window->onUpdate = std::move(onUpdate);
   m_window->onWindowReady = [this, graphicsApi, onReady = std::move(onReady)] {
-    m_window->state = createRenderState(*m_window, graphicsApi);
+    const bool shared
+        = score::AppContext().settings<Gfx::Settings::Model>().getSharedRendering();
+    m_window->state = createRenderState(*m_window, graphicsApi, shared);
     m_window->state->renderSize = QSize(1280, 720);
     if(m_window->state->rhi)
     {
@@ -410,10 +446,16 @@ void ScreenNode::destroyOutput()
   m_swapChain = nullptr;
   m_window->m_swapChain = nullptr;
 
+  delete m_depthStencil;
+  m_depthStencil = nullptr;
+
   if(auto s = m_window->state)
   {
-    delete s->rhi;
+    // A shared QRhi is released along with the last window using it
+    if(!s->shared)
+      delete s->rhi;
     s->rhi = nullptr;
+    s->shared.reset();
 
     delete s->surface;
     s->surface = nullptr;
@@ -438,10 +480,10 @@ void ScreenNode::updateGraphicsAPI(GraphicsApi api)
   {
     if(this->m_window->state)
     {
-      const int samples
-          = score::AppContext().settings<Gfx::Settings::Model>().getSamples();
+      const auto& settings = score::AppContext().settings<Gfx::Settings::Model>();
 
-      if(this->m_window->state->samples != samples)
+      if(this->m_window->state->samples != settings.getSamples()
+         || bool(this->m_window->state->shared) != settings.getSharedRendering())
       {
         destroyOutput();
       }
@@ -449,6 +491,11 @@ void ScreenNode::updateGraphicsAPI(GraphicsApi api)
   }
 }
 
+bool ScreenNode::canMirror(const OutputNode& source) const noexcept
+{
+  return dynamic_cast<const ScreenNode*>(&source);
+}
+
 std::shared_ptr<score::gfx::RenderState> ScreenNode::renderState() const
 {
   if(m_window && m_window->m_swapChain)
@@ -504,6 +551,27 @@ public:
   {
     return m_inputTarget;
   }
+
+  QRhiTexture* renderedTexture() const noexcept override
+  {
+    return m_inputTarget.texture;
+  }
+
+  // Texture last rendered by the output we are mirroring, if it uses our QRhi
+  QRhiTexture* mirroredTexture(const RenderList& renderer) const noexcept
+  {
+    auto source = parent.mirrorSource();
+    auto list = source->renderer();
+    if(!list || list->state.rhi != renderer.state.rhi)
+      return nullptr;
+
+    auto it = source->renderedNodes.find(list);
+    if(it == source->renderedNodes.end())
+      return nullptr;
+
+    return static_cast<OutputNodeRenderer*>(it->second)->renderedTexture();
+  }
+
   ScaledRenderer(const RenderState& state, const ScreenNode& parent)
       : score::gfx::OutputNodeRenderer{}
       , parent{parent}
@@ -514,9 +582,15 @@ public:
 
   void init(RenderList& renderer, QRhiResourceUpdateBatch& res) override
   {
-    m_inputTarget = score::gfx::createRenderTarget(
-        renderer.state, QRhiTexture::Format::RGBA8, renderer.state.renderSize,
-        renderer.samples());
+    // Mirrors sample the texture of their source instead, see finishFrame
+    QRhiTexture* texture = &renderer.emptyTexture();
+    if(!parent.mirrorSource())
+    {
+      m_inputTarget = score::gfx::createRenderTarget(
+          renderer.state, QRhiTexture::Format::RGBA8, renderer.state.renderSize,
+          renderer.samples());
+      texture = m_inputTarget.texture;
+    }
 
     const auto& mesh = renderer.defaultTriangle();
     m_mesh = renderer.initMeshBuffer(mesh, res);
@@ -546,7 +620,7 @@ public:
       sampler->create();
 #include <Gfx/Qt5CompatPop>
 
-      m_samplers.push_back({sampler, this->m_inputTarget.texture});
+      m_samplers.push_back({sampler, texture});
     }
 
     m_renderTarget.renderTarget = parent.m_swapChain->currentFrameRenderTarget();
@@ -567,7 +641,19 @@ public:
 
   void finishFrame(score::gfx::RenderList& renderer, QRhiCommandBuffer& cb) override
   {
+    QRhiTexture* texture = m_samplers[0].texture;
+    if(parent.mirrorSource())
+    {
+      texture = mirroredTexture(renderer);
+      if(texture && texture != m_samplers[0].texture)
+      {
+        m_samplers[0].texture = texture;
+        score::gfx::replaceTexture(*m_p.srb, 3, texture);
+      }
+    }
+
     cb.beginPass(m_renderTarget.renderTarget, Qt::black, {1.0f, 0}, nullptr);
+    if(texture)
     {
       const auto sz = renderer.state.outputSize;
 
@@ -584,7 +670,7 @@ public:
   void release(RenderList&) override
   {
     m_p.release();
-    delete m_inputTarget.texture;
+    m_inputTarget.release();
     for(auto& s : m_samplers)
     {
       delete s.sampler;
@@ -35,6 +35,8 @@ struct SCORE_PLUGIN_GFX_EXPORT ScreenNode : OutputNode
   void destroyOutput() override;
   void updateGraphicsAPI(GraphicsApi) override;
 
+  bool canMirror(const OutputNode& source) const noexcept override;
+
   std::shared_ptr<RenderState> renderState() const override;
   score::gfx::OutputNodeRenderer* createRenderer(RenderList& r) const noexcept override;
   Configuration configuration() const noexcept override;
@@ -3,12 +3,23 @@
 #include <Gfx/Graph/RenderState.hpp>
 #include <Gfx/Graph/TextNode.hpp>
 
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/detail/hash_map.hpp>
 #include <ossia/detail/math.hpp>
 #include <ossia/gfx/port_index.hpp>
 #include <ossia/network/value/value.hpp>
 #include <ossia/network/value/value_conversion.hpp>
 
-#include <QPainter>
+#include <QGlyphRun>
+#include <QHash>
+#include <QPainterPath>
+#include <QRawFont>
+#include <QTextLayout>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <optional>
 
 namespace score::gfx
 {
@@ -17,8 +28,14 @@ static const constexpr auto text_vertex_shader = R"_(#version 450
 layout(location = 0) in vec2 position;
 layout(location = 1) in vec2 texcoord;
 
-layout(binding = 3) uniform sampler2D y_tex;
+// Per-instance data
+layout(location = 2) in vec4 rect;
+layout(location = 3) in vec4 uv;
+layout(location = 4) in vec4 transform;
+layout(location = 5) in vec4 color;
+
 layout(location = 0) out vec2 v_texcoord;
+layout(location = 1) out vec4 v_color;
 
 layout(std140, binding = 0) uniform renderer_t {
   mat4 clipSpaceCorrMatrix;
@@ -26,43 +43,37 @@ layout(std140, binding = 0) uniform renderer_t {
   vec2 renderSize;
 };
 
-layout(std140, binding = 2) uniform material_t {
-  float opacity;
-  vec2 position;
-  vec2 scale;
-} mat;
 out gl_PerVertex { vec4 gl_Position; };
 
 void main()
 {
-  v_texcoord = texcoord;
-  gl_Position = clipSpaceCorrMatrix * vec4(mat.position + mat.scale * position, 0.0, 1.);
+  // Position of the glyph in its frame, with y going downwards
+  vec2 frame = mix(rect.xy, rect.zw, texcoord);
+  vec2 local = vec2(2. * frame.x - 1., 1. - 2. * frame.y);
+
+  v_texcoord = mix(uv.xy, uv.zw, texcoord);
+  v_color = color;
+  gl_Position = clipSpaceCorrMatrix * vec4(transform.xy + transform.zw * local, 0.0, 1.);
 }
 )_";
 
 static const constexpr auto text_fragment_shader = R"_(#version 450
-layout(std140, binding = 0) uniform renderer_t {
-  mat4 clipSpaceCorrMatrix;
-  vec2 texcoordAdjust;
-  vec2 renderSize;
-};
-
-layout(std140, binding = 2) uniform material_t {
-  float opacity;
-  vec2 position;
-  vec2 scale;
-} mat;
-
-layout(binding=3) uniform sampler2D y_tex;
+layout(binding = 3) uniform sampler2D atlas;
 
 layout(location = 0) in vec2 v_texcoord;
+layout(location = 1) in vec4 v_color;
 layout(location = 0) out vec4 fragColor;
 
 void main ()
 {
-  fragColor = texture(y_tex, v_texcoord) * mat.opacity;
+  // The atlas stores signed distances to the outline, 0.5 being the edge:
+  // antialias over the size of a pixel, whatever the scale.
+  float dist = texture(atlas, v_texcoord).r;
+  float w = max(fwidth(dist), 1e-4) * 0.7;
+  fragColor = v_color * smoothstep(0.5 - w, 0.5 + w, dist);
 }
 )_";
+
 TextNode::TextNode()
 {
   // FIXME why are the others missing ?????
@@ -80,118 +91,670 @@ TextNode::~TextNode()
 }
 
 #include <Gfx/Qt5CompatPush> // clang-format: keep
-class TextNode::Renderer : public GenericNodeRenderer
+namespace
 {
-public:
-  using GenericNodeRenderer::GenericNodeRenderer;
+//! Per-instance vertex data of a glyph quad
+struct TextInstance
+{
+  //! Area covered by the glyph in the frame, normalized
+  float rect[4];
+  //! Area of the glyph in the atlas, normalized
+  float uv[4];
+  //! Position and scale set by the user
+  float transform[4];
+  //! Premultiplied color
+  float color[4];
+};
 
-private:
-  ~Renderer() { }
+/**
+ * @brief The default quad, with an additional per-instance vertex input.
+ */
+struct TextInstancedQuad final : TexturedMesh
+{
+  TextInstancedQuad()
+      : TexturedMesh{TexturedQuad::flipped_y_data, 4}
+  {
+    vertexBindings.push_back(
+        {sizeof(TextInstance), QRhiVertexInputBinding::PerInstance});
+    vertexAttributes.push_back(
+        {2, 2, QRhiVertexInputAttribute::Float4, offsetof(TextInstance, rect)});
+    vertexAttributes.push_back(
+        {2, 3, QRhiVertexInputAttribute::Float4, offsetof(TextInstance, uv)});
+    vertexAttributes.push_back(
+        {2, 4, QRhiVertexInputAttribute::Float4, offsetof(TextInstance, transform)});
+    vertexAttributes.push_back(
+        {2, 5, QRhiVertexInputAttribute::Float4, offsetof(TextInstance, color)});
+  }
 
-  TextureRenderTarget renderTargetForInput(const Port& p) override { return {}; }
+  static const TextInstancedQuad& instance() noexcept
+  {
+    static const TextInstancedQuad q;
+    return q;
+  }
 
-  // TODO
-  QSize sz{1920, 1080};
-  void rerender()
+  void
+  setupBindings(const MeshBuffers& bufs, QRhiCommandBuffer& cb) const noexcept override
+  {
+    const QRhiCommandBuffer::VertexInput bindings[]
+        = {{bufs.mesh, 0}, {bufs.mesh, 4 * 2 * sizeof(float)}};
+
+    cb.setVertexInput(0, 2, bindings);
+  }
+
+  void draw(
+      const MeshBuffers& bufs, QRhiBuffer& instances, int firstInstance,
+      int instanceCount, QRhiCommandBuffer& cb) const noexcept
   {
-    auto& n = static_cast<const TextNode&>(this->node);
+    const QRhiCommandBuffer::VertexInput bindings[]
+        = {{bufs.mesh, 0},
+           {bufs.mesh, 4 * 2 * sizeof(float)},
+           {&instances, quint32(firstInstance * sizeof(TextInstance))}};
 
-    if(m_img.size().isNull())
-      m_img = QImage(sz, QImage::Format::Format_ARGB32_Premultiplied);
-    m_img.fill(Qt::transparent);
+    cb.setVertexInput(0, 3, bindings);
+    cb.draw(vertexCount, instanceCount);
+  }
+};
+
+/**
+ * @brief Computes the signed distance field of a glyph outline.
+ *
+ * Distances are exact: they are measured to the segments of the flattened
+ * outline, and the sign comes from the non-zero winding rule used by fonts.
+ * They are mapped from [-spread; spread] to [0; 255], the edge being at 128.
+ */
+QByteArray signedDistanceField(const QPainterPath& path, QRect bounds, int spread)
+{
+  const auto polygons = path.toSubpathPolygons();
+  const int w = bounds.width(), h = bounds.height();
+  QByteArray res(w * h, 0);
+
+  for(int y = 0; y < h; y++)
+  {
+    for(int x = 0; x < w; x++)
     {
-      QPainter p{&m_img};
-      p.setRenderHint(QPainter::Antialiasing, true);
-      p.setRenderHint(QPainter::TextAntialiasing, true);
+      const double px = bounds.left() + x + 0.5, py = bounds.top() + y + 0.5;
+      double minDist = spread * spread;
+      int winding = 0;
+      for(const QPolygonF& poly : polygons)
+      {
+        const int n = poly.size();
+        for(int i = 0; i < n; i++)
+        {
+          const QPointF a = poly[i], b = poly[(i + 1) % n];
+
+          // Distance to the segment
+          const double dx = b.x() - a.x(), dy = b.y() - a.y();
+          const double len = dx * dx + dy * dy;
+          double t = len > 0. ? ((px - a.x()) * dx + (py - a.y()) * dy) / len : 0.;
+          t = std::clamp(t, 0., 1.);
+          const double ex = a.x() + t * dx - px, ey = a.y() + t * dy - py;
+          minDist = std::min(minDist, ex * ex + ey * ey);
+
+          // Winding number
+          const double side = dx * (py - a.y()) - dy * (px - a.x());
+          if(a.y() <= py)
+          {
+            if(b.y() > py && side > 0.)
+              winding++;
+          }
+          else if(b.y() <= py && side < 0.)
+          {
+            winding--;
+          }
+        }
+      }
 
-      p.setFont(n.font);
-      p.setPen(n.pen);
-      p.drawText(10, 10, sz.width() - 20, sz.height() - 20, 0, n.text);
+      const double dist = (winding != 0 ? 1. : -1.) * std::sqrt(minDist);
+      const double v = 0.5 + 0.5 * dist / spread;
+      res[y * w + x] = char(uint8_t(std::clamp(v * 255. + 0.5, 0., 255.)));
     }
+  }
+  return res;
+}
+}
+
+/**
+ * @brief Resources shared by the text renderers of a RenderList.
+ *
+ * The glyphs of every text node are rendered once, as signed distance fields
+ * at a fixed size, in a common atlas allocated in rows: they stay sharp at any
+ * scale, and changing a text only updates the glyph quads of its node.
+ * When the atlas is full it is grown, and the cached glyphs uploaded again.
+ *
+ * Every frame, each batch of consecutive text renderers appends its glyph
+ * instances to a common instance buffer, and draws them in one call.
+ */
+class TextNode::Batch final : public RenderListResource
+{
+public:
+  //! Size of the em square in which glyphs are rendered
+  static constexpr int baseSize = 64;
+  //! Range of the distances stored around the outline, in pixels
+  static constexpr int spread = 8;
+  static constexpr int padding = 1;
+
+  struct Glyph
+  {
+    //! Distance field, one byte per pixel
+    QByteArray sdf;
+    //! Top-left of the distance field relative to the glyph origin
+    QPoint offset;
+    QSize size;
+    //! Area in the atlas
+    QRect area;
+  };
+
+  QRhi* rhi{};
+  QRhiTexture* atlas{};
+  QRhiTexture::Format atlasFormat{QRhiTexture::R8};
+  QRhiSampler* sampler{};
+  QRhiBuffer* instances{};
+  QRhiShaderResourceBindings* srb{};
+  MeshBuffers meshbufs{};
+  std::pair<QShader, QShader> shaders;
+  ossia::flat_map<QRhiRenderPassDescriptor*, QRhiGraphicsPipeline*> pipelines;
+
+  std::vector<Renderer*> members;
+  std::vector<TextInstance> scratch;
+
+  // Cached glyphs, indexed by face and glyph index
+  std::vector<Glyph> glyphs;
+  ossia::hash_map<uint64_t, int> glyphIndex;
+  QHash<QString, int> faces;
+
+  QSize atlasSize{};
+  int maxAtlasSize{};
+  QPoint cursor{};
+  int rowHeight{};
+
+  int instanceCapacity{};
+  int instanceCount{};
+
+  void init(RenderList& renderer, QRhiResourceUpdateBatch& res);
+  void update(RenderList& renderer, QRhiResourceUpdateBatch& res) override;
+  void release(RenderList& renderer) override;
+
+  QRhiGraphicsPipeline* pipeline(RenderList& renderer, const Edge& edge);
+
+  //! Lay out the text of a renderer, and render its missing glyphs
+  void layout(Renderer& r, QRhiResourceUpdateBatch& res);
+
+  //! Append instances for this frame, returns the index of the first one
+  int push(QRhiResourceUpdateBatch& res, tcb::span<const TextInstance> data);
 
-    m_uploaded = false;
+private:
+  int glyph(const QRawFont& font, quint32 index, QRhiResourceUpdateBatch& res);
+  std::optional<QRect> allocate(QSize sz);
+  bool repack(QRhiResourceUpdateBatch& res);
+  void createAtlas();
+  void uploadGlyph(const Glyph& g, QRhiResourceUpdateBatch& res);
+};
+
+class TextNode::Renderer : public NodeRenderer
+{
+public:
+  explicit Renderer(const TextNode& node) noexcept
+      : node{node}
+  {
   }
 
+  const TextNode& node;
+
+  // Size of the frame in which the text is laid out
+  QSize sz{1920, 1080};
+
+  struct PlacedGlyph
+  {
+    int glyph{};
+    //! Area covered by the glyph in the frame, normalized
+    float rect[4];
+  };
+  std::vector<PlacedGlyph> m_glyphs;
+
+  Batch* m_batch{};
+  QRhiGraphicsPipeline* m_pipeline{};
+  int m_firstInstance{};
+  int m_instanceCount{};
+  int64_t m_textChangedIndex{-1};
+
+private:
+  ~Renderer() { }
+
+  TextureRenderTarget renderTargetForInput(const Port& p) override { return {}; }
+
   void init(RenderList& renderer, QRhiResourceUpdateBatch& res) override
   {
-    rerender();
-    const auto& mesh = renderer.defaultQuad();
-    defaultMeshInit(renderer, mesh, res);
-    processUBOInit(renderer);
-    m_material.init(renderer, node.input, m_samplers);
-    std::tie(m_vertexS, m_fragmentS) = score::gfx::makeShaders(
-        renderer.state, text_vertex_shader, text_fragment_shader);
+    m_batch = &renderer.sharedResource<Batch>();
+    m_batch->init(renderer, res);
+    m_batch->members.push_back(this);
 
-    QRhi& rhi = *renderer.state.rhi;
+    m_textChangedIndex = -1;
+    m_glyphs.clear();
+  }
 
-    {
-      auto tex = rhi.newTexture(QRhiTexture::BGRA8, sz, 1, QRhiTexture::Flag{});
+  // The text is laid out by the batch, which is updated first
+  void update(RenderList& renderer, QRhiResourceUpdateBatch& res) override { }
 
-      tex->setName("TextNode::tex");
-      tex->create();
-      m_textures.push_back({{}, tex});
-    }
+  const void* batchKey() const noexcept override { return m_batch; }
+
+  void instances(std::vector<TextInstance>& out) const noexcept
+  {
+    const float aw = m_batch->atlasSize.width(), ah = m_batch->atlasSize.height();
+    const auto& ubo = node.ubo;
+    const QColor c = node.pen.color();
+    const float alpha = c.alphaF() * ubo.opacity;
+    const float r = c.redF() * alpha, g = c.greenF() * alpha, b = c.blueF() * alpha;
 
-    // Create the sampler in which we are going to put the texture
+    for(const PlacedGlyph& p : m_glyphs)
     {
-      auto sampler = rhi.newSampler(
-          QRhiSampler::Linear, QRhiSampler::Linear, QRhiSampler::None,
-          QRhiSampler::ClampToEdge, QRhiSampler::ClampToEdge);
-
-      sampler->setName("TextNode::sampler");
-      sampler->create();
-      auto tex
-          = m_textures.empty() ? &renderer.emptyTexture() : m_textures.front().second;
-      m_samplers.push_back({sampler, tex});
+      const QRect& a = m_batch->glyphs[p.glyph].area;
+      out.push_back(TextInstance{
+          {p.rect[0], p.rect[1], p.rect[2], p.rect[3]},
+          {a.left() / aw, a.top() / ah, (a.left() + a.width()) / aw,
+           (a.top() + a.height()) / ah},
+          {ubo.position[0], ubo.position[1], ubo.scale[0], ubo.scale[1]},
+          {r, g, b, alpha}});
     }
+  }
 
-    defaultPassesInit(renderer, mesh);
+  void runInitialPasses(
+      RenderList& renderer, QRhiCommandBuffer& cb, QRhiResourceUpdateBatch*& res,
+      Edge& edge) override
+  {
+    RenderedEdge self{&edge, this};
+    runBatchedInitialPasses(renderer, cb, res, {&self, 1});
   }
 
-  void update(RenderList& renderer, QRhiResourceUpdateBatch& res) override
+  void runRenderPass(RenderList& renderer, QRhiCommandBuffer& cb, Edge& edge) override
   {
-    defaultUBOUpdate(renderer, res);
+    RenderedEdge self{&edge, this};
+    runBatchedRenderPass(renderer, cb, {&self, 1});
+  }
 
-    if(m_textures.empty())
+  void runBatchedInitialPasses(
+      RenderList& renderer, QRhiCommandBuffer& cb, QRhiResourceUpdateBatch*& res,
+      tcb::span<RenderedEdge> batch) override
+  {
+    m_instanceCount = 0;
+    if(!m_batch || !res)
       return;
 
-    // If images haven't been uploaded yet, upload them.
+    m_pipeline = m_batch->pipeline(renderer, *batch.front().edge);
+    if(!m_pipeline)
+      return;
+
+    auto& data = m_batch->scratch;
+    data.clear();
+    for(auto [edge, r] : batch)
+      static_cast<Renderer*>(r)->instances(data);
+
+    m_firstInstance = m_batch->push(*res, data);
+    m_instanceCount = std::min(
+        int(data.size()), m_batch->instanceCapacity - m_firstInstance);
+  }
+
+  void runBatchedRenderPass(
+      RenderList& renderer, QRhiCommandBuffer& cb,
+      tcb::span<RenderedEdge> batch) override
+  {
+    if(m_instanceCount <= 0 || !m_pipeline)
+      return;
+
+    const auto sz = renderer.state.renderSize;
+    cb.setGraphicsPipeline(m_pipeline);
+    cb.setShaderResources(m_batch->srb);
+    cb.setViewport(QRhiViewport(0, 0, sz.width(), sz.height()));
+
+    TextInstancedQuad::instance().draw(
+        m_batch->meshbufs, *m_batch->instances, m_firstInstance, m_instanceCount, cb);
+  }
 
-    auto& n = static_cast<const TextNode&>(this->node);
-    if(n.mustRerender)
+  void release(RenderList& r) override
+  {
+    if(m_batch)
     {
-      rerender();
+      ossia::remove_erase(m_batch->members, this);
+      m_batch = nullptr;
     }
+    m_pipeline = nullptr;
+    m_glyphs.clear();
+  }
+};
 
-    if(!m_uploaded)
-    {
-      res.uploadTexture(m_textures[0].second, m_img);
+void TextNode::Batch::init(RenderList& renderer, QRhiResourceUpdateBatch& res)
+{
+  if(atlas)
+    return;
+
+  rhi = renderer.state.rhi;
+
+  // Single-channel distance field, unless the backend cannot sample it
+  atlasFormat = rhi->isTextureFormatSupported(QRhiTexture::R8) ? QRhiTexture::R8
+                                                               : QRhiTexture::RGBA8;
+  maxAtlasSize = rhi->resourceLimit(QRhi::ResourceLimit::TextureSizeMax);
+  atlasSize = QSize{std::min(1024, maxAtlasSize), std::min(1024, maxAtlasSize)};
+  createAtlas();
+
+  sampler = rhi->newSampler(
+      QRhiSampler::Linear, QRhiSampler::Linear, QRhiSampler::None,
+      QRhiSampler::ClampToEdge, QRhiSampler::ClampToEdge);
+  sampler->setName("TextNode::Batch::sampler");
+  sampler->create();
+
+  const auto bindingStages
+      = QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage;
+  srb = rhi->newShaderResourceBindings();
+  srb->setBindings(
+      {QRhiShaderResourceBinding::uniformBuffer(0, bindingStages, &renderer.outputUBO()),
+       QRhiShaderResourceBinding::sampledTexture(3, bindingStages, atlas, sampler)});
+  srb->create();
+
+  meshbufs = renderer.initMeshBuffer(TextInstancedQuad::instance(), res);
+  shaders = score::gfx::makeShaders(
+      renderer.state, text_vertex_shader, text_fragment_shader);
+}
+
+void TextNode::Batch::createAtlas()
+{
+  cursor = {};
+  rowHeight = 0;
+
+  if(atlas)
+    atlas->deleteLater();
+  atlas = rhi->newTexture(atlasFormat, atlasSize, 1, QRhiTexture::Flag{});
+  atlas->setName("TextNode::Batch::atlas");
+  atlas->create();
+
+  if(srb)
+  {
+    replaceTexture(*srb, 3, atlas);
+  }
+}
 
-      m_uploaded = true;
+void TextNode::Batch::update(RenderList& renderer, QRhiResourceUpdateBatch& res)
+{
+  // Texts are laid out before the renderers are updated, so that the instance
+  // buffer can be sized for this frame.
+  // A text node outputs its glyphs once per edge.
+  int required = 0;
+  for(auto r : members)
+  {
+    if(r->node.hasTextChanged(r->m_textChangedIndex))
+      layout(*r, res);
+    required += r->m_glyphs.size() * r->node.output[0]->edges.size();
+  }
+  required = std::max(required, 1);
+
+  if(required > instanceCapacity)
+  {
+    instanceCapacity = std::max(required, 2 * instanceCapacity);
+    if(!instances)
+    {
+      instances = renderer.state.rhi->newBuffer(
+          QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer,
+          instanceCapacity * sizeof(TextInstance));
+      instances->setName("TextNode::Batch::instances");
+    }
+    else
+    {
+      instances->setSize(instanceCapacity * sizeof(TextInstance));
     }
+    instances->create();
   }
 
-  void runRenderPass(RenderList& renderer, QRhiCommandBuffer& cb, Edge& edge) override
+  instanceCount = 0;
+}
+
+void TextNode::Batch::release(RenderList& renderer)
+{
+  for(auto& [rp, pip] : pipelines)
+    delete pip;
+  pipelines.clear();
+
+  delete srb;
+  srb = nullptr;
+  delete instances;
+  instances = nullptr;
+  delete sampler;
+  sampler = nullptr;
+  delete atlas;
+  atlas = nullptr;
+
+  // Owned by the RenderList
+  meshbufs = {};
+  rhi = nullptr;
+
+  members.clear();
+  glyphs.clear();
+  glyphIndex.clear();
+  faces.clear();
+  instanceCapacity = 0;
+  instanceCount = 0;
+}
+
+QRhiGraphicsPipeline*
+TextNode::Batch::pipeline(RenderList& renderer, const Edge& edge)
+{
+  auto rt = renderer.renderTargetForOutput(edge);
+  if(!rt.renderPass)
+    return nullptr;
+
+  if(auto it = pipelines.find(rt.renderPass); it != pipelines.end())
+    return it->second;
+
+  auto pip = score::gfx::buildPipeline(
+      renderer, TextInstancedQuad::instance(), shaders.first, shaders.second, rt, srb);
+  pipelines[rt.renderPass] = pip.pipeline;
+  return pip.pipeline;
+}
+
+int TextNode::Batch::push(
+    QRhiResourceUpdateBatch& res, tcb::span<const TextInstance> data)
+{
+  const int first = instanceCount;
+  const int count = std::min(int(data.size()), instanceCapacity - first);
+  if(count > 0)
   {
-    const auto& mesh = renderer.defaultQuad();
-    defaultRenderPass(renderer, mesh, cb, edge);
+    res.updateDynamicBuffer(
+        instances, first * sizeof(TextInstance), count * sizeof(TextInstance),
+        data.data());
+    instanceCount += count;
   }
+  return first;
+}
 
-  void release(RenderList& r) override
+void TextNode::Batch::layout(Renderer& r, QRhiResourceUpdateBatch& res)
+{
+  r.m_glyphs.clear();
+
+  QString text = r.node.text;
+  if(text.isEmpty())
+    return;
+  text.replace(QLatin1Char('\n'), QChar::LineSeparator);
+
+  const QRectF frame{10., 10., r.sz.width() - 20., r.sz.height() - 20.};
+  const float fw = r.sz.width(), fh = r.sz.height();
+
+  QTextLayout layout{text, r.node.font};
+  QTextOption opt;
+  opt.setWrapMode(QTextOption::NoWrap);
+  layout.setTextOption(opt);
+
+  layout.beginLayout();
+  qreal y = 0.;
+  for(QTextLine line = layout.createLine(); line.isValid(); line = layout.createLine())
   {
-    for(auto tex : m_textures)
+    line.setLineWidth(frame.width());
+    line.setPosition({0., y});
+    y += line.height();
+  }
+  layout.endLayout();
+
+  for(const QGlyphRun& run : layout.glyphRuns())
+  {
+    const QRawFont font = run.rawFont();
+    const double scale = font.pixelSize() / double(baseSize);
+    const auto indexes = run.glyphIndexes();
+    const auto positions = run.positions();
+
+    for(int i = 0, n = indexes.size(); i < n; i++)
     {
-      tex.second->deleteLater();
+      const int g = glyph(font, indexes[i], res);
+      if(g < 0)
+        continue;
+
+      const Glyph& gl = glyphs[g];
+      const QPointF origin = frame.topLeft() + positions[i];
+      const double x0 = origin.x() + gl.offset.x() * scale;
+      const double y0 = origin.y() + gl.offset.y() * scale;
+      const double x1 = x0 + gl.size.width() * scale;
+      const double y1 = y0 + gl.size.height() * scale;
+      if(x1 <= 0. || y1 <= 0. || x0 >= fw || y0 >= fh)
+        continue;
+
+      r.m_glyphs.push_back({g, {float(x0 / fw), float(y0 / fh), float(x1 / fw),
+                                float(y1 / fh)}});
     }
-    m_textures.clear();
+  }
+}
 
-    defaultRelease(r);
+int TextNode::Batch::glyph(
+    const QRawFont& font, quint32 index, QRhiResourceUpdateBatch& res)
+{
+  const QString faceKey = font.familyName() + QLatin1Char('\n') + font.styleName()
+                          + QLatin1Char('\n') + QString::number(font.weight())
+                          + QString::number(int(font.style()));
+  auto face_it = faces.find(faceKey);
+  if(face_it == faces.end())
+    face_it = faces.insert(faceKey, faces.size());
+
+  const uint64_t key = (uint64_t(*face_it) << 32) | index;
+  if(auto it = glyphIndex.find(key); it != glyphIndex.end())
+    return it->second;
+
+  // Render the outline at the base size
+  QRawFont base = font;
+  base.setPixelSize(baseSize);
+  const QPainterPath path = base.pathForGlyph(index);
+
+  int res_index = -1;
+  if(!path.isEmpty())
+  {
+    QRect bounds = path.boundingRect().toAlignedRect().adjusted(
+        -spread, -spread, spread, spread);
+    // Keep the rows of the uploaded data 4-byte aligned
+    bounds.setWidth((bounds.width() + 3) & ~3);
+
+    Glyph g;
+    g.sdf = signedDistanceField(path, bounds, spread);
+    g.offset = bounds.topLeft();
+    g.size = bounds.size();
+
+    if(auto area = allocate(g.size))
+    {
+      g.area = *area;
+      uploadGlyph(g, res);
+      res_index = glyphs.size();
+      glyphs.push_back(std::move(g));
+    }
+    else
+    {
+      res_index = glyphs.size();
+      glyphs.push_back(std::move(g));
+
+      // The atlas is full: grow it and upload everything again
+      while(!repack(res))
+      {
+        if(atlasSize.width() >= maxAtlasSize)
+        {
+          qDebug() << "TextNode: the glyph atlas is full";
+          glyphs.pop_back();
+          res_index = -1;
+          repack(res);
+          break;
+        }
+
+        atlasSize = QSize{
+            std::min(2 * atlasSize.width(), maxAtlasSize),
+            std::min(2 * atlasSize.height(), maxAtlasSize)};
+        createAtlas();
+      }
+    }
   }
 
-  QImage m_img;
-  std::vector<std::pair<score::gfx::Edge*, QRhiTexture*>> m_textures;
-  bool m_uploaded = false;
-};
+  // Whitespace and missing glyphs are cached too, as -1
+  glyphIndex[key] = res_index;
+  return res_index;
+}
+
+std::optional<QRect> TextNode::Batch::allocate(QSize sz)
+{
+  const int w = sz.width() + padding, h = sz.height() + padding;
+  if(w > atlasSize.width() || h > atlasSize.height())
+    return std::nullopt;
+
+  if(cursor.x() + w > atlasSize.width())
+  {
+    // Next row
+    cursor = QPoint{0, cursor.y() + rowHeight};
+    rowHeight = 0;
+  }
+
+  if(cursor.y() + h > atlasSize.height())
+    return std::nullopt;
+
+  QRect area{cursor, sz};
+  cursor.rx() += w;
+  rowHeight = std::max(rowHeight, h);
+  return area;
+}
+
+void TextNode::Batch::uploadGlyph(const Glyph& g, QRhiResourceUpdateBatch& res)
+{
+  QRhiTextureSubresourceUploadDescription sub;
+  if(atlasFormat == QRhiTexture::R8)
+  {
+    sub = QRhiTextureSubresourceUploadDescription{
+        g.sdf.constData(), quint32(g.sdf.size())};
+  }
+  else
+  {
+    QByteArray rgba(g.sdf.size() * 4, 0);
+    for(int i = 0; i < g.sdf.size(); i++)
+      std::fill_n(rgba.data() + 4 * i, 4, g.sdf[i]);
+    sub = QRhiTextureSubresourceUploadDescription{rgba};
+  }
+  sub.setSourceSize(g.size);
+  sub.setDestinationTopLeft(g.area.topLeft());
+  res.uploadTexture(atlas, QRhiTextureUploadDescription{{0, 0, sub}});
+}
+
+bool TextNode::Batch::repack(QRhiResourceUpdateBatch& res)
+{
+  cursor = {};
+  rowHeight = 0;
+
+  // Tallest glyphs first so that the rows are filled better
+  std::vector<Glyph*> sorted;
+  sorted.reserve(glyphs.size());
+  for(auto& g : glyphs)
+    sorted.push_back(&g);
+  std::sort(sorted.begin(), sorted.end(), [](Glyph* lhs, Glyph* rhs) {
+    return lhs->size.height() > rhs->size.height();
+  });
+
+  for(auto g : sorted)
+  {
+    auto area = allocate(g->size);
+    if(!area)
+      return false;
+    g->area = *area;
+  }
+
+  for(auto& g : glyphs)
+    uploadGlyph(g, res);
+  return true;
+}
 #include <Gfx/Qt5CompatPop> // clang-format: keep
 
 NodeRenderer* TextNode::createRenderer(RenderList& r) const noexcept
@@ -214,7 +777,7 @@ void TextNode::process(Message&& msg)
           // Text
           {
             text = QString::fromStdString(ossia::convert<std::string>(*val));
-            mustRerender = true;
+            textChange();
           }
           break;
         }
@@ -222,7 +785,7 @@ void TextNode::process(Message&& msg)
           // Font
           {
             font.setFamily(QString::fromStdString(ossia::convert<std::string>(*val)));
-            mustRerender = true;
+            textChange();
           }
           break;
         }
@@ -230,7 +793,7 @@ void TextNode::process(Message&& msg)
           // Point size
           {
             font.setPointSizeF(ossia::convert<float>(*val));
-            mustRerender = true;
+            textChange();
           }
           break;
         }
@@ -275,7 +838,7 @@ void TextNode::process(Message&& msg)
           {
             auto rgba = ossia::convert<ossia::vec4f>(*val);
             pen.setColor(QColor::fromRgbF(rgba[0], rgba[1], rgba[2], rgba[3]));
-            mustRerender = true;
+            textChange();
           }
           break;
         }
@@ -9,6 +9,10 @@ namespace score::gfx
 {
 /**
  * @brief A node that renders text to screen.
+ *
+ * The text nodes of a render list are drawn together: their glyphs are rendered
+ * once as signed distance fields in a shared atlas, and drawn as instanced quads
+ * with a single draw call.
  */
 struct TextNode : NodeModel
 {
@@ -20,6 +24,7 @@ public:
 
   void process(Message&& msg) override;
   class Renderer;
+  class Batch;
 
 #pragma pack(push, 1)
   struct UBO
@@ -35,7 +40,21 @@ public:
   QFont font;
   QPen pen;
 
-  std::atomic_bool mustRerender{true};
+  /**
+   * @brief Used to notify a change of text, font or color to the renderers.
+   */
+  void textChange() noexcept { textChanged.fetch_add(1, std::memory_order_release); }
+  bool hasTextChanged(int64_t& renderer) const noexcept
+  {
+    int64_t res = textChanged.load(std::memory_order_acquire);
+    if(renderer != res)
+    {
+      renderer = res;
+      return true;
+    }
+    return false;
+  }
+  std::atomic_int64_t textChanged{0};
 
 private:
 };
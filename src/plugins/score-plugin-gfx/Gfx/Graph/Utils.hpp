@@ -207,6 +207,15 @@ QRhiShaderResourceBindings* createDefaultBindings(
     const RenderList& renderer, const TextureRenderTarget& rt, QRhiBuffer* processUBO,
     QRhiBuffer* materialUBO, const std::vector<Sampler>& samplers);
 
+/**
+ * @brief Create a render pipeline with existing resource bindings.
+ */
+SCORE_PLUGIN_GFX_EXPORT
+Pipeline buildPipeline(
+    const RenderList& renderer, const Mesh& mesh, const QShader& vertexS,
+    const QShader& fragmentS, const TextureRenderTarget& rt,
+    QRhiShaderResourceBindings* srb);
+
 /**
  * @brief Create a render pipeline following the score conventions for shaders and materials.
  */
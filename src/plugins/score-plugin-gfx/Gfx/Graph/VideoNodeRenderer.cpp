@@ -1,9 +1,12 @@
 #include <Gfx/Graph/VideoNodeRenderer.hpp>
+#include <Gfx/Graph/decoders/GBRP.hpp>
 #include <Gfx/Graph/decoders/GPUVideoDecoder.hpp>
 #include <Gfx/Graph/decoders/HAP.hpp>
+#include <Gfx/Graph/decoders/NV12.hpp>
 #include <Gfx/Graph/decoders/RGBA.hpp>
 #include <Gfx/Graph/decoders/YUV420.hpp>
 #include <Gfx/Graph/decoders/YUV422.hpp>
+#include <Gfx/Graph/decoders/YUVPlanar.hpp>
 #include <Gfx/Graph/decoders/YUYV422.hpp>
 
 #include <score/tools/Debug.hpp>
@@ -106,6 +109,93 @@ void VideoNodeRenderer::createGpuDecoder()
           QRhiTexture::R16, 2, this->decoder(),
           "processed.rgba = vec4(tex.r, tex.r, tex.r, 1.0);" + filter);
       break;
+
+    case AV_PIX_FMT_NV12:
+      m_gpu = std::make_unique<NV12Decoder>(this->decoder(), false);
+      break;
+    case AV_PIX_FMT_NV21:
+      m_gpu = std::make_unique<NV12Decoder>(this->decoder(), false, true);
+      break;
+    case AV_PIX_FMT_P010:
+      m_gpu = std::make_unique<NV12Decoder>(this->decoder(), true);
+      break;
+
+    case AV_PIX_FMT_YUV444P:
+    case AV_PIX_FMT_YUVJ444P:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 0, 0, 8, false);
+      break;
+    case AV_PIX_FMT_YUV420P10:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 1, 1, 10, false);
+      break;
+    case AV_PIX_FMT_YUV422P10:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 1, 0, 10, false);
+      break;
+    case AV_PIX_FMT_YUV444P10:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 0, 0, 10, false);
+      break;
+    case AV_PIX_FMT_YUV420P12:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 1, 1, 12, false);
+      break;
+    case AV_PIX_FMT_YUV422P12:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 1, 0, 12, false);
+      break;
+    case AV_PIX_FMT_YUV444P12:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 0, 0, 12, false);
+      break;
+
+    case AV_PIX_FMT_YUVA420P:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 1, 1, 8, true);
+      break;
+    case AV_PIX_FMT_YUVA422P:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 1, 0, 8, true);
+      break;
+    case AV_PIX_FMT_YUVA444P:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 0, 0, 8, true);
+      break;
+    case AV_PIX_FMT_YUVA420P10:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 1, 1, 10, true);
+      break;
+    case AV_PIX_FMT_YUVA422P10:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 1, 0, 10, true);
+      break;
+    case AV_PIX_FMT_YUVA444P10:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 0, 0, 10, true);
+      break;
+#if defined(AV_PIX_FMT_YUVA444P12)
+    case AV_PIX_FMT_YUVA422P12:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 1, 0, 12, true);
+      break;
+    case AV_PIX_FMT_YUVA444P12:
+      m_gpu = std::make_unique<YUVPlanarDecoder>(this->decoder(), 0, 0, 12, true);
+      break;
+#endif
+
+    case AV_PIX_FMT_RGB48:
+      m_gpu = std::make_unique<Packed16Decoder>(3, this->decoder(), filter);
+      break;
+    case AV_PIX_FMT_RGBA64:
+      m_gpu = std::make_unique<Packed16Decoder>(4, this->decoder(), filter);
+      break;
+
+    case AV_PIX_FMT_GBRP:
+      m_gpu = std::make_unique<GBRPlanarDecoder>(this->decoder(), 8, false, filter);
+      break;
+    case AV_PIX_FMT_GBRP10:
+      m_gpu = std::make_unique<GBRPlanarDecoder>(this->decoder(), 10, false, filter);
+      break;
+    case AV_PIX_FMT_GBRP12:
+      m_gpu = std::make_unique<GBRPlanarDecoder>(this->decoder(), 12, false, filter);
+      break;
+    case AV_PIX_FMT_GBRAP:
+      m_gpu = std::make_unique<GBRPlanarDecoder>(this->decoder(), 8, true, filter);
+      break;
+    case AV_PIX_FMT_GBRAP10:
+      m_gpu = std::make_unique<GBRPlanarDecoder>(this->decoder(), 10, true, filter);
+      break;
+    case AV_PIX_FMT_GBRAP12:
+      m_gpu = std::make_unique<GBRPlanarDecoder>(this->decoder(), 12, true, filter);
+      break;
+
     default: {
       // try to read format as a 4cc
       std::string_view fourcc{(const char*)&m_currentFormat, 4};
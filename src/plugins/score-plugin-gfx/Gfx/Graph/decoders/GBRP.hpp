@@ -0,0 +1,112 @@
+#pragma once
+#include <Gfx/Graph/decoders/GPUVideoDecoder.hpp>
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+namespace score::gfx
+{
+#include <Gfx/Qt5CompatPush> // clang-format: keep
+
+/**
+ * @brief Decodes planar RGB videos: GBRP, GBRAP and their high bit depth variants.
+ *
+ * These are used by e.g. lossless codecs (FFV1, Ut Video, HuffYUV) and
+ * image sequences. FFmpeg stores the planes in G, B, R, A order.
+ */
+struct GBRPlanarDecoder : GPUVideoDecoder
+{
+  static const constexpr auto gbr_filter = R"_(#version 450
+
+layout(std140, binding = 0) uniform renderer_t {
+mat4 clipSpaceCorrMatrix;
+vec2 texcoordAdjust;
+
+vec2 renderSize;
+} renderer;
+
+layout(binding=3) uniform sampler2D g_tex;
+layout(binding=4) uniform sampler2D b_tex;
+layout(binding=5) uniform sampler2D r_tex;
+%2
+
+layout(location = 0) in vec2 v_texcoord;
+layout(location = 0) out vec4 fragColor;
+
+const float scale = %1;
+
+vec4 processTexture(vec4 tex) {
+  vec4 processed = tex;
+  { %4 }
+  return processed;
+}
+
+void main()
+{
+  float r = texture(r_tex, v_texcoord).r;
+  float g = texture(g_tex, v_texcoord).r;
+  float b = texture(b_tex, v_texcoord).r;
+  float a = %3;
+
+  fragColor = processTexture(vec4(scale * vec3(r, g, b), a));
+}
+)_";
+
+  GBRPlanarDecoder(Video::VideoMetadata& d, int bits, bool alpha, QString f = "")
+      : decoder{d}
+      , bits{bits}
+      , alpha{alpha}
+      , filter{std::move(f)}
+  {
+  }
+
+  Video::VideoMetadata& decoder;
+  int bits{8};
+  bool alpha{};
+  QString filter;
+
+  std::pair<QShader, QShader> init(RenderList& r) override
+  {
+    auto& rhi = *r.state.rhi;
+    const auto w = decoder.width, h = decoder.height;
+    const auto fmt = bits > 8 ? QRhiTexture::R16 : QRhiTexture::R8;
+
+    for(int i = 0; i < (alpha ? 4 : 3); i++)
+    {
+      auto tex = rhi.newTexture(fmt, {w, h}, 1, QRhiTexture::Flag{});
+      tex->create();
+
+      auto sampler = rhi.newSampler(
+          QRhiSampler::Linear, QRhiSampler::Linear, QRhiSampler::None,
+          QRhiSampler::ClampToEdge, QRhiSampler::ClampToEdge);
+      sampler->create();
+      samplers.push_back({sampler, tex});
+    }
+
+    const double scale = bits > 8 ? 65535. / ((1 << bits) - 1) : 1.;
+    const QString shader
+        = QString(gbr_filter)
+              .arg(scale, 0, 'f', 6)
+              .arg(alpha ? "layout(binding=6) uniform sampler2D a_tex;" : "")
+              .arg(alpha ? "scale * texture(a_tex, v_texcoord).r" : "1.0")
+              .arg(filter);
+    return score::gfx::makeShaders(r.state, vertexShader(), shader);
+  }
+
+  void exec(RenderList&, QRhiResourceUpdateBatch& res, AVFrame& frame) override
+  {
+    const int bpp = bits > 8 ? 2 : 1;
+    const auto w = decoder.width, h = decoder.height;
+
+    for(int i = 0; i < (alpha ? 4 : 3); i++)
+    {
+      QRhiTextureUploadEntry entry{
+          0, 0, createTextureUpload(frame.data[i], w, h, bpp, frame.linesize[i])};
+      QRhiTextureUploadDescription desc{entry};
+      res.uploadTexture(samplers[i].texture, desc);
+    }
+  }
+};
+
+#include <Gfx/Qt5CompatPop> // clang-format: keep
+}
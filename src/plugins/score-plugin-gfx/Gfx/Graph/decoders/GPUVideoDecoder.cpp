@@ -21,10 +21,13 @@ void GPUVideoDecoder::release(RenderList&)
     delete sampler.sampler;
   }
   samplers.clear();
+
+  for(auto& buffer : m_staging)
+    buffer = QByteArray{};
 }
 
 QRhiTextureSubresourceUploadDescription GPUVideoDecoder::createTextureUpload(
-    uint8_t* pixels, int w, int h, int bytesPerPixel, int stride)
+    uint8_t* pixels, int w, int h, int bytesPerPixel, int stride) const
 {
   QRhiTextureSubresourceUploadDescription subdesc;
 
@@ -36,14 +39,17 @@ QRhiTextureSubresourceUploadDescription GPUVideoDecoder::createTextureUpload(
   }
   else
   {
-    QByteArray data{w * h, Qt::Uninitialized};
+    QByteArray& data = m_staging[m_currentStaging];
+    m_currentStaging = (m_currentStaging + 1) % m_staging.size();
+
+    data.resize(rowBytes * h);
+    char* output = data.data();
     for(int r = 0; r < h; r++)
     {
       const char* input = reinterpret_cast<const char*>(pixels + stride * r);
-      char* output = data.data() + rowBytes * r;
-      std::copy(input, input + rowBytes, output);
+      std::copy(input, input + rowBytes, output + rowBytes * r);
     }
-    subdesc.setData(std::move(data));
+    subdesc.setData(data);
   }
 
   return subdesc;
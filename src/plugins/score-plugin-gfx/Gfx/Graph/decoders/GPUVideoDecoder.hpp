@@ -5,6 +5,8 @@
 #include <Gfx/Graph/RenderState.hpp>
 #include <Video/VideoInterface.hpp>
 
+#include <array>
+
 extern "C" {
 #include <libavutil/pixdesc.h>
 }
@@ -57,15 +59,28 @@ public:
   /**
    * @brief Utility method to create a QRhiTextureSubresourceUploadDescription.
    *
+   * The description always covers the whole plane.
+   *
    * If possible, it tries to avoid a copy of pixels : pixels must not be freed before the
    * frame has been rendered.
+   *
+   * Otherwise, the rows are copied into one of the staging buffers of the decoder,
+   * which are reused from one frame to the next instead of being reallocated.
    */
-  static QRhiTextureSubresourceUploadDescription
-  createTextureUpload(uint8_t* pixels, int w, int h, int bytesPerPixel, int stride);
+  QRhiTextureSubresourceUploadDescription createTextureUpload(
+      uint8_t* pixels, int w, int h, int bytesPerPixel, int stride) const;
 
   static QString vertexShader() noexcept;
 
   std::vector<Sampler> samplers;
+
+private:
+  // Enough for all the planes of the frames in flight.
+  // A buffer still referenced by a pending QRhiResourceUpdateBatch is
+  // detached when written to, thus reusing it is always safe.
+  static constexpr std::size_t stagingBufferCount = 8;
+  mutable std::array<QByteArray, stagingBufferCount> m_staging;
+  mutable std::size_t m_currentStaging{};
 };
 
 /**
@@ -0,0 +1,124 @@
+#pragma once
+#include <Gfx/Graph/decoders/GPUVideoDecoder.hpp>
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+namespace score::gfx
+{
+#include <Gfx/Qt5CompatPush> // clang-format: keep
+
+/**
+ * @brief Decodes semi-planar YUV 4:2:0 videos: NV12, NV21 and P010.
+ *
+ * These are mostly output by hardware decoders.
+ * The interleaved chroma plane is uploaded as a single-channel texture twice
+ * as wide as the chroma plane, and de-interleaved in the shader.
+ * P010 stores its 10 bits in the high bits of each 16-bit sample, thus it
+ * can be sampled as a normalized 16-bit texture directly.
+ */
+struct NV12Decoder : GPUVideoDecoder
+{
+  static const constexpr auto nv12_filter = R"_(#version 450
+
+layout(std140, binding = 0) uniform renderer_t {
+mat4 clipSpaceCorrMatrix;
+vec2 texcoordAdjust;
+
+vec2 renderSize;
+} renderer;
+
+layout(binding=3) uniform sampler2D y_tex;
+layout(binding=4) uniform sampler2D uv_tex;
+
+layout(location = 0) in vec2 v_texcoord;
+layout(location = 0) out vec4 fragColor;
+
+const mat4 bt709 = mat4(
+                    1.164,  1.164,  1.164,  0.0,
+                    0.000, -0.213,  2.112,  0.0,
+                    1.793, -0.533,  0.000,  0.0,
+                   -0.9695, 0.3000, -1.1290, 1.0);
+
+void main()
+{
+  ivec2 uv_size = textureSize(uv_tex, 0);
+  ivec2 chroma_size = ivec2(uv_size.x / 2, uv_size.y);
+  ivec2 pos = clamp(ivec2(v_texcoord * vec2(chroma_size)), ivec2(0), chroma_size - 1);
+
+  float y = texture(y_tex, v_texcoord).r;
+  float u = texelFetch(uv_tex, ivec2(2 * pos.x + %1, pos.y), 0).r;
+  float v = texelFetch(uv_tex, ivec2(2 * pos.x + %2, pos.y), 0).r;
+
+  fragColor = bt709 * vec4(y, u, v, 1.0);
+}
+)_";
+
+  NV12Decoder(Video::VideoMetadata& d, bool p010, bool swapChroma = false)
+      : decoder{d}
+      , p010{p010}
+      , swapChroma{swapChroma}
+  {
+  }
+
+  Video::VideoMetadata& decoder;
+  bool p010{};
+  bool swapChroma{};
+
+  std::pair<QShader, QShader> init(RenderList& r) override
+  {
+    auto& rhi = *r.state.rhi;
+    const auto w = decoder.width, h = decoder.height;
+    const auto fmt = p010 ? QRhiTexture::R16 : QRhiTexture::R8;
+
+    // Y
+    {
+      auto tex = rhi.newTexture(fmt, {w, h}, 1, QRhiTexture::Flag{});
+      tex->create();
+
+      auto sampler = rhi.newSampler(
+          QRhiSampler::Linear, QRhiSampler::Linear, QRhiSampler::None,
+          QRhiSampler::ClampToEdge, QRhiSampler::ClampToEdge);
+      sampler->create();
+      samplers.push_back({sampler, tex});
+    }
+
+    // UV
+    {
+      auto tex = rhi.newTexture(fmt, {w, h / 2}, 1, QRhiTexture::Flag{});
+      tex->create();
+
+      auto sampler = rhi.newSampler(
+          QRhiSampler::Nearest, QRhiSampler::Nearest, QRhiSampler::None,
+          QRhiSampler::ClampToEdge, QRhiSampler::ClampToEdge);
+      sampler->create();
+      samplers.push_back({sampler, tex});
+    }
+
+    const int u = swapChroma ? 1 : 0;
+    const int v = swapChroma ? 0 : 1;
+    return score::gfx::makeShaders(
+        r.state, vertexShader(), QString(nv12_filter).arg(u).arg(v));
+  }
+
+  void exec(RenderList&, QRhiResourceUpdateBatch& res, AVFrame& frame) override
+  {
+    const int bpp = p010 ? 2 : 1;
+    const auto w = decoder.width, h = decoder.height;
+
+    setPixels(res, samplers[0].texture, frame.data[0], w, h, bpp, frame.linesize[0]);
+    setPixels(res, samplers[1].texture, frame.data[1], w, h / 2, bpp, frame.linesize[1]);
+  }
+
+  void setPixels(
+      QRhiResourceUpdateBatch& res, QRhiTexture* tex, uint8_t* pixels, int w, int h,
+      int bpp, int stride) const noexcept
+  {
+    QRhiTextureUploadEntry entry{0, 0, createTextureUpload(pixels, w, h, bpp, stride)};
+    QRhiTextureUploadDescription desc{entry};
+    res.uploadTexture(tex, desc);
+  }
+};
+
+#include <Gfx/Qt5CompatPop> // clang-format: keep
+}
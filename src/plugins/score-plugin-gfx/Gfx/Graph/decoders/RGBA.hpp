@@ -200,5 +200,97 @@ void main()
     res.uploadTexture(y_tex, desc);
   }
 };
+
+/**
+ * @brief Decodes packed 16-bit RGB videos: RGB48 and RGBA64.
+ *
+ * QRhi has no three-channel nor normalized four-channel 16-bit texture format,
+ * thus the frame is uploaded as a single-channel texture which is
+ * `channels` times as wide as the image and the pixels are reassembled
+ * in the shader.
+ */
+struct Packed16Decoder : GPUVideoDecoder
+{
+  static const constexpr auto rgb_filter = R"_(#version 450
+    layout(std140, binding = 0) uniform renderer_t {
+    mat4 clipSpaceCorrMatrix;
+    vec2 texcoordAdjust;
+
+    vec2 renderSize;
+    } renderer;
+
+    layout(binding=3) uniform sampler2D y_tex;
+
+    layout(location = 0) in vec2 v_texcoord;
+    layout(location = 0) out vec4 fragColor;
+
+    const int channels = %1;
+
+    vec4 processTexture(vec4 tex) {
+      vec4 processed = tex;
+      { %2 }
+      return processed;
+    }
+
+    void main ()
+    {
+      ivec2 sz = textureSize(y_tex, 0);
+      ivec2 img = ivec2(sz.x / channels, sz.y);
+      ivec2 pos = clamp(ivec2(v_texcoord * vec2(img)), ivec2(0), img - 1);
+      int x = pos.x * channels;
+
+      vec4 tex = vec4(
+          texelFetch(y_tex, ivec2(x, pos.y), 0).r,
+          texelFetch(y_tex, ivec2(x + 1, pos.y), 0).r,
+          texelFetch(y_tex, ivec2(x + 2, pos.y), 0).r,
+          channels == 4 ? texelFetch(y_tex, ivec2(x + 3, pos.y), 0).r : 1.0);
+      fragColor = processTexture(tex);
+    })_";
+
+  Packed16Decoder(int channels, Video::VideoMetadata& d, QString f = "")
+      : channels{channels}
+      , decoder{d}
+      , filter{std::move(f)}
+  {
+  }
+  int channels{};
+  Video::VideoMetadata& decoder;
+  QString filter;
+
+  std::pair<QShader, QShader> init(RenderList& r) override
+  {
+    auto& rhi = *r.state.rhi;
+    const auto w = decoder.width, h = decoder.height;
+
+    {
+      auto tex
+          = rhi.newTexture(QRhiTexture::R16, QSize{w * channels, h}, 1, QRhiTexture::Flag{});
+      tex->create();
+
+      // Texels are fetched individually
+      auto sampler = rhi.newSampler(
+          QRhiSampler::Nearest, QRhiSampler::Nearest, QRhiSampler::None,
+          QRhiSampler::ClampToEdge, QRhiSampler::ClampToEdge);
+      sampler->create();
+
+      samplers.push_back({sampler, tex});
+    }
+
+    return score::gfx::makeShaders(
+        r.state, vertexShader(), QString(rgb_filter).arg(channels).arg(filter));
+  }
+
+  void exec(RenderList&, QRhiResourceUpdateBatch& res, AVFrame& frame) override
+  {
+    const auto w = decoder.width, h = decoder.height;
+    auto tex = samplers[0].texture;
+
+    QRhiTextureUploadEntry entry{
+        0, 0, createTextureUpload(frame.data[0], w * channels, h, 2, frame.linesize[0])};
+
+    QRhiTextureUploadDescription desc{entry};
+    res.uploadTexture(tex, desc);
+  }
+};
 #include <Gfx/Qt5CompatPop> // clang-format: keep
 }
@@ -0,0 +1,147 @@
+#pragma once
+#include <Gfx/Graph/decoders/GPUVideoDecoder.hpp>
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+namespace score::gfx
+{
+#include <Gfx/Qt5CompatPush> // clang-format: keep
+
+/**
+ * @brief Decodes planar YUV videos with any chroma subsampling and bit depth.
+ *
+ * This covers the 4:4:4 formats, the 10 and 12 bits formats output by
+ * ProRes / HEVC / VP9 decoders, and the formats with an additional alpha
+ * plane (e.g. ProRes 4444).
+ *
+ * High bit depth samples are stored in the low bits of 16-bit words, thus
+ * they are rescaled to [0; 1] in the shader.
+ * The conversion uses BT.709 limited range coefficients, as the footage
+ * using these formats is HD or higher.
+ */
+struct YUVPlanarDecoder : GPUVideoDecoder
+{
+  static const constexpr auto yuv_filter = R"_(#version 450
+
+layout(std140, binding = 0) uniform renderer_t {
+mat4 clipSpaceCorrMatrix;
+vec2 texcoordAdjust;
+
+vec2 renderSize;
+} renderer;
+
+layout(binding=3) uniform sampler2D y_tex;
+layout(binding=4) uniform sampler2D u_tex;
+layout(binding=5) uniform sampler2D v_tex;
+%2
+
+layout(location = 0) in vec2 v_texcoord;
+layout(location = 0) out vec4 fragColor;
+
+const float scale = %1;
+const mat4 bt709 = mat4(
+                    1.164,  1.164,  1.164,  0.0,
+                    0.000, -0.213,  2.112,  0.0,
+                    1.793, -0.533,  0.000,  0.0,
+                   -0.9695, 0.3000, -1.1290, 1.0);
+
+void main()
+{
+  float y = texture(y_tex, v_texcoord).r;
+  float u = texture(u_tex, v_texcoord).r;
+  float v = texture(v_tex, v_texcoord).r;
+
+  fragColor = bt709 * vec4(scale * vec3(y, u, v), 1.0);
+  %3
+}
+)_";
+
+  /**
+   * @param chromaShiftW, chromaShiftH log2 of the horizontal and vertical chroma
+   * subsampling, e.g. 1, 1 for 4:2:0 ; 1, 0 for 4:2:2 ; 0, 0 for 4:4:4.
+   */
+  YUVPlanarDecoder(
+      Video::VideoMetadata& d, int chromaShiftW, int chromaShiftH, int bits, bool alpha)
+      : decoder{d}
+      , chromaShiftW{chromaShiftW}
+      , chromaShiftH{chromaShiftH}
+      , bits{bits}
+      , alpha{alpha}
+  {
+  }
+
+  Video::VideoMetadata& decoder;
+  int chromaShiftW{};
+  int chromaShiftH{};
+  int bits{8};
+  bool alpha{};
+
+  int bytesPerSample() const noexcept { return bits > 8 ? 2 : 1; }
+
+  QSize chromaSize() const noexcept
+  {
+    // Same rounding as AV_CEIL_RSHIFT
+    return {
+        -((-decoder.width) >> chromaShiftW), -((-decoder.height) >> chromaShiftH)};
+  }
+
+  std::pair<QShader, QShader> init(RenderList& r) override
+  {
+    auto& rhi = *r.state.rhi;
+    const auto fmt = bits > 8 ? QRhiTexture::R16 : QRhiTexture::R8;
+    const QSize lumaSize{decoder.width, decoder.height};
+    const QSize planes[4] = {lumaSize, chromaSize(), chromaSize(), lumaSize};
+
+    for(int i = 0; i < (alpha ? 4 : 3); i++)
+    {
+      auto tex = rhi.newTexture(fmt, planes[i], 1, QRhiTexture::Flag{});
+      tex->create();
+
+      auto sampler = rhi.newSampler(
+          QRhiSampler::Linear, QRhiSampler::Linear, QRhiSampler::None,
+          QRhiSampler::ClampToEdge, QRhiSampler::ClampToEdge);
+      sampler->create();
+      samplers.push_back({sampler, tex});
+    }
+
+    // Maximum value of a sample, normalized to the 16-bit range of the texture
+    const double scale = bits > 8 ? 65535. / ((1 << bits) - 1) : 1.;
+    const QString shader
+        = QString(yuv_filter)
+              .arg(scale, 0, 'f', 6)
+              .arg(alpha ? "layout(binding=6) uniform sampler2D a_tex;" : "")
+              .arg(
+                  alpha ? "fragColor.a = scale * texture(a_tex, v_texcoord).r;" : "");
+    return score::gfx::makeShaders(r.state, vertexShader(), shader);
+  }
+
+  void exec(RenderList&, QRhiResourceUpdateBatch& res, AVFrame& frame) override
+  {
+    const int bpp = bytesPerSample();
+    const auto w = decoder.width, h = decoder.height;
+    const auto csz = chromaSize();
+
+    setPixels(res, samplers[0].texture, frame.data[0], w, h, bpp, frame.linesize[0]);
+    setPixels(
+        res, samplers[1].texture, frame.data[1], csz.width(), csz.height(), bpp,
+        frame.linesize[1]);
+    setPixels(
+        res, samplers[2].texture, frame.data[2], csz.width(), csz.height(), bpp,
+        frame.linesize[2]);
+    if(alpha)
+      setPixels(res, samplers[3].texture, frame.data[3], w, h, bpp, frame.linesize[3]);
+  }
+
+  void setPixels(
+      QRhiResourceUpdateBatch& res, QRhiTexture* tex, uint8_t* pixels, int w, int h,
+      int bpp, int stride) const noexcept
+  {
+    QRhiTextureUploadEntry entry{0, 0, createTextureUpload(pixels, w, h, bpp, stride)};
+    QRhiTextureUploadDescription desc{entry};
+    res.uploadTexture(tex, desc);
+  }
+};
+
+#include <Gfx/Qt5CompatPop> // clang-format: keep
+}
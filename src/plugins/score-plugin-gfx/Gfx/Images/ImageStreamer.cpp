@@ -0,0 +1,172 @@
+#include "ImageStreamer.hpp"
+
+#include <QFileInfo>
+#include <QImageReader>
+#include <QThread>
+
+namespace Gfx
+{
+
+ImageStreamer::ImageStreamer(std::size_t capacity, int lookahead)
+    : m_capacity{std::max(capacity, std::size_t(1))}
+    , m_lookahead{std::max(lookahead, 1)}
+{
+  m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+}
+
+ImageStreamer::~ImageStreamer()
+{
+  {
+    std::lock_guard l{m_mutex};
+    m_generation++;
+  }
+  m_pool.clear();
+  m_pool.waitForDone();
+}
+
+bool ImageStreamer::isSupportedImage(const QString& path)
+{
+  static const auto formats = QImageReader::supportedImageFormats();
+  const auto suffix = QFileInfo{path}.suffix().toLower().toUtf8();
+  return formats.contains(suffix);
+}
+
+int ImageStreamer::frameCountInFile(const QString& path)
+{
+  // Only animated formats need their header to be read
+  const auto suffix = QFileInfo{path}.suffix().toLower();
+  if(suffix != "gif" && suffix != "webp" && suffix != "apng")
+    return 1;
+
+  QImageReader reader{path};
+  return std::max(reader.imageCount(), 1);
+}
+
+void ImageStreamer::setPaths(const std::vector<QString>& paths)
+{
+  std::vector<FrameRef> frames;
+  frames.reserve(paths.size());
+  for(int i = 0, N = paths.size(); i < N; i++)
+  {
+    const int count = frameCountInFile(paths[i]);
+    for(int f = 0; f < count; f++)
+      frames.push_back({i, f});
+  }
+
+  m_pool.clear();
+
+  std::lock_guard l{m_mutex};
+  m_generation++;
+  m_paths = paths;
+  m_frames = std::move(frames);
+  m_lru.clear();
+  m_cache.clear();
+  m_pending.clear();
+  m_sizes.clear();
+}
+
+int ImageStreamer::frameCount() const noexcept
+{
+  std::lock_guard l{m_mutex};
+  return m_frames.size();
+}
+
+std::optional<QImage> ImageStreamer::frame(int index)
+{
+  std::lock_guard l{m_mutex};
+  const int N = m_frames.size();
+  if(index < 0 || index >= N)
+    return {};
+
+  // The requested frame is decoded first, then the following ones
+  for(int i = 0; i < m_lookahead && i < N; i++)
+    schedule((index + i) % N, m_lookahead - i);
+
+  if(auto it = m_cache.find(index); it != m_cache.end())
+  {
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+    return it->second.image;
+  }
+  return {};
+}
+
+QSize ImageStreamer::frameSize(int index)
+{
+  std::lock_guard l{m_mutex};
+  if(index < 0 || index >= int(m_frames.size()))
+    return {};
+
+  if(auto it = m_sizes.find(index); it != m_sizes.end())
+    return it->second;
+
+  // The size is reported by the decoding task along with the frame
+  schedule(index, m_lookahead + 1);
+  return {};
+}
+
+void ImageStreamer::schedule(int index, int priority)
+{
+  if(m_cache.find(index) != m_cache.end() || m_pending.find(index) != m_pending.end())
+    return;
+
+  // Files which could not be decoded are not tried again
+  if(auto it = m_sizes.find(index); it != m_sizes.end() && !it->second.isValid())
+    return;
+
+  m_pending[index] = m_generation;
+
+  const auto ref = m_frames[index];
+  m_pool.start(
+      [this, index, gen = m_generation, path = m_paths[ref.file], frame = ref.frame] {
+        QImage img = decode(path, frame);
+
+        std::lock_guard l{m_mutex};
+        if(gen != m_generation)
+          return;
+
+        m_pending.erase(index);
+        if(!img.isNull())
+        {
+          m_sizes[index] = img.size();
+          insert(index, std::move(img));
+        }
+        else
+        {
+          m_sizes[index] = QSize{};
+        }
+      },
+      priority);
+}
+
+void ImageStreamer::insert(int index, QImage&& img)
+{
+  m_lru.push_front(index);
+  m_cache[index] = CachedFrame{std::move(img), m_lru.begin()};
+
+  while(m_cache.size() > m_capacity)
+  {
+    m_cache.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+}
+
+QImage ImageStreamer::decode(const QString& path, int frame)
+{
+  QImageReader reader{path};
+  reader.setBackgroundColor(Qt::transparent);
+  if(frame > 0 && !reader.jumpToImage(frame))
+  {
+    for(int i = 0; i < frame && reader.canRead(); i++)
+      reader.read();
+  }
+
+  QImage img = reader.read();
+  if(img.isNull() || img.size() == QSize{})
+    return {};
+
+  if(img.format() != QImage::Format_ARGB32)
+    img.convertTo(QImage::Format_ARGB32);
+  return img;
+}
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <ossia/detail/hash_map.hpp>
+
+#include <QImage>
+#include <QString>
+#include <QThreadPool>
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Gfx
+{
+/**
+ * @brief Decodes the frames of an image list on demand.
+ *
+ * Frames are decoded by background threads ahead of the requested index, and
+ * kept in a bounded LRU cache, so that long image sequences can be played
+ * without loading all of them in memory.
+ *
+ * Every method is thread-safe ; none of them blocks on decoding.
+ */
+class ImageStreamer
+{
+public:
+  explicit ImageStreamer(std::size_t capacity = 64, int lookahead = 8);
+  ~ImageStreamer();
+
+  ImageStreamer(const ImageStreamer&) = delete;
+  ImageStreamer& operator=(const ImageStreamer&) = delete;
+
+  //! Files with multiple frames (e.g. GIF) contribute one index per frame.
+  void setPaths(const std::vector<QString>& paths);
+
+  int frameCount() const noexcept;
+
+  //! Returns the frame if it was already decoded, and schedules the next ones.
+  std::optional<QImage> frame(int index);
+
+  //! Size of a frame if it was decoded once, otherwise schedules it and returns {}.
+  //! Frames which cannot be decoded are only tried once until setPaths().
+  QSize frameSize(int index);
+
+  static bool isSupportedImage(const QString& path);
+  static int frameCountInFile(const QString& path);
+
+private:
+  struct FrameRef
+  {
+    int file{};
+    int frame{};
+  };
+  struct CachedFrame
+  {
+    QImage image;
+    std::list<int>::iterator lru;
+  };
+
+  void schedule(int index, int priority);
+  void insert(int index, QImage&& img);
+  static QImage decode(const QString& path, int frame);
+
+  mutable std::mutex m_mutex;
+  std::vector<QString> m_paths;
+  std::vector<FrameRef> m_frames;
+
+  // Most recently used first
+  std::list<int> m_lru;
+  ossia::hash_map<int, CachedFrame> m_cache;
+  ossia::hash_map<int, int> m_pending;
+
+  // Kept for the frames which were evicted from the cache too.
+  // Invalid for the frames which could not be decoded.
+  ossia::hash_map<int, QSize> m_sizes;
+  int m_generation{};
+
+  std::size_t m_capacity{};
+  int m_lookahead{};
+
+  QThreadPool m_pool;
+};
+}
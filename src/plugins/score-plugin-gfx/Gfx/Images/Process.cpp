@@ -6,12 +6,14 @@
 
 #include <Gfx/Graph/Node.hpp>
 #include <Gfx/Images/ImageListChooser.hpp>
+#include <Gfx/Images/ImageStreamer.hpp>
 #include <Gfx/TexturePort.hpp>
 
 #include <ossia/detail/logger.hpp>
 #include <ossia/detail/span.hpp>
 #include <ossia/network/value/format_value.hpp>
 
+#include <QDir>
 #include <QFileInfo>
 #include <QImageReader>
 
@@ -20,36 +22,25 @@
 W_OBJECT_IMPL(Gfx::Images::Model)
 namespace Gfx
 {
-ossia::value fromImageSet(const tcb::span<score::gfx::Image>& images)
+ossia::value fromImagePaths(const std::vector<QString>& paths)
 {
   std::vector<ossia::value> v;
-  for(auto& img : images)
+  v.reserve(paths.size());
+  for(auto& path : paths)
   {
-    v.push_back(img.path.toStdString());
+    v.push_back(path.toStdString());
   }
   return v;
 }
 
-void releaseImages(std::vector<score::gfx::Image>& imgs)
+std::vector<QString> imagePaths(const ossia::value& val)
 {
-  auto& cache = ImageCache::instance();
-  for(auto& img : imgs)
-    cache.release(std::move(img));
-  imgs.clear();
-}
-
-std::vector<score::gfx::Image> getImages(const ossia::value& val)
-{
-  auto& cache = ImageCache::instance();
-  std::vector<score::gfx::Image> imgs;
+  std::vector<QString> paths;
   for(auto& img : ossia::convert<std::vector<ossia::value>>(val))
   {
-    if(auto image = cache.acquire(ossia::convert<std::string>(img)))
-    {
-      imgs.push_back(std::move(*image));
-    }
+    paths.push_back(QString::fromStdString(ossia::convert<std::string>(img)));
   }
-  return imgs;
+  return paths;
 }
 }
 
@@ -103,25 +94,30 @@ Model::Model(
     m_inlets.push_back(tile);
   }
 
+  m_inlets.push_back(makeFrameRateInlet(this));
+
   m_outlets.push_back(new TextureOutlet{Id<Process::Port>(0), this});
 }
 
-Model::~Model()
+Model::~Model() { }
+
+Process::ControlInlet* Model::makeFrameRateInlet(Model* parent)
 {
-  releaseImages(m_currentImages);
+  // 0: the index is only set through the "Index" control
+  return new Process::FloatSlider{
+      0.f, 120.f, 0.f, QObject::tr("Frame rate"), Id<Process::Port>(7), parent};
 }
 
 void Model::on_imagesChanged(const ossia::value& v)
 {
-  releaseImages(m_currentImages);
-  m_currentImages = getImages(safe_cast<ImageListChooser*>(m_inlets[5])->value());
-
+  // Only the number of frames is needed here: the images themselves are
+  // decoded on demand by the renderer.
   int count = 0;
-  for(const auto& img : m_currentImages)
-    count += img.frames.size();
+  for(const auto& path : imagePaths(v))
+    count += ImageStreamer::frameCountInFile(path);
 
   auto spinbox = safe_cast<Process::IntSpinBox*>(m_inlets[0]);
-  if(!m_currentImages.empty())
+  if(count > 0)
     spinbox->setDomain(ossia::make_domain(int(0), int(count) - 1));
   else
     spinbox->setDomain(ossia::make_domain(int(0), int(0)));
@@ -139,12 +135,12 @@ QSet<QString> DropHandler::mimeTypes() const noexcept
 
 QSet<QString> LibraryHandler::acceptedFiles() const noexcept
 {
-  return {"png", "jpg", "jpe", "jpeg", "gif", "bmp"};
+  return {"png", "jpg", "jpe", "jpeg", "gif", "bmp", "tif", "tiff", "webp", "exr"};
 }
 
 QSet<QString> DropHandler::fileExtensions() const noexcept
 {
-  return {"png", "jpg", "jpe", "jpeg", "gif", "bmp"};
+  return {"png", "jpg", "jpe", "jpeg", "gif", "bmp", "tif", "tiff", "webp", "exr"};
 }
 
 static bool isSupportedImage(const QFileInfo& filepath)
@@ -192,61 +188,32 @@ void DropHandler::dropCustom(
   p.creation.key = Metadata<ConcreteKey_k, Gfx::Images::Model>::get();
   p.setup = [files = data.urls()](Process::ProcessModel& m, score::Dispatcher& disp) {
     auto& proc = static_cast<Model&>(m);
-    std::vector<score::gfx::Image> images;
+    std::vector<QString> images;
 
     for(const auto& url : files)
     {
-      if(auto img = Gfx::ImageCache::instance().acquire(url.toLocalFile().toStdString()))
+      const QFileInfo info{url.toLocalFile()};
+      if(info.isDir())
       {
-        images.push_back(*std::move(img));
+        // A folder is played as an image sequence, in file name order
+        QDir dir{info.absoluteFilePath()};
+        for(const auto& file : dir.entryInfoList(QDir::Files, QDir::Name))
+          if(isSupportedImage(file))
+            images.push_back(file.absoluteFilePath());
+      }
+      else if(isSupportedImage(info))
+      {
+        images.push_back(info.absoluteFilePath());
       }
     }
 
     if(!images.empty())
       disp.submit(new Process::SetControlValue{
-          safe_cast<Process::ControlInlet&>(*proc.inlets()[5]), fromImageSet(images)});
+          safe_cast<Process::ControlInlet&>(*proc.inlets()[5]), fromImagePaths(images)});
   };
   vec.push_back(std::move(p));
   return;
 }
-}
-namespace Gfx
-{
-
-std::optional<score::gfx::Image> ImageCache::acquire(const std::string& path)
-{
-  if(auto it = m_images.find(path); it != m_images.end())
-  {
-    it->second.first++;
-    return it->second.second;
-  }
-
-  if(auto img = Images::readImage(QString::fromStdString(path)))
-  {
-    auto [it, ok] = m_images.insert({path, {0, *std::move(img)}});
-    return it->second.second;
-  }
-  return {};
-}
-
-void ImageCache::release(score::gfx::Image&& img)
-{
-  if(auto it = m_images.find(img.path.toStdString()); it != m_images.end())
-  {
-    it->second.first--;
-    if(it->second.first <= 0)
-    {
-      m_images.erase(it);
-    }
-  }
-}
-
-ImageCache& ImageCache::instance() noexcept
-{
-  static ImageCache img;
-  return img;
-}
-
 }
 template <>
 void DataStreamReader::read(const score::gfx::Image& proc)
@@ -326,6 +293,10 @@ void JSONWriter::write(Gfx::Images::Model& proc)
         combo, 0, QObject::tr("Tile"), Id<Process::Port>(6), &proc};
     proc.m_inlets.push_back(tile);
   }
+  if(proc.m_inlets.size() < 8)
+  {
+    proc.m_inlets.push_back(Gfx::Images::Model::makeFrameRateInlet(&proc));
+  }
 
   proc.on_imagesChanged(((Process::ControlInlet*)(proc.m_inlets[5]))->value());
 }
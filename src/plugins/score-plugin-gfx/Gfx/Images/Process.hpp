@@ -13,21 +13,8 @@
 
 namespace Gfx
 {
-std::vector<score::gfx::Image> getImages(const ossia::value& val);
-ossia::value fromImageSet(const tcb::span<score::gfx::Image>& images);
-void releaseImages(std::vector<score::gfx::Image>& imgs);
-
-struct ImageCache
-{
-public:
-  std::optional<score::gfx::Image> acquire(const std::string& path);
-  void release(score::gfx::Image&& img);
-
-  static ImageCache& instance() noexcept;
-
-private:
-  std::unordered_map<std::string, std::pair<int, score::gfx::Image>> m_images;
-};
+std::vector<QString> imagePaths(const ossia::value& val);
+ossia::value fromImagePaths(const std::vector<QString>& paths);
 }
 W_REGISTER_ARGTYPE(score::gfx::Image)
 
@@ -52,6 +39,8 @@ public:
 
   ~Model() override;
 
+  static Process::ControlInlet* makeFrameRateInlet(Model* parent);
+
   //std::vector<score::gfx::Image> images() const noexcept;
   //void setImages(const std::vector<score::gfx::Image>& f);
   //  void imagesChanged() W_SIGNAL(imagesChanged);
@@ -62,7 +51,6 @@ public:
 private:
   void on_imagesChanged(const ossia::value& v);
   QString prettyName() const noexcept override;
-  std::vector<score::gfx::Image> m_currentImages;
 };
 
 using ProcessFactory = Process::ProcessFactory_T<Gfx::Images::Model>;
@@ -34,10 +34,12 @@ SETTINGS_PARAMETER_IMPL(GraphicsApi){
 SETTINGS_PARAMETER_IMPL(Rate){QStringLiteral("score_plugin_gfx/Rate"), 60.0};
 SETTINGS_PARAMETER_IMPL(Samples){QStringLiteral("score_plugin_gfx/Samples"), 1};
 SETTINGS_PARAMETER_IMPL(VSync){QStringLiteral("score_plugin_gfx/VSync"), true};
+SETTINGS_PARAMETER_IMPL(SharedRendering){
+    QStringLiteral("score_plugin_gfx/SharedRendering"), false};
 
 static auto list()
 {
-  return std::tie(GraphicsApi, Samples, Rate, VSync);
+  return std::tie(GraphicsApi, Samples, Rate, VSync, SharedRendering);
 }
 }
 
@@ -92,5 +94,6 @@ SCORE_SETTINGS_PARAMETER_CPP(QString, Model, GraphicsApi)
 SCORE_SETTINGS_PARAMETER_CPP(double, Model, Rate)
 SCORE_SETTINGS_PARAMETER_CPP(int, Model, Samples)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, VSync)
+SCORE_SETTINGS_PARAMETER_CPP(bool, Model, SharedRendering)
 
 }
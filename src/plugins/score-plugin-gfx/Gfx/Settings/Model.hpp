@@ -27,6 +27,7 @@ class Model : public score::SettingsDelegateModel
   double m_Rate{};
   int m_Samples{1};
   bool m_VSync{};
+  bool m_SharedRendering{};
 
 public:
   Model(QSettings& set, const score::ApplicationContext& ctx);
@@ -34,6 +35,7 @@ public:
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_GFX_EXPORT, double, Rate)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_GFX_EXPORT, int, Samples)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_GFX_EXPORT, bool, VSync)
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_GFX_EXPORT, bool, SharedRendering)
 
 public:
   score::gfx::GraphicsApi graphicsApiEnum() const noexcept;
@@ -49,4 +51,5 @@ SCORE_SETTINGS_PARAMETER(Model, GraphicsApi)
 SCORE_SETTINGS_PARAMETER(Model, Rate)
 SCORE_SETTINGS_PARAMETER(Model, Samples)
 SCORE_SETTINGS_PARAMETER(Model, VSync)
+SCORE_SETTINGS_PARAMETER(Model, SharedRendering)
 }
@@ -22,6 +22,7 @@ Presenter::Presenter(Model& m, View& v, QObject* parent)
   SETTINGS_PRESENTER(Samples);
   SETTINGS_PRESENTER(Rate);
   SETTINGS_PRESENTER(VSync);
+  SETTINGS_PRESENTER(SharedRendering);
 }
 
 QString Presenter::settingsName()
@@ -30,6 +30,7 @@ View::View()
   SETTINGS_UI_DOUBLE_SPINBOX_SETUP("Rate (if no VSync)", Rate);
   m_Rate->setRange(1., 1000.);
   SETTINGS_UI_TOGGLE_SETUP("VSync", VSync);
+  SETTINGS_UI_TOGGLE_SETUP("Share rendering between outputs", SharedRendering);
 }
 
 QWidget* View::getWidget()
@@ -41,5 +42,6 @@ SETTINGS_UI_COMBOBOX_IMPL(GraphicsApi)
 SETTINGS_UI_NUM_COMBOBOX_IMPL(Samples)
 SETTINGS_UI_DOUBLE_SPINBOX_IMPL(Rate)
 SETTINGS_UI_TOGGLE_IMPL(VSync)
+SETTINGS_UI_TOGGLE_IMPL(SharedRendering)
 
 }
@@ -19,6 +19,7 @@ public:
   SETTINGS_UI_DOUBLE_SPINBOX_HPP(Rate)
   SETTINGS_UI_NUM_COMBOBOX_HPP(Samples)
   SETTINGS_UI_TOGGLE_HPP(VSync)
+  SETTINGS_UI_TOGGLE_HPP(SharedRendering)
 
 private:
   QWidget* getWidget() override;
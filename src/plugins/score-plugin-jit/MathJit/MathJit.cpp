@@ -0,0 +1,880 @@
+#include "MathJit.hpp"
+
+#include <JitCpp/Compiler/Driver.hpp>
+
+#include <ossia/detail/algorithms.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <set>
+#include <string_view>
+#include <vector>
+
+namespace Jit
+{
+namespace
+{
+struct unsupported
+{
+};
+
+struct Token
+{
+  enum Type
+  {
+    Number,
+    Identifier,
+    Symbol,
+    End
+  } type{End};
+  std::string text;
+};
+
+std::vector<Token> tokenize(const std::string& str)
+{
+  static constexpr std::string_view two_chars[]{
+      ":=", "+=", "-=", "*=", "/=", "%=", "==", "!=", "<>", "<=", ">=", "&&", "||"};
+  static constexpr std::string_view one_char = "+-*/%^()[]{},;<>=!&|?:";
+  const auto is_digit = [](char c) { return std::isdigit((unsigned char)c) != 0; };
+  const auto is_alpha = [](char c) { return std::isalpha((unsigned char)c) != 0; };
+  const auto is_alnum = [](char c) { return std::isalnum((unsigned char)c) != 0; };
+
+  std::vector<Token> res;
+  const std::size_t n = str.size();
+  std::size_t i = 0;
+  while(i < n)
+  {
+    const char c = str[i];
+    const char next = i + 1 < n ? str[i + 1] : '\0';
+    if(std::isspace((unsigned char)c))
+    {
+      i++;
+    }
+    else if(c == '#' || (c == '/' && next == '/'))
+    {
+      while(i < n && str[i] != '\n')
+        i++;
+    }
+    else if(c == '/' && next == '*')
+    {
+      auto end = str.find("*/", i + 2);
+      if(end == std::string::npos)
+        throw unsupported{};
+      i = end + 2;
+    }
+    else if(is_digit(c) || (c == '.' && is_digit(next)))
+    {
+      std::size_t j = i;
+      while(j < n && (is_digit(str[j]) || str[j] == '.'))
+        j++;
+      if(j < n && (str[j] == 'e' || str[j] == 'E'))
+      {
+        std::size_t k = j + 1;
+        if(k < n && (str[k] == '+' || str[k] == '-'))
+          k++;
+        if(k < n && is_digit(str[k]))
+        {
+          j = k;
+          while(j < n && is_digit(str[j]))
+            j++;
+        }
+      }
+
+      auto text = str.substr(i, j - i);
+      if(std::count(text.begin(), text.end(), '.') > 1)
+        throw unsupported{};
+
+      // Integer literals would use integer arithmetic in C++
+      if(text.find_first_of(".eE") == std::string::npos)
+        text += ".";
+      res.push_back({Token::Number, std::move(text)});
+      i = j;
+    }
+    else if(is_alpha(c) || c == '_')
+    {
+      std::size_t j = i;
+      while(j < n && (is_alnum(str[j]) || str[j] == '_'))
+        j++;
+
+      // ExprTK identifiers are not case-sensitive
+      auto text = str.substr(i, j - i);
+      for(auto& ch : text)
+        ch = std::tolower((unsigned char)ch);
+      res.push_back({Token::Identifier, std::move(text)});
+      i = j;
+    }
+    else if(ossia::contains(two_chars, str.substr(i, 2)))
+    {
+      res.push_back({Token::Symbol, str.substr(i, 2)});
+      i += 2;
+    }
+    else if(one_char.find(c) != std::string_view::npos)
+    {
+      res.push_back({Token::Symbol, std::string(1, c)});
+      i++;
+    }
+    else
+    {
+      throw unsupported{};
+    }
+  }
+
+  res.push_back({Token::End, {}});
+  return res;
+}
+
+struct Function
+{
+  std::string_view name;
+  std::string_view impl;
+  int arity{}; // -1: variadic
+};
+
+constexpr Function functions[]{
+    {"sin", "sin", 1},
+    {"cos", "cos", 1},
+    {"tan", "tan", 1},
+    {"asin", "asin", 1},
+    {"acos", "acos", 1},
+    {"atan", "atan", 1},
+    {"sinh", "sinh", 1},
+    {"cosh", "cosh", 1},
+    {"tanh", "tanh", 1},
+    {"asinh", "asinh", 1},
+    {"acosh", "acosh", 1},
+    {"atanh", "atanh", 1},
+    {"exp", "exp", 1},
+    {"expm1", "expm1", 1},
+    {"log", "log", 1},
+    {"log2", "log2", 1},
+    {"log10", "log10", 1},
+    {"log1p", "log1p", 1},
+    {"sqrt", "sqrt", 1},
+    {"cbrt", "cbrt", 1},
+    {"floor", "floor", 1},
+    {"ceil", "ceil", 1},
+    {"trunc", "trunc", 1},
+    {"round", "round", 1},
+    {"erf", "erf", 1},
+    {"erfc", "erfc", 1},
+    {"abs", "fabs", 1},
+    {"pow", "pow", 2},
+    {"atan2", "atan2", 2},
+    {"hypot", "hypot", 2},
+    {"clamp", "m_clamp", 3},
+    {"inrange", "m_inrange", 3},
+    {"sgn", "m_sgn", 1},
+    {"frac", "m_frac", 1},
+    {"sinc", "m_sinc", 1},
+    {"deg2rad", "m_deg2rad", 1},
+    {"rad2deg", "m_rad2deg", 1},
+    {"min", "m_min", -1},
+    {"max", "m_max", -1},
+};
+
+constexpr std::string_view value_scalars[]{
+    "t", "dt", "pos", "fs", "x", "px", "po", "a", "b", "c", "pa", "pb", "pc",
+    "m1", "m2", "m3"};
+constexpr std::string_view audio_scalars[]{"t", "fs", "a", "b", "c"};
+constexpr std::string_view generator_vectors[]{"out", "m1", "m2", "m3"};
+constexpr std::string_view filter_vectors[]{"x", "px", "out", "m1", "m2", "m3"};
+
+constexpr std::string_view keywords[]{
+    "var", "for", "while", "if", "else", "break", "continue", "return", "and", "or",
+    "not", "true", "false", "pi", "epsilon", "inf"};
+
+/**
+ * @brief Recursive descent translation of ExprTK to C++.
+ *
+ * Binary operations are always parenthesized, so that an expression which
+ * starts with a variable name is a variable or an indexed vector.
+ */
+class Translator
+{
+public:
+  Translator(const std::string& expr, Nodes::MathCompiler::Kind kind)
+      : m_tokens{tokenize(expr)}
+      , m_kind{kind}
+  {
+  }
+
+  std::string body()
+  {
+    auto res = statements(true);
+    if(peek().type != Token::End)
+      throw unsupported{};
+    if(m_kind == Nodes::MathCompiler::Value && !m_hasResult)
+      throw unsupported{};
+    return res;
+  }
+
+private:
+  struct Statement
+  {
+    std::string code;
+    bool compound{};
+    bool value{};
+  };
+
+  const Token& peek() const noexcept { return m_tokens[m_pos]; }
+
+  bool accept(std::string_view text)
+  {
+    const auto& tok = peek();
+    if((tok.type == Token::Symbol || tok.type == Token::Identifier) && tok.text == text)
+    {
+      m_pos++;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(std::string_view text)
+  {
+    if(!accept(text))
+      throw unsupported{};
+  }
+
+  bool isScalar(const std::string& name) const noexcept
+  {
+    if(m_kind == Nodes::MathCompiler::Value)
+      return ossia::contains(value_scalars, name);
+    return ossia::contains(audio_scalars, name);
+  }
+
+  bool isVector(const std::string& name) const noexcept
+  {
+    switch(m_kind)
+    {
+      case Nodes::MathCompiler::AudioGenerator:
+        return ossia::contains(generator_vectors, name);
+      case Nodes::MathCompiler::AudioFilter:
+        return ossia::contains(filter_vectors, name);
+      default:
+        return false;
+    }
+  }
+
+  static bool isLvalue(const std::string& e) noexcept
+  {
+    return e.starts_with("s_") || e.starts_with("l_");
+  }
+
+  std::string statements(bool top)
+  {
+    std::string res;
+    while(peek().type != Token::End
+          && !(peek().type == Token::Symbol && peek().text == "}"))
+    {
+      if(accept(";"))
+        continue;
+
+      auto st = statement();
+      if(top && m_kind == Nodes::MathCompiler::Value)
+        m_hasResult = st.value;
+      res += st.code;
+
+      // Statements are separated by semicolons, except after a block
+      if(!st.compound && !accept(";"))
+      {
+        if(peek().type != Token::End && peek().text != "}")
+          throw unsupported{};
+      }
+    }
+    return res;
+  }
+
+  Statement statement()
+  {
+    if(accept("{"))
+    {
+      auto body = statements(false);
+      expect("}");
+      return {"{\n" + body + "}\n", true};
+    }
+
+    if(accept("var"))
+    {
+      if(peek().type != Token::Identifier)
+        throw unsupported{};
+      const auto name = peek().text;
+      m_pos++;
+
+      if(isScalar(name) || isVector(name) || m_locals.contains(name)
+         || ossia::contains(keywords, name)
+         || ossia::any_of(functions, [&](auto& f) { return f.name == name; }))
+        throw unsupported{};
+
+      std::string init = "0.";
+      if(accept(":="))
+        init = expression();
+      m_locals.insert(name);
+
+      std::string code = "double l_" + name + " = " + init + ";\n";
+      if(m_kind == Nodes::MathCompiler::Value)
+        code += "score_result = l_" + name + ";\n";
+      return {code, false, true};
+    }
+
+    if(accept("for"))
+    {
+      expect("(");
+      std::string init, cond, step;
+      if(!accept(";"))
+      {
+        auto st = statement();
+        if(st.compound)
+          throw unsupported{};
+        init = st.code;
+        expect(";");
+      }
+      if(!accept(";"))
+      {
+        cond = expression();
+        expect(";");
+      }
+      if(!accept(")"))
+      {
+        step = expression();
+        expect(")");
+      }
+      auto body = statement();
+      accept(";");
+      return {
+          "{\n" + init + "for(; " + cond + "; " + step + ")\n{\n" + body.code + "}\n}\n",
+          true};
+    }
+
+    if(accept("while"))
+    {
+      expect("(");
+      auto cond = expression();
+      expect(")");
+      auto body = statement();
+      accept(";");
+      return {"while(" + cond + ")\n{\n" + body.code + "}\n", true};
+    }
+
+    if(peek().text == "if")
+    {
+      // if (cond) statement, unless it is the if (cond, a, b) function
+      const auto pos = m_pos;
+      m_pos++;
+      expect("(");
+      auto cond = expression();
+      if(accept(")"))
+      {
+        auto then = statement();
+        const bool separated = !then.compound && accept(";");
+        if(accept("else"))
+        {
+          auto otherwise = statement();
+          return {
+              "if(" + cond + ")\n{\n" + then.code + "}\nelse\n{\n" + otherwise.code
+                  + "}\n",
+              otherwise.compound};
+        }
+        return {"if(" + cond + ")\n{\n" + then.code + "}\n", separated || then.compound};
+      }
+      m_pos = pos;
+    }
+
+    if(accept("break"))
+      return {"break;\n"};
+    if(accept("continue"))
+      return {"continue;\n"};
+
+    auto e = expression();
+    if(m_kind == Nodes::MathCompiler::Value)
+      return {"score_result = " + e + ";\n", false, true};
+    return {e + ";\n", false, true};
+  }
+
+  std::string expression()
+  {
+    auto lhs = ternary();
+    static constexpr std::string_view assignments[]{":=", "+=", "-=", "*=", "/=", "%="};
+    for(auto op : assignments)
+    {
+      if(accept(op))
+      {
+        if(!isLvalue(lhs))
+          throw unsupported{};
+
+        auto rhs = expression();
+        if(op == ":=")
+          return lhs + " = " + rhs;
+        if(op == "%=")
+          return lhs + " = fmod(" + lhs + ", " + rhs + ")";
+        return lhs + " " + std::string(op) + " " + rhs;
+      }
+    }
+    return lhs;
+  }
+
+  std::string ternary()
+  {
+    auto cond = logicalOr();
+    if(accept("?"))
+    {
+      auto a = expression();
+      expect(":");
+      auto b = expression();
+      return "(bool(" + cond + ") ? " + a + " : " + b + ")";
+    }
+    return cond;
+  }
+
+  std::string logicalOr()
+  {
+    auto lhs = logicalAnd();
+    while(accept("or") || accept("||") || accept("|"))
+    {
+      auto rhs = logicalAnd();
+      lhs = "double(bool(" + lhs + ") || bool(" + rhs + "))";
+    }
+    return lhs;
+  }
+
+  std::string logicalAnd()
+  {
+    auto lhs = equality();
+    while(accept("and") || accept("&&") || accept("&"))
+    {
+      auto rhs = equality();
+      lhs = "double(bool(" + lhs + ") && bool(" + rhs + "))";
+    }
+    return lhs;
+  }
+
+  std::string equality()
+  {
+    auto lhs = relational();
+    for(;;)
+    {
+      if(accept("==") || accept("="))
+        lhs = "double(" + lhs + " == " + relational() + ")";
+      else if(accept("!=") || accept("<>"))
+        lhs = "double(" + lhs + " != " + relational() + ")";
+      else
+        return lhs;
+    }
+  }
+
+  std::string relational()
+  {
+    auto lhs = additive();
+    for(;;)
+    {
+      std::string_view op;
+      if(accept("<="))
+        op = "<=";
+      else if(accept(">="))
+        op = ">=";
+      else if(accept("<"))
+        op = "<";
+      else if(accept(">"))
+        op = ">";
+      else
+        return lhs;
+      lhs = "double(" + lhs + " " + std::string(op) + " " + additive() + ")";
+    }
+  }
+
+  std::string additive()
+  {
+    auto lhs = multiplicative();
+    for(;;)
+    {
+      if(accept("+"))
+        lhs = "(" + lhs + " + " + multiplicative() + ")";
+      else if(accept("-"))
+        lhs = "(" + lhs + " - " + multiplicative() + ")";
+      else
+        return lhs;
+    }
+  }
+
+  std::string multiplicative()
+  {
+    auto lhs = unary();
+    for(;;)
+    {
+      if(accept("*"))
+        lhs = "(" + lhs + " * " + unary() + ")";
+      else if(accept("/"))
+        lhs = "(" + lhs + " / " + unary() + ")";
+      else if(accept("%"))
+        lhs = "fmod(" + lhs + ", " + unary() + ")";
+      else
+        return lhs;
+    }
+  }
+
+  std::string unary()
+  {
+    if(accept("-"))
+      return "(-" + unary() + ")";
+    if(accept("+"))
+      return unary();
+    if(accept("!") || accept("not"))
+      return "double(!bool(" + unary() + "))";
+    return power();
+  }
+
+  std::string power()
+  {
+    auto base = primary();
+    if(accept("^"))
+      return "pow(" + base + ", " + unary() + ")";
+    return base;
+  }
+
+  std::string primary()
+  {
+    const Token tok = peek();
+    if(tok.type == Token::Number)
+    {
+      m_pos++;
+      return tok.text;
+    }
+
+    if(accept("("))
+    {
+      auto e = expression();
+      expect(")");
+      return "(" + e + ")";
+    }
+
+    if(tok.type != Token::Identifier)
+      throw unsupported{};
+    m_pos++;
+
+    const auto& name = tok.text;
+    if(name == "if")
+    {
+      expect("(");
+      auto cond = expression();
+      expect(",");
+      auto a = expression();
+      expect(",");
+      auto b = expression();
+      expect(")");
+      return "(bool(" + cond + ") ? " + a + " : " + b + ")";
+    }
+    if(name == "true")
+      return "1.";
+    if(name == "false")
+      return "0.";
+    if(name == "pi")
+      return "3.14159265358979323846";
+    if(name == "epsilon")
+      return "2.220446049250313e-16";
+    if(name == "inf")
+      return "__builtin_inf()";
+
+    if(accept("("))
+    {
+      std::vector<std::string> args;
+      if(!accept(")"))
+      {
+        do
+          args.push_back(expression());
+        while(accept(","));
+        expect(")");
+      }
+      return call(name, args);
+    }
+
+    if(m_locals.contains(name))
+      return "l_" + name;
+    if(isScalar(name))
+      return "s_" + name;
+    if(isVector(name))
+    {
+      expect("[");
+      if(accept("]"))
+        return "double(s_" + name + ".n)";
+      auto index = expression();
+      expect("]");
+      return "s_" + name + "[" + index + "]";
+    }
+
+    throw unsupported{};
+  }
+
+  static std::string call(const std::string& name, const std::vector<std::string>& args)
+  {
+    auto f = ossia::find_if(functions, [&](auto& f) { return f.name == name; });
+    if(f == std::end(functions) || args.empty())
+      throw unsupported{};
+
+    const std::string impl{f->impl};
+    if(f->arity == -1)
+    {
+      // Variadic min / max
+      auto res = args[0];
+      for(std::size_t i = 1; i < args.size(); i++)
+        res = impl + "(" + res + ", " + args[i] + ")";
+      return res;
+    }
+
+    if(int(args.size()) != f->arity)
+      throw unsupported{};
+
+    std::string res = impl + "(" + args[0];
+    for(std::size_t i = 1; i < args.size(); i++)
+      res += ", " + args[i];
+    return res + ")";
+  }
+
+  std::vector<Token> m_tokens;
+  std::size_t m_pos{};
+  Nodes::MathCompiler::Kind m_kind{};
+  std::set<std::string> m_locals;
+  bool m_hasResult{};
+};
+
+// No system header is included, so that the kernels do not depend on the
+// availability of a standard library for the JIT
+constexpr std::string_view prelude = R"_(
+extern "C" {
+double sin(double); double cos(double); double tan(double);
+double asin(double); double acos(double); double atan(double);
+double sinh(double); double cosh(double); double tanh(double);
+double asinh(double); double acosh(double); double atanh(double);
+double exp(double); double expm1(double); double log(double);
+double log2(double); double log10(double); double log1p(double);
+double sqrt(double); double cbrt(double); double floor(double);
+double ceil(double); double trunc(double); double round(double);
+double erf(double); double erfc(double); double fabs(double);
+double pow(double, double); double atan2(double, double);
+double hypot(double, double); double fmod(double, double);
+}
+
+static inline double m_min(double a, double b) { return a < b ? a : b; }
+static inline double m_max(double a, double b) { return a < b ? b : a; }
+static inline double m_clamp(double lo, double x, double hi)
+{ return x < lo ? lo : (x > hi ? hi : x); }
+static inline double m_inrange(double lo, double x, double hi)
+{ return lo <= x && x <= hi; }
+static inline double m_sgn(double x) { return double(x > 0.) - double(x < 0.); }
+static inline double m_frac(double x) { return x - trunc(x); }
+static inline double m_sinc(double x) { return x == 0. ? 1. : sin(x) / x; }
+static inline double m_deg2rad(double x) { return x * 0.017453292519943295; }
+static inline double m_rad2deg(double x) { return x * 57.29577951308232; }
+)_";
+
+std::string valueKernel(const std::string& body)
+{
+  // Mirrors Nodes::MathValueVariables
+  return std::string(prelude) + R"_(
+struct score_math_vars
+{
+  double t, dt, pos, fs, x, px, po, a, b, c, pa, pb, pc, m1, m2, m3;
+};
+
+extern "C" double score_math(score_math_vars& v)
+{
+  double& s_t = v.t; double& s_dt = v.dt; double& s_pos = v.pos;
+  double& s_fs = v.fs; double& s_x = v.x; double& s_px = v.px;
+  double& s_po = v.po; double& s_a = v.a; double& s_b = v.b;
+  double& s_c = v.c; double& s_pa = v.pa; double& s_pb = v.pb;
+  double& s_pc = v.pc; double& s_m1 = v.m1; double& s_m2 = v.m2;
+  double& s_m3 = v.m3;
+  double score_result = 0.;
+)_" + body + R"_(
+  return score_result;
+}
+)_";
+}
+
+std::string audioKernel(const std::string& body)
+{
+  // Mirrors Nodes::MathAudioVariables.
+  // The whole block is processed in a single call so that the loop over the
+  // frames can be optimized and vectorized along with the expression.
+  const auto max_channels = std::to_string(Nodes::MathCompiler::maxChannels);
+  return std::string(prelude) + R"_(
+using score_int64 = __INT64_TYPE__;
+
+struct score_math_vec
+{
+  double* p;
+  int n;
+  double* sink;
+  double& operator[](double i) const noexcept
+  {
+    const int k = int(i);
+    return k >= 0 && k < n ? p[k] : *sink;
+  }
+};
+
+struct score_math_vars
+{
+  double t, fs, a, b, c;
+  double* m1;
+  double* m2;
+  double* m3;
+  double* px;
+  int channels;
+};
+
+extern "C" void score_math(
+    score_math_vars& v, const double* const* in, double* const* output,
+    score_int64 frames)
+{
+  const int C = v.channels;
+  double sink = 0.;
+  double x_buf[)_" + max_channels + R"_(] = {};
+  double out_buf[)_" + max_channels + R"_(] = {};
+  score_math_vec s_x{x_buf, C, &sink};
+  score_math_vec s_px{v.px, v.px ? C : 0, &sink};
+  score_math_vec s_out{out_buf, C, &sink};
+  score_math_vec s_m1{v.m1, C, &sink};
+  score_math_vec s_m2{v.m2, C, &sink};
+  score_math_vec s_m3{v.m3, C, &sink};
+  double& s_fs = v.fs; double& s_a = v.a; double& s_b = v.b; double& s_c = v.c;
+
+  for(score_int64 score_i = 0; score_i < frames; score_i++)
+  {
+    double s_t = v.t + double(score_i);
+    if(in)
+      for(int j = 0; j < C; j++)
+        x_buf[j] = in[j][score_i];
+    {
+)_" + body + R"_(
+    }
+    for(int j = 0; j < C; j++)
+      output[j][score_i] = out_buf[j];
+    if(in)
+      for(int j = 0; j < C; j++)
+        v.px[j] = x_buf[j];
+  }
+}
+)_";
+}
+}
+
+std::string
+generateMathKernel(const std::string& expression, Nodes::MathCompiler::Kind kind)
+{
+  try
+  {
+    auto body = Translator{expression, kind}.body();
+    if(kind == Nodes::MathCompiler::Value)
+      return valueKernel(body);
+    return audioKernel(body);
+  }
+  catch(const unsupported&)
+  {
+    return {};
+  }
+}
+
+MathCompiler::MathCompiler()
+    : m_queue{256}
+    , m_thread{[this] { worker(); }}
+{
+}
+
+MathCompiler::~MathCompiler()
+{
+  m_stop = true;
+  m_thread.join();
+}
+
+bool MathCompiler::compile(const std::shared_ptr<Request>& request) noexcept
+{
+  // Does not allocate: the queue is full when it fails
+  return m_queue.try_enqueue(request);
+}
+
+void MathCompiler::collectUnused()
+{
+  m_queue.enqueue(nullptr);
+}
+
+void MathCompiler::worker()
+{
+  std::shared_ptr<Request> req;
+  while(!m_stop)
+  {
+    if(!m_queue.try_dequeue(req))
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      continue;
+    }
+
+    // Otherwise the node is gone already
+    if(req && req.use_count() > 1)
+      build(req);
+
+    req.reset();
+    release();
+  }
+}
+
+void MathCompiler::build(const std::shared_ptr<Request>& req)
+{
+  auto [it, inserted] = m_kernels.try_emplace({req->kind, req->expression});
+  auto& k = it->second;
+  if(inserted)
+  {
+    const auto source = generateMathKernel(req->expression, req->kind);
+    if(!source.empty())
+    {
+      try
+      {
+        auto driver = std::make_unique<Driver>("score_math");
+        if(req->kind == Value)
+        {
+          auto f = (*driver).operator()<Nodes::MathValueKernel>(
+              source, {}, CompilerOptions{true});
+          if(auto ptr = f.target<Nodes::MathValueKernel*>())
+            k.value = *ptr;
+        }
+        else
+        {
+          auto f = (*driver).operator()<Nodes::MathAudioKernel>(
+              source, {}, CompilerOptions{true});
+          if(auto ptr = f.target<Nodes::MathAudioKernel*>())
+            k.audio = *ptr;
+        }
+        k.driver = std::move(driver);
+      }
+      catch(...)
+      {
+        // The expression stays interpreted
+      }
+    }
+  }
+
+  if(req->compiled != &k)
+    k.users.push_back(req);
+  req->compiled = &k;
+  req->value.store(k.value, std::memory_order_release);
+  req->audio.store(k.audio, std::memory_order_release);
+  req->pending.store(false, std::memory_order_release);
+}
+
+void MathCompiler::release()
+{
+  // A node stops using a kernel when it is destroyed or when it requests
+  // another expression, which it only does once it stopped running this one.
+  for(auto it = m_kernels.begin(); it != m_kernels.end();)
+  {
+    auto& k = it->second;
+    ossia::remove_erase_if(k.users, [&k](const std::weak_ptr<Request>& user) {
+      auto req = user.lock();
+      return !req || req->compiled != &k;
+    });
+
+    if(k.users.empty())
+      it = m_kernels.erase(it);
+    else
+      ++it;
+  }
+}
+}
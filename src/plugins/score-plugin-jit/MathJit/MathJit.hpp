@@ -0,0 +1,67 @@
+#pragma once
+#include <Fx/MathCompiler.hpp>
+
+#include <concurrentqueue.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Jit
+{
+struct Driver;
+
+/**
+ * @brief Generates the C++ source of a kernel for an ExprTK expression.
+ *
+ * Only a subset of ExprTK is handled: arithmetic, comparisons and logic, the
+ * usual math functions, local variables, vector indexing and the
+ * if / for / while statements.
+ * Returns an empty string for anything else, in which case the expression
+ * stays interpreted.
+ */
+std::string
+generateMathKernel(const std::string& expression, Nodes::MathCompiler::Kind kind);
+
+/**
+ * @brief Compiles the expressions of the math nodes with clang.
+ *
+ * Requests are handled in order by a dedicated thread, which polls for them
+ * so that the execution thread never has to wake it up.
+ * Kernels are shared by the nodes which use the same expression, and freed
+ * once none of them uses it anymore.
+ */
+class MathCompiler final : public Nodes::MathCompiler
+{
+public:
+  MathCompiler();
+  ~MathCompiler() override;
+
+private:
+  bool compile(const std::shared_ptr<Request>& request) noexcept override;
+  void collectUnused() override;
+  void worker();
+  void build(const std::shared_ptr<Request>& request);
+  void release();
+
+  struct Kernel
+  {
+    std::unique_ptr<Driver> driver;
+    Nodes::MathValueKernel* value{};
+    Nodes::MathAudioKernel* audio{};
+    std::vector<std::weak_ptr<Request>> users;
+  };
+
+  // Only accessed from the compilation thread
+  std::map<std::pair<Kind, std::string>, Kernel> m_kernels;
+
+  // Null messages ask for the unused kernels to be released
+  moodycamel::ConcurrentQueue<std::shared_ptr<Request>> m_queue;
+  std::atomic_bool m_stop{};
+
+  std::thread m_thread;
+};
+}
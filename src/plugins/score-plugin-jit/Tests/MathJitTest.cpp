@@ -0,0 +1,109 @@
+#include <JitCpp/Compiler/Driver.hpp>
+#include <MathJit/MathJit.hpp>
+
+#include <ossia/math/math_expression.hpp>
+#include <ossia/network/value/value_conversion.hpp>
+
+#include <llvm/Support/TargetSelect.h>
+
+#define CATCH_CONFIG_MAIN 1
+#if __has_include(<catch2/catch.hpp>)
+#include <catch2/catch.hpp>
+
+namespace
+{
+struct Interpreter : Nodes::MathValueVariables
+{
+  Interpreter()
+  {
+    expr.add_variable("t", cur_time);
+    expr.add_variable("dt", cur_deltatime);
+    expr.add_variable("pos", cur_pos);
+    expr.add_variable("fs", fs);
+    expr.add_variable("x", x);
+    expr.add_variable("px", px);
+    expr.add_variable("po", po);
+    expr.add_variable("a", a);
+    expr.add_variable("b", b);
+    expr.add_variable("c", c);
+    expr.add_variable("pa", pa);
+    expr.add_variable("pb", pb);
+    expr.add_variable("pc", pc);
+    expr.add_variable("m1", m1);
+    expr.add_variable("m2", m2);
+    expr.add_variable("m3", m3);
+    expr.add_constants();
+    expr.register_symbol_table();
+  }
+
+  ossia::math_expression expr;
+};
+
+void setInputs(Nodes::MathValueVariables& v, int i)
+{
+  v.cur_time = 10. * i;
+  v.cur_deltatime = 0.5;
+  v.cur_pos = 0.1 * i;
+  v.x = 0.25 * i - 1.;
+  v.px = 0.3;
+  v.a = 0.5;
+  v.b = 2.;
+  v.c = -0.75;
+}
+}
+
+TEST_CASE("Compiled value kernels match the interpreter", "[MathJit]")
+{
+  llvm::InitializeNativeTarget();
+  llvm::InitializeNativeTargetAsmPrinter();
+  llvm::InitializeNativeTargetAsmParser();
+
+  const std::string expressions[]{
+      "a + b * c - x / 4",
+      "sin(t) * 2 + pow(x, 2) - sqrt(abs(c))",
+      "clamp(0, x, 1) + min(a, b, c) + max(x, px)",
+      "x > 0 ? x : -x",
+      "if(x > 0.5, 1, -1)",
+      "var s := 0; for(var i := 0; i < 4; i += 1) { s += i * x; }; s",
+      "m1 := m1 + x; m1 * a",
+      "sgn(x) * frac(t / 3) + hypot(a, b)",
+  };
+
+  for(const auto& expression : expressions)
+  {
+    INFO(expression);
+    const auto source = Jit::generateMathKernel(expression, Nodes::MathCompiler::Value);
+    REQUIRE(!source.empty());
+
+    Jit::Driver driver{"score_math"};
+    auto f = driver.operator()<Nodes::MathValueKernel>(
+        source, {}, Jit::CompilerOptions{true});
+    auto kernel = f.target<Nodes::MathValueKernel*>();
+    REQUIRE(kernel);
+
+    Interpreter interpreted;
+    REQUIRE(interpreted.expr.set_expression(expression));
+    Nodes::MathValueVariables compiled;
+
+    for(int i = 0; i < 8; i++)
+    {
+      setInputs(interpreted, i);
+      setInputs(compiled, i);
+
+      const double expected = ossia::convert<double>(interpreted.expr.result());
+      const double actual = (**kernel)(compiled);
+      REQUIRE(actual == Approx(expected).margin(1e-9));
+
+      // State variables evolve the same way
+      REQUIRE(compiled.m1 == Approx(interpreted.m1).margin(1e-9));
+    }
+  }
+}
+
+TEST_CASE("Unsupported expressions stay interpreted", "[MathJit]")
+{
+  REQUIRE(Jit::generateMathKernel("foo(x)", Nodes::MathCompiler::Value).empty());
+  REQUIRE(Jit::generateMathKernel("xv[0]", Nodes::MathCompiler::Value).empty());
+  REQUIRE(Jit::generateMathKernel("a + ", Nodes::MathCompiler::Value).empty());
+}
+#endif
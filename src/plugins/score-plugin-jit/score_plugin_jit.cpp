@@ -21,6 +21,11 @@
 #if defined(SCORE_JIT_HAS_TEXGEN)
 #include <score_plugin_gfx.hpp>
 #endif
+#if defined(SCORE_JIT_HAS_MATH)
+#include <MathJit/MathJit.hpp>
+
+#include <score_plugin_fx.hpp>
+#endif
 #if defined(_WIN32)
 #include <windows.h>
 #endif
@@ -36,9 +41,19 @@ score_plugin_jit::score_plugin_jit()
   InitializeNativeTarget();
   InitializeNativeTargetAsmPrinter();
   InitializeNativeTargetAsmParser();
+
+#if defined(SCORE_JIT_HAS_MATH)
+  m_mathCompiler = std::make_unique<Jit::MathCompiler>();
+  Nodes::MathCompiler::setInstance(m_mathCompiler.get());
+#endif
 }
 
-score_plugin_jit::~score_plugin_jit() { }
+score_plugin_jit::~score_plugin_jit()
+{
+#if defined(SCORE_JIT_HAS_MATH)
+  Nodes::MathCompiler::setInstance(nullptr);
+#endif
+}
 
 std::vector<std::unique_ptr<score::InterfaceBase>> score_plugin_jit::factories(
     const score::ApplicationContext& ctx, const score::InterfaceKey& key) const
@@ -107,6 +122,10 @@ std::vector<score::PluginKey> score_plugin_jit::required() const
 #if defined(SCORE_JIT_HAS_TEXGEN)
         ,
         score_plugin_gfx::static_key()
+#endif
+#if defined(SCORE_JIT_HAS_MATH)
+        ,
+        score_plugin_fx::static_key()
 #endif
             ,
         score_plugin_library::static_key()
@@ -8,9 +8,15 @@
 
 #include <QObject>
 
+#include <memory>
 #include <utility>
 #include <vector>
 
+namespace Jit
+{
+class MathCompiler;
+}
+
 class score_plugin_jit final
     : public score::Plugin_QtInterface
     , public score::FactoryInterface_QtInterface
@@ -36,4 +42,8 @@ private:
   make_guiApplicationPlugin(const score::GUIApplicationContext& app) override;
 
   std::vector<score::PluginKey> required() const override;
+
+#if defined(SCORE_JIT_HAS_MATH)
+  std::unique_ptr<Jit::MathCompiler> m_mathCompiler;
+#endif
 };
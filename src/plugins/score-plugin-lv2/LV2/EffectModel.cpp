@@ -3,6 +3,7 @@
 #include "lv2_atom_helpers.hpp"
 
 #include <Process/Dataflow/WidgetInlets.hpp>
+#include <Process/Execution/FeedbackQueue.hpp>
 
 #include <Audio/Settings/Model.hpp>
 #include <Execution/DocumentPlugin.hpp>
@@ -695,7 +696,8 @@ void on_finish::operator()()
   if(!p)
     return;
 
-  p->in_edit([s = self] {
+  // The values are read when applying the update: only the latest one matters
+  p->system().feedbackQueue.enqueue(p.get(), [s = self] {
     auto p = s.lock();
 
     if(!p)
@@ -5,10 +5,12 @@
 
 #include <score/tools/Debug.hpp>
 
+#include <ossia/detail/algorithms.hpp>
 #include <ossia/detail/variant.hpp>
 
 #include <QHash>
 
+#include <algorithm>
 #include <cmath>
 #include <stdio.h>
 #include <stdlib.h>
@@ -418,16 +420,28 @@ namespace Media
 AudioDecoder::AudioDecoder(int rate)
     : convertedSampleRate{rate}
 {
-  connect(
-      this, &AudioDecoder::startDecode, this, &AudioDecoder::on_startDecode,
-      Qt::QueuedConnection);
 }
 
 AudioDecoder::~AudioDecoder()
 {
-  m_decodeThread.exit();
-  while(m_decodeThread.isRunning())
-    ;
+  m_cancel = true;
+  if(m_job)
+    DecodingPool::instance().cancel(m_job);
+}
+
+void AudioDecoder::setPriority(DecodingPool::Priority p)
+{
+  std::lock_guard l{m_mutex};
+  if(p <= m_priority)
+    return;
+
+  m_priority = p;
+
+  auto& pool = DecodingPool::instance();
+  if(m_job)
+    pool.setPriority(m_job, p);
+  for(const auto& job : m_chunkJobs)
+    pool.setPriority(job, p);
 }
 
 struct AVCodecContext_Free
@@ -487,6 +501,74 @@ AVFormatContext_ptr open_audio(const QString& path)
 #endif
 }
 
+struct AudioStream
+{
+  AVFormatContext_ptr format;
+  AVCodecContext_ptr codec;
+  AVStream* stream{};
+};
+
+static AudioStream open_audio_stream(const QString& path)
+{
+  AudioStream res;
+#if SCORE_HAS_LIBAV
+  res.format = open_audio(path);
+
+  auto ret = avformat_find_stream_info(res.format.get(), nullptr);
+  if(ret != 0)
+    throw std::runtime_error("Couldn't find stream information");
+
+  // Find the first audio stream
+  for(std::size_t i = 0; i < res.format->nb_streams; i++)
+  {
+    if(res.format->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_AUDIO
+       && !res.stream)
+    {
+      res.stream = res.format->streams[i];
+    }
+    else
+    {
+      res.format->streams[i]->discard = AVDISCARD_ALL;
+    }
+  }
+
+  if(!res.stream)
+    throw std::runtime_error("Couldn't find any audio stream");
+
+  auto codec = avcodec_find_decoder(res.stream->codecpar->codec_id);
+  if(!codec)
+    throw std::runtime_error("Couldn't find codec");
+
+  res.codec.reset(avcodec_alloc_context3(codec));
+  if(!res.codec)
+    throw std::runtime_error("Couldn't allocate codec context");
+
+  ret = avcodec_parameters_to_context(res.codec.get(), res.stream->codecpar);
+  if(ret != 0)
+    throw std::runtime_error("Couldn't copy codec data");
+
+  ret = avcodec_open2(res.codec.get(), codec, nullptr);
+  if(ret != 0)
+    throw std::runtime_error("Couldn't open codec");
+#endif
+  return res;
+}
+
+#if SCORE_HAS_LIBAV
+static int read_audio_packet(AudioStream& s, AVPacket& packet)
+{
+  int ret = av_read_frame(s.format.get(), &packet);
+
+  while(ret >= 0 && ret != AVERROR(EOF) && packet.stream_index != s.stream->index)
+  {
+    av_packet_unref(&packet);
+    ret = av_read_frame(s.format.get(), &packet);
+  }
+
+  return ret;
+}
+#endif
+
 std::optional<AudioInfo> AudioDecoder::do_probe(const QString& path)
 {
 #if SCORE_HAS_LIBAV
@@ -528,12 +610,6 @@ std::optional<AudioInfo> AudioDecoder::do_probe(const QString& path)
   return {};
 }
 
-QHash<QString, AudioInfo>& AudioDecoder::database()
-{
-  static QHash<QString, AudioInfo> db;
-  return db;
-}
-
 auto debug_ffmpeg(int ret, QString ctx)
 {
 #if SCORE_HAS_LIBAV
@@ -569,24 +645,16 @@ void AudioDecoder::decode(const QString& path, audio_handle hdl)
 #if SCORE_HAS_LIBAV
   SCORE_ASSERT(hdl);
   AudioInfo info;
-  auto it = database().find(path);
-  if(it == database().end())
+  try
   {
-    try
-    {
-      if(auto res = probe(path))
-        info = *res;
-    }
-    catch(...)
-    {
-      qDebug("Cannot decode without info");
-      finishedDecoding(hdl);
-      return;
-    }
+    if(auto res = probe(path))
+      info = *res;
   }
-  else
+  catch(...)
   {
-    info = *it;
+    qDebug("Cannot decode without info");
+    finishedDecoding(hdl);
+    return;
   }
 
   decoded = 0;
@@ -608,9 +676,11 @@ void AudioDecoder::decode(const QString& path, audio_handle hdl)
   if(data.size() == 0)
     return;
 
-  this->moveToThread(&m_decodeThread);
-  m_decodeThread.start();
-  startDecode(path, hdl);
+  m_cancel = false;
+
+  std::lock_guard l{m_mutex};
+  m_job = DecodingPool::instance().submit(
+      [this, path, hdl] { on_startDecode(path, hdl); }, m_priority);
 #endif
 }
 
@@ -734,162 +804,335 @@ void AudioDecoder::on_startDecode(QString path, audio_handle hdl)
   auto& data = hdl->data;
   try
   {
-    const std::size_t channels = data.size();
+    if(!decodeInChunks(path, data))
+    {
+      decoded = 0;
+      decodeSequential(path, data);
+    }
+  }
+  catch(std::exception& e)
+  {
+    qDebug() << "Decoder error: " << e.what();
+  }
 
-    auto fmt_ctx = open_audio(path);
+  finishedDecoding(hdl);
+#endif
+  return;
+}
 
-    auto ret = avformat_find_stream_info(fmt_ctx.get(), nullptr);
-    if(ret != 0)
-      throw std::runtime_error("Couldn't find stream information");
+bool AudioDecoder::decodeInChunks(const QString& path, audio_array& data)
+{
+#if SCORE_HAS_LIBAV
+  // Resampling is stateful: the chunks could not be stitched back exactly
+  if(convertedSampleRate != fileSampleRate || fileSampleRate <= 0)
+    return false;
+
+  auto& pool = DecodingPool::instance();
+  const int64_t samples = data[0].size();
+  const int64_t chunkSamples = 30 * int64_t(fileSampleRate);
+  const int count
+      = std::clamp(samples / chunkSamples, int64_t(1), int64_t(pool.threadCount()));
+  if(count <= 1)
+    return false;
 
-    AVStream* stream{};
+  {
+    // Only formats for which seeking is cheap and sample-exact can be split.
+    // Lossy codecs need pre-roll after a seek and have encoder delays.
+    auto s = open_audio_stream(path);
+    if(!s.format->pb || !(s.format->pb->seekable & AVIO_SEEKABLE_NORMAL))
+      return false;
+
+    auto desc = avcodec_descriptor_get(s.stream->codecpar->codec_id);
+    if(!desc || !(desc->props & AV_CODEC_PROP_LOSSLESS))
+      return false;
+  }
 
-    // Find the first audio stream
-    for(std::size_t i = 0; i < fmt_ctx->nb_streams; i++)
+  std::vector<char> success(count);
+  auto run_chunk = [this, &path, &data, &success](int i) {
+    try
     {
-      if(fmt_ctx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_AUDIO && !stream)
-      {
-        stream = fmt_ctx->streams[i];
-      }
-      else
-      {
-        fmt_ctx->streams[i]->discard = AVDISCARD_ALL;
-      }
+      success[i] = decodeRange(path, data, m_chunks[i]);
     }
+    catch(std::exception& e)
+    {
+      qDebug() << "Decoder error: " << e.what();
+    }
+  };
 
-    if(!stream)
-      throw std::runtime_error("Couldn't find any audio stream");
+  std::vector<DecodingPool::JobHandle> jobs;
+  {
+    std::lock_guard l{m_mutex};
+    m_chunks.clear();
+    for(int i = 0; i < count; i++)
+    {
+      const int64_t start = samples * i / count;
+      const int64_t end = samples * (i + 1) / count;
+      m_chunks.push_back({start, end, start});
+    }
 
-    auto codec = avcodec_find_decoder(stream->codecpar->codec_id);
-    if(!codec)
-      throw std::runtime_error("Couldn't find codec");
+    // The first chunk is decoded by the current thread
+    for(int i = 1; i < count; i++)
+      m_chunkJobs.push_back(pool.submit([run_chunk, i] { run_chunk(i); }, m_priority));
+    jobs = m_chunkJobs;
+  }
 
-    AVCodecContext_ptr codec_ctx{avcodec_alloc_context3(codec)};
-    if(!codec_ctx)
-      throw std::runtime_error("Couldn't allocate codec context");
+  run_chunk(0);
+  for(const auto& job : jobs)
+    pool.runOrWait(job);
 
-    ret = avcodec_parameters_to_context(codec_ctx.get(), stream->codecpar);
-    if(ret != 0)
-      throw std::runtime_error("Couldn't copy codec data");
+  {
+    std::lock_guard l{m_mutex};
+    m_chunkJobs.clear();
+    m_chunks.clear();
+  }
 
-    ret = avcodec_open2(codec_ctx.get(), codec, nullptr);
-    if(ret != 0)
-      throw std::runtime_error("Couldn't open codec");
+  if(m_cancel)
+    return true;
 
-    auto decoder = make_decoder(*stream);
+  if(!ossia::all_of(success, [](char ok) { return ok; }))
+  {
+    qDebug() << "Chunked decoding failed, decoding sequentially: " << path;
+    for(auto& channel : data)
+      std::fill(channel.begin(), channel.end(), audio_sample{});
+    return false;
+  }
 
-    // init resampling
-    if(convertedSampleRate != fileSampleRate)
-    {
-      for(std::size_t i = 0; i < channels; ++i)
+  decoded = samples;
+  newData();
+  return true;
+#else
+  return false;
+#endif
+}
+
+void AudioDecoder::chunkProgress(Chunk& chunk, int64_t pos)
+{
+  std::lock_guard l{m_mutex};
+  chunk.decoded = pos;
+
+  // Only the samples before the first chunk which is not finished are available
+  int64_t available = 0;
+  for(const auto& c : m_chunks)
+  {
+    available = c.decoded;
+    if(c.decoded < c.end)
+      break;
+  }
+  decoded = available;
+}
+
+bool AudioDecoder::decodeRange(const QString& path, audio_array& data, Chunk& chunk)
+{
+#if SCORE_HAS_LIBAV
+  auto s = open_audio_stream(path);
+  auto stream = s.stream;
+  const int64_t start_time
+      = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+  const AVRational sample_tb{1, fileSampleRate};
+
+  if(chunk.start > 0)
+  {
+    const auto ts = start_time + av_rescale_q(chunk.start, sample_tb, stream->time_base);
+    if(av_seek_frame(s.format.get(), stream->index, ts, AVSEEK_FLAG_BACKWARD) < 0)
+      return false;
+  }
+
+  enum FrameResult
+  {
+    Continue,
+    Finished,
+    Failed
+  };
+
+  return ossia::visit(
+      [&](auto& dec) {
+    AVPacket packet;
+    AVFrame_ptr frame{av_frame_alloc()};
+    audio_array tmp(data.size());
+    bool first = true;
+    int update = 0;
+
+    // Copies the part of the frame which is inside the chunk
+    auto copy_frame = [&]() -> FrameResult {
+      const int64_t ts = frame->best_effort_timestamp;
+      if(ts == AV_NOPTS_VALUE)
+        return Failed;
+
+      const int64_t frame_start
+          = av_rescale_q(ts - start_time, stream->time_base, sample_tb);
+      const int64_t frame_end = frame_start + frame->nb_samples;
+
+      // The seek went too far: samples would be missing at the start of the chunk
+      if(std::exchange(first, false) && frame_start > chunk.start)
+        return Failed;
+
+      const int64_t begin = std::max(frame_start, chunk.start);
+      const int64_t end = std::min(frame_end, chunk.end);
+      if(begin < end)
       {
-        SwrContext* swr = swr_alloc_set_opts(
-            nullptr, AV_CH_LAYOUT_MONO, AV_SAMPLE_FMT_FLT, convertedSampleRate,
-            AV_CH_LAYOUT_MONO, AV_SAMPLE_FMT_FLT, fileSampleRate, 0, nullptr);
-        swr_init(swr);
-        resampler.push_back(swr);
+        if(begin == frame_start && end == frame_end)
+        {
+          dec(data, begin, frame->extended_data, frame->nb_samples);
+        }
+        else
+        {
+          for(auto& channel : tmp)
+            channel.resize(frame->nb_samples);
+          dec(tmp, 0, frame->extended_data, frame->nb_samples);
+
+          for(std::size_t i = 0; i < data.size(); i++)
+            std::copy_n(
+                tmp[i].begin() + (begin - frame_start), end - begin,
+                data[i].begin() + begin);
+        }
+
+        chunkProgress(chunk, end);
+        if((++update % 512) == 0)
+          newData();
       }
-    }
 
-    auto read_frame = [&](AVPacket& packet) {
-      int ret{};
-      ret = av_read_frame(fmt_ctx.get(), &packet);
+      return frame_end >= chunk.end ? Finished : Continue;
+    };
 
-      while(ret >= 0 && ret != AVERROR(EOF) && packet.stream_index != stream->index)
+    auto receive_frames = [&]() -> FrameResult {
+      while(avcodec_receive_frame(s.codec.get(), frame.get()) == 0)
       {
-        av_packet_unref(&packet);
-        ret = av_read_frame(fmt_ctx.get(), &packet);
+        if(auto res = copy_frame(); res != Continue)
+          return res;
       }
-
-      return ret;
+      return Continue;
     };
-    // decoding
-    ossia::visit(
-        [&](auto& dec) {
-      AVPacket packet;
-      AVFrame_ptr frame{av_frame_alloc()};
 
-      ret = read_frame(packet);
+    int ret = 0;
+    while(!m_cancel && (ret = read_audio_packet(s, packet)) >= 0)
+    {
+      ret = avcodec_send_packet(s.codec.get(), &packet);
+      av_packet_unref(&packet);
+      debug_ffmpeg(ret, "avcodec_send_packet");
+      if(ret < 0)
+        return false;
+
+      if(auto res = receive_frames(); res != Continue)
+        return res == Finished;
+    }
+
+    // Flush the frames which are still in the decoder
+    avcodec_send_packet(s.codec.get(), nullptr);
+    if(receive_frames() == Failed)
+      return false;
+
+    // The file may be shorter than announced: the remaining samples stay at zero
+    chunkProgress(chunk, chunk.end);
+    return true;
+      },
+      make_decoder(*stream));
+#else
+  return false;
+#endif
+}
+
+void AudioDecoder::decodeSequential(const QString& path, audio_array& data)
+{
+#if SCORE_HAS_LIBAV
+  const std::size_t channels = data.size();
+
+  auto s = open_audio_stream(path);
+  auto& codec_ctx = s.codec;
+  auto stream = s.stream;
+  auto decoder = make_decoder(*stream);
+  int ret{};
 
-      debug_ffmpeg(ret, "av_read_frame");
-      int update = 0;
-      while(ret >= 0)
+  // init resampling
+  if(convertedSampleRate != fileSampleRate)
+  {
+    for(std::size_t i = 0; i < channels; ++i)
+    {
+      SwrContext* swr = swr_alloc_set_opts(
+          nullptr, AV_CH_LAYOUT_MONO, AV_SAMPLE_FMT_FLT, convertedSampleRate,
+          AV_CH_LAYOUT_MONO, AV_SAMPLE_FMT_FLT, fileSampleRate, 0, nullptr);
+      swr_init(swr);
+      resampler.push_back(swr);
+    }
+  }
+
+  auto read_frame = [&](AVPacket& packet) { return read_audio_packet(s, packet); };
+  // decoding
+  ossia::visit(
+      [&](auto& dec) {
+    AVPacket packet;
+    AVFrame_ptr frame{av_frame_alloc()};
+
+    ret = read_frame(packet);
+
+    debug_ffmpeg(ret, "av_read_frame");
+    int update = 0;
+    while(ret >= 0 && !m_cancel)
+    {
+      ret = avcodec_send_packet(codec_ctx.get(), &packet);
+      debug_ffmpeg(ret, "avcodec_send_packet");
+      if(ret == 0)
       {
-        ret = avcodec_send_packet(codec_ctx.get(), &packet);
-        debug_ffmpeg(ret, "avcodec_send_packet");
+        ret = avcodec_receive_frame(codec_ctx.get(), frame.get());
+        debug_ffmpeg(ret, "avcodec_receive_frame");
         if(ret == 0)
         {
-          ret = avcodec_receive_frame(codec_ctx.get(), frame.get());
-          debug_ffmpeg(ret, "avcodec_receive_frame");
-          if(ret == 0)
+          while(ret == 0)
           {
-            while(ret == 0)
+            decodeFrame(dec, data, *frame);
+            ret = avcodec_receive_frame(codec_ctx.get(), frame.get());
+
+            update++;
+            if((update % 512) == 0)
             {
-              decodeFrame(dec, data, *frame);
-              ret = avcodec_receive_frame(codec_ctx.get(), frame.get());
-
-              update++;
-              if((update % 512) == 0)
-              {
-                newData();
-              }
+              newData();
             }
-
-            av_packet_unref(&packet);
-            ret = read_frame(packet);
-            debug_ffmpeg(ret, "av_read_frame");
-            continue;
-          }
-          else if(ret == AVERROR(EAGAIN))
-          {
-            av_packet_unref(&packet);
-            ret = read_frame(packet);
-            debug_ffmpeg(ret, "av_read_frame");
-            continue;
-          }
-          else if(ret == AVERROR_EOF)
-          {
-            decodeFrame(dec, data, *frame);
-            break;
-          }
-          else
-          {
-            break;
           }
+
+          av_packet_unref(&packet);
+          ret = read_frame(packet);
+          debug_ffmpeg(ret, "av_read_frame");
+          continue;
         }
         else if(ret == AVERROR(EAGAIN))
         {
-          ret = avcodec_receive_frame(codec_ctx.get(), frame.get());
-          debug_ffmpeg(ret, "avcodec_receive_frame EAGAIN");
+          av_packet_unref(&packet);
+          ret = read_frame(packet);
+          debug_ffmpeg(ret, "av_read_frame");
+          continue;
+        }
+        else if(ret == AVERROR_EOF)
+        {
+          decodeFrame(dec, data, *frame);
+          break;
         }
         else
         {
           break;
         }
       }
+      else if(ret == AVERROR(EAGAIN))
+      {
+        ret = avcodec_receive_frame(codec_ctx.get(), frame.get());
+        debug_ffmpeg(ret, "avcodec_receive_frame EAGAIN");
+      }
+      else
+      {
+        break;
+      }
+    }
 
-      // Flush
-      ret = avcodec_send_packet(codec_ctx.get(), nullptr);
-
-      decodeRemaining(dec, data, *frame);
-      newData();
-        },
-        decoder);
-
-    // clear resampling
-    for(auto swr : resampler)
-      swr_free(&swr);
-    resampler.clear();
-  }
-  catch(std::exception& e)
-  {
-    qDebug() << "Decoder error: " << e.what();
-  }
+    // Flush
+    ret = avcodec_send_packet(codec_ctx.get(), nullptr);
 
-  finishedDecoding(hdl);
-  m_decodeThread.quit();
+    decodeRemaining(dec, data, *frame);
+    newData();
+      },
+      decoder);
 
+  // clear resampling
+  for(auto swr : resampler)
+    swr_free(&swr);
+  resampler.clear();
 #endif
-  return;
 }
 }
@@ -2,15 +2,17 @@
 #include <Process/TimeValue.hpp>
 
 #include <Media/AudioArray.hpp>
+#include <Media/DecodingPool.hpp>
 
 #include <ossia/detail/flicks.hpp>
 #include <ossia/detail/optional.hpp>
 
-#include <QThread>
+#include <QObject>
 
 #include <score_plugin_media_export.h>
 
 #include <atomic>
+#include <mutex>
 #include <vector>
 #include <verdigris>
 
@@ -61,7 +63,8 @@ public:
   static std::optional<std::pair<AudioInfo, audio_array>>
   decode_synchronous(const QString& path, int rate);
 
-  static QHash<QString, AudioInfo>& database();
+  //! Raises the priority of the decoding jobs of this file in the pool.
+  void setPriority(DecodingPool::Priority p);
 
   int32_t fileSampleRate{};
   int32_t convertedSampleRate{};
@@ -72,17 +75,32 @@ public:
   void newData() W_SIGNAL(newData);
   void finishedDecoding(audio_handle hdl) W_SIGNAL(finishedDecoding, hdl);
 
-  void startDecode(QString str, audio_handle hdl) W_SIGNAL(startDecode, str, hdl);
-
 public:
   void on_startDecode(QString, audio_handle hdl);
-  W_SLOT(on_startDecode);
 
 private:
   static double read_length(const QString& path);
 
-  QThread* m_baseThread{};
-  QThread m_decodeThread;
+  // Part of the file decoded independently, in [start; end)
+  struct Chunk
+  {
+    int64_t start{};
+    int64_t end{};
+    int64_t decoded{};
+  };
+
+  bool decodeInChunks(const QString& path, audio_array& data);
+  bool decodeRange(const QString& path, audio_array& data, Chunk& chunk);
+  void decodeSequential(const QString& path, audio_array& data);
+  void chunkProgress(Chunk& chunk, int64_t pos);
+
+  DecodingPool::JobHandle m_job;
+  std::atomic_bool m_cancel{};
+
+  std::mutex m_mutex;
+  DecodingPool::Priority m_priority{DecodingPool::Background};
+  std::vector<DecodingPool::JobHandle> m_chunkJobs;
+  std::vector<Chunk> m_chunks;
 
   template <typename Decoder>
   void decodeFrame(Decoder dec, audio_array& data, AVFrame& frame);
@@ -0,0 +1,249 @@
+#include "AudioInfoCache.hpp"
+
+#include <Media/MediaFileHandle.hpp>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSemaphore>
+#include <QStandardPaths>
+#include <QThread>
+
+namespace Media
+{
+static constexpr quint32 audio_info_cache_magic = 0x53434149; // "SCAI"
+static constexpr quint32 audio_info_cache_version = 1;
+
+// Explicit probes, which someone waits for, run before the background prefetches
+static constexpr int prefetch_priority = -1;
+static constexpr int probe_priority = 0;
+
+// Marks a pool task as finished even when probing the file throws
+struct AudioInfoCache::TaskGuard
+{
+  AudioInfoCache& cache;
+  ~TaskGuard() { cache.taskFinished(); }
+};
+
+AudioInfoCache& AudioInfoCache::instance()
+{
+  // Leaked on purpose: pending probes may still run during static destruction
+  static auto& cache = *new AudioInfoCache;
+  return cache;
+}
+
+AudioInfoCache::AudioInfoCache()
+{
+  m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+  load();
+}
+
+AudioInfoCache::~AudioInfoCache() = default;
+
+QString AudioInfoCache::cacheFile()
+{
+  const auto dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if(dir.isEmpty())
+    return {};
+
+  QDir::root().mkpath(dir);
+  return QDir{dir}.absoluteFilePath("audio-metadata.bin");
+}
+
+std::optional<AudioInfo> AudioInfoCache::find(const QString& path)
+{
+  {
+    std::lock_guard l{m_mutex};
+    auto it = m_entries.find(path);
+    if(it == m_entries.end())
+      return std::nullopt;
+    if(it->checked)
+      return it->info;
+  }
+
+  // Entries loaded from disk are checked against the file once per session
+  const QFileInfo fi{path};
+  const bool exists = fi.exists();
+  const int64_t size = fi.size();
+  const int64_t modified = fi.lastModified().toMSecsSinceEpoch();
+
+  std::lock_guard l{m_mutex};
+  auto it = m_entries.find(path);
+  if(it == m_entries.end())
+    return std::nullopt;
+
+  if(!exists || it->size != size || it->modified != modified)
+  {
+    m_entries.erase(it);
+    m_dirty = true;
+    return std::nullopt;
+  }
+
+  it->checked = true;
+  return it->info;
+}
+
+void AudioInfoCache::insert(const QString& path, const AudioInfo& info)
+{
+  const QFileInfo fi{path};
+  Entry e{info, fi.size(), fi.lastModified().toMSecsSinceEpoch(), true};
+
+  std::lock_guard l{m_mutex};
+  m_entries.insert(path, std::move(e));
+  m_dirty = true;
+}
+
+void AudioInfoCache::prefetch(const std::vector<QString>& paths)
+{
+  for(const auto& path : paths)
+  {
+    m_pending++;
+    m_pool.start(
+        [this, path] {
+          TaskGuard guard{*this};
+          try
+          {
+            if(!find(path))
+              Media::probe(path);
+          }
+          catch(...)
+          {
+            // Corrupt or unsupported files are just not cached
+          }
+        },
+        prefetch_priority);
+  }
+}
+
+std::vector<std::optional<AudioInfo>>
+AudioInfoCache::probe(const std::vector<QString>& paths)
+{
+  const int N = paths.size();
+  std::vector<std::optional<AudioInfo>> res(N);
+
+  QSemaphore done;
+  int missing = 0;
+  for(int i = 0; i < N; i++)
+  {
+    if((res[i] = find(paths[i])))
+      continue;
+
+    missing++;
+    m_pending++;
+    m_pool.start(
+        [this, &res, &paths, &done, i] {
+          TaskGuard guard{*this};
+          try
+          {
+            res[i] = Media::probe(paths[i]);
+          }
+          catch(...)
+          {
+          }
+          done.release();
+        },
+        probe_priority);
+  }
+
+  done.acquire(missing);
+  return res;
+}
+
+void AudioInfoCache::taskFinished()
+{
+  // Each batch of probes is written to disk once it is done
+  if(--m_pending == 0)
+    save();
+}
+
+void AudioInfoCache::load()
+{
+  const auto path = cacheFile();
+  if(path.isEmpty())
+    return;
+
+  QFile f{path};
+  if(!f.open(QIODevice::ReadOnly))
+    return;
+
+  QDataStream s{&f};
+  s.setVersion(QDataStream::Qt_5_15);
+
+  quint32 magic{}, version{};
+  s >> magic >> version;
+  if(magic != audio_info_cache_magic || version != audio_info_cache_version)
+    return;
+
+  quint64 count{};
+  s >> count;
+
+  QHash<QString, Entry> entries;
+  entries.reserve(count);
+  for(quint64 i = 0; i < count && s.status() == QDataStream::Ok; i++)
+  {
+    QString file;
+    qint64 size{}, modified{};
+    qint32 rate{};
+    qint64 channels{}, length{}, max_length{};
+    bool hasTempo{};
+    double tempo{};
+    s >> file >> size >> modified >> rate >> channels >> length >> max_length
+        >> hasTempo >> tempo;
+
+    Entry e;
+    e.size = size;
+    e.modified = modified;
+    e.info.fileRate = rate;
+    e.info.channels = channels;
+    e.info.fileLength = length;
+    e.info.max_arr_length = max_length;
+    if(hasTempo)
+      e.info.tempo = tempo;
+    entries.insert(file, std::move(e));
+  }
+
+  if(s.status() != QDataStream::Ok)
+    return;
+
+  std::lock_guard l{m_mutex};
+  m_entries = std::move(entries);
+}
+
+void AudioInfoCache::save()
+{
+  std::lock_guard save_lock{m_saveMutex};
+
+  QHash<QString, Entry> entries;
+  {
+    std::lock_guard l{m_mutex};
+    if(!m_dirty)
+      return;
+    m_dirty = false;
+    entries = m_entries;
+  }
+
+  const auto path = cacheFile();
+  if(path.isEmpty())
+    return;
+
+  QSaveFile f{path};
+  if(!f.open(QIODevice::WriteOnly))
+    return;
+
+  QDataStream s{&f};
+  s.setVersion(QDataStream::Qt_5_15);
+  s << audio_info_cache_magic << audio_info_cache_version << quint64(entries.size());
+  for(auto it = entries.cbegin(); it != entries.cend(); ++it)
+  {
+    const Entry& e = it.value();
+    s << it.key() << qint64(e.size) << qint64(e.modified) << qint32(e.info.fileRate)
+      << qint64(e.info.channels) << qint64(e.info.fileLength)
+      << qint64(e.info.max_arr_length) << bool(e.info.tempo)
+      << double(e.info.tempo.value_or(0.));
+  }
+  f.commit();
+}
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <Media/AudioDecoder.hpp>
+
+#include <QHash>
+#include <QString>
+#include <QThreadPool>
+
+#include <score_plugin_media_export.h>
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Media
+{
+/**
+ * @brief Persistent cache of the metadata of audio files.
+ *
+ * Entries are keyed on the path of the file and are invalidated when its
+ * size or modification date changes.
+ * The cache is saved in the cache folder of the user so that files do not
+ * have to be probed again on the next launch.
+ *
+ * Every method is thread-safe.
+ */
+class SCORE_PLUGIN_MEDIA_EXPORT AudioInfoCache
+{
+public:
+  static AudioInfoCache& instance();
+
+  std::optional<AudioInfo> find(const QString& path);
+  void insert(const QString& path, const AudioInfo& info);
+
+  //! Probes the files which are not cached yet, in background threads.
+  void prefetch(const std::vector<QString>& paths);
+
+  //! Probes the files in parallel and waits for the results.
+  std::vector<std::optional<AudioInfo>> probe(const std::vector<QString>& paths);
+
+  //! Writes the cache to disk if it changed.
+  void save();
+
+private:
+  AudioInfoCache();
+  ~AudioInfoCache();
+
+  struct Entry
+  {
+    AudioInfo info;
+    int64_t size{};
+    int64_t modified{};
+
+    // Whether the file was checked for changes during this session
+    bool checked{};
+  };
+
+  static QString cacheFile();
+  void load();
+  void taskFinished();
+  struct TaskGuard;
+
+  std::mutex m_mutex;
+  QHash<QString, Entry> m_entries;
+  bool m_dirty{};
+
+  std::mutex m_saveMutex;
+
+  QThreadPool m_pool;
+  std::atomic_int m_pending{};
+};
+}
@@ -7,6 +7,7 @@
 #include <Scenario/Document/Interval/IntervalModel.hpp>
 #include <Scenario/Process/ScenarioInterface.hpp>
 
+#include <Media/AudioInfoCache.hpp>
 #include <Media/Sound/SoundModel.hpp>
 
 #include <score/application/GUIApplicationContext.hpp>
@@ -28,9 +29,8 @@ ChangeAudioFile::ChangeAudioFile(
     m_olddur = p->duration.defaultDuration();
   }
 
-  const auto& db = AudioDecoder::database();
-  auto& info = db[m_new];
-  m_newdur = info.duration();
+  if(auto info = AudioInfoCache::instance().find(m_new))
+    m_newdur = info->duration();
 
   if(auto itv = qobject_cast<Scenario::IntervalModel*>(model.parent()))
   {
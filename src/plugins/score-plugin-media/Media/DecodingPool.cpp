@@ -0,0 +1,152 @@
+#include "DecodingPool.hpp"
+
+#include <ossia/detail/algorithms.hpp>
+
+#include <QThread>
+
+#include <thread>
+
+namespace Media
+{
+struct DecodingPool::Job
+{
+  std::function<void()> func;
+  Priority priority{};
+  enum
+  {
+    Queued,
+    Running,
+    Done
+  } state{Queued};
+};
+
+DecodingPool& DecodingPool::instance()
+{
+  // Leaked on purpose: decoders may still be destroyed during static destruction
+  static auto& pool = *new DecodingPool;
+  return pool;
+}
+
+DecodingPool::DecodingPool()
+{
+  // Keep one core for the GUI and one for the audio thread
+  m_threadCount = std::max(1, QThread::idealThreadCount() - 2);
+}
+
+DecodingPool::~DecodingPool() = default;
+
+DecodingPool::JobHandle DecodingPool::submit(std::function<void()> func, Priority p)
+{
+  auto job = std::make_shared<Job>();
+  job->func = std::move(func);
+  job->priority = p;
+
+  {
+    std::lock_guard l{m_mutex};
+
+    // Threads are only started on the first decode
+    if(!m_started)
+    {
+      for(int i = 0; i < m_threadCount; i++)
+        std::thread{[this] { worker(); }}.detach();
+      m_started = true;
+    }
+
+    m_queues[p].push_back(job);
+  }
+  m_jobAvailable.notify_one();
+  return job;
+}
+
+void DecodingPool::setPriority(const JobHandle& job, Priority p)
+{
+  std::lock_guard l{m_mutex};
+  if(job->state != Job::Queued || job->priority >= p)
+    return;
+
+  ossia::remove_erase(m_queues[job->priority], job);
+  job->priority = p;
+  m_queues[p].push_back(job);
+}
+
+bool DecodingPool::unqueue(const JobHandle& job)
+{
+  if(job->state != Job::Queued)
+    return false;
+
+  ossia::remove_erase(m_queues[job->priority], job);
+  return true;
+}
+
+void DecodingPool::cancel(const JobHandle& job)
+{
+  std::unique_lock l{m_mutex};
+  if(unqueue(job))
+  {
+    job->state = Job::Done;
+    return;
+  }
+
+  m_jobDone.wait(l, [&] { return job->state == Job::Done; });
+}
+
+void DecodingPool::runOrWait(const JobHandle& job)
+{
+  {
+    std::unique_lock l{m_mutex};
+    if(!unqueue(job))
+    {
+      m_jobDone.wait(l, [&] { return job->state == Job::Done; });
+      return;
+    }
+    job->state = Job::Running;
+  }
+
+  run(job);
+}
+
+void DecodingPool::run(const JobHandle& job)
+{
+  try
+  {
+    job->func();
+  }
+  catch(...)
+  {
+  }
+
+  {
+    std::lock_guard l{m_mutex};
+    job->state = Job::Done;
+    job->func = {};
+  }
+  m_jobDone.notify_all();
+}
+
+void DecodingPool::worker()
+{
+  for(;;)
+  {
+    JobHandle job;
+    {
+      std::unique_lock l{m_mutex};
+      m_jobAvailable.wait(l, [this] {
+        return ossia::any_of(m_queues, [](const auto& q) { return !q.empty(); });
+      });
+
+      for(int p = Playing; p >= Background; p--)
+      {
+        if(!m_queues[p].empty())
+        {
+          job = std::move(m_queues[p].front());
+          m_queues[p].pop_front();
+          break;
+        }
+      }
+      job->state = Job::Running;
+    }
+
+    run(job);
+  }
+}
+}
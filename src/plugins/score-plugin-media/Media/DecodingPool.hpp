@@ -0,0 +1,68 @@
+#pragma once
+#include <score_plugin_media_export.h>
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace Media
+{
+/**
+ * @brief Bounded pool of threads shared by the audio decoders.
+ *
+ * Jobs run by decreasing priority, then in submission order.
+ * The priority of a job can be raised while it waits, e.g. when its sound
+ * becomes visible or is about to be played.
+ */
+class SCORE_PLUGIN_MEDIA_EXPORT DecodingPool
+{
+public:
+  enum Priority : int
+  {
+    Background = 0,
+    Visible = 1,
+    Playing = 2
+  };
+
+  struct Job;
+  using JobHandle = std::shared_ptr<Job>;
+
+  static DecodingPool& instance();
+
+  int threadCount() const noexcept { return m_threadCount; }
+
+  JobHandle submit(std::function<void()> func, Priority p);
+  void setPriority(const JobHandle& job, Priority p);
+
+  //! Removes the job if it has not started yet, otherwise waits for it.
+  void cancel(const JobHandle& job);
+
+  /**
+   * @brief Runs the job on the calling thread if it has not started yet,
+   * otherwise waits for it.
+   *
+   * Used by jobs which split their work in sub-jobs, so that they never
+   * block a thread of the pool waiting for a job which is still queued.
+   */
+  void runOrWait(const JobHandle& job);
+
+private:
+  DecodingPool();
+  ~DecodingPool();
+
+  void worker();
+  bool unqueue(const JobHandle& job);
+  void run(const JobHandle& job);
+
+  std::mutex m_mutex;
+  std::condition_variable m_jobAvailable;
+  std::condition_variable m_jobDone;
+  std::array<std::deque<JobHandle>, 3> m_queues;
+
+  int m_threadCount{};
+  bool m_started{};
+};
+}
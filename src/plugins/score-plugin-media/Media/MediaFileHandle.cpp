@@ -1,6 +1,7 @@
 #include "MediaFileHandle.hpp"
 
 #include <Media/AudioDecoder.hpp>
+#include <Media/AudioInfoCache.hpp>
 #include <Media/RMSData.hpp>
 
 #include <score/application/GUIApplicationContext.hpp>
@@ -199,14 +200,17 @@ const RMSData& AudioFile::rms() const
 
 std::optional<double> AudioFile::knownTempo() const noexcept
 {
-  auto& db = AudioDecoder::database();
-  if(auto it = db.find(this->m_file); it != db.end())
-  {
-    return it->tempo;
-  }
+  if(auto info = AudioInfoCache::instance().find(this->m_file))
+    return info->tempo;
   return {};
 }
 
+void AudioFile::setDecodingPriority(DecodingPool::Priority p)
+{
+  if(auto r = m_impl.target<libav_ptr>())
+    (*r)->decoder.setPriority(p);
+}
+
 template <typename Fun_T, typename T>
 struct FrameComputer
 {
@@ -723,6 +727,69 @@ void writeAudioArrayToFile(const QString& path, const ossia::audio_array& arr, i
   f.flush();
 }
 
+struct AudioFileWriter::Impl
+{
+  QFile file;
+  drwav wav;
+};
+
+AudioFileWriter::AudioFileWriter(const QString& path, int channels, int fs)
+    : m_channels{channels}
+{
+  auto impl = std::make_unique<Impl>();
+  impl->file.setFileName(path);
+  if(!impl->file.open(QIODevice::WriteOnly))
+  {
+    qDebug() << "Not writing" << path << ": cannot open file for writing.";
+    return;
+  }
+
+  drwav_data_format format;
+  format.container = drwav_container_riff;
+  format.format = DR_WAVE_FORMAT_IEEE_FLOAT;
+  format.channels = channels;
+  format.sampleRate = fs;
+  format.bitsPerSample = 32;
+
+  auto onWrite = [](void* pUserData, const void* pData, size_t bytesToWrite) -> size_t {
+    auto& file = *(QFile*)pUserData;
+    return file.write(reinterpret_cast<const char*>(pData), bytesToWrite);
+  };
+
+  // The sizes in the header are written on close
+  auto onSeek
+      = [](void* pUserData, int offset, drwav_seek_origin origin) -> drwav_bool32 {
+    auto& file = *(QFile*)pUserData;
+    return file.seek(origin == drwav_seek_origin_start ? offset : file.pos() + offset);
+  };
+
+  if(!drwav_init_write(
+         &impl->wav, &format, onWrite, onSeek, &impl->file,
+         &ossia::drwav_handle::drwav_allocs))
+  {
+    qDebug() << "Not writing" << path << ": could not initialize writer.";
+    return;
+  }
+
+  m_impl = std::move(impl);
+}
+
+AudioFileWriter::~AudioFileWriter()
+{
+  if(m_impl)
+  {
+    drwav_uninit(&m_impl->wav);
+    m_impl->file.flush();
+  }
+}
+
+bool AudioFileWriter::write(const float* data, int64_t frames)
+{
+  if(!m_impl)
+    return false;
+  return drwav_write_pcm_frames(&m_impl->wav, frames, data) == uint64_t(frames);
+}
+
 std::optional<AudioInfo> probe_drwav(const QFileInfo& fi)
 {
   QFile f{fi.absoluteFilePath()};
@@ -755,42 +822,27 @@ std::optional<AudioInfo> probe_drwav(const QFileInfo& fi)
 std::optional<AudioInfo> probe(const QString& path)
 {
   // FIXME we have to reload everything when the sample rate changes !!
-  auto it = AudioDecoder::database().find(path);
-  if(it == AudioDecoder::database().end())
-  {
-    QFileInfo fi{path};
-    if(!fi.exists() || !fi.isFile() || !fi.isReadable())
-      return std::nullopt;
+  auto& cache = AudioInfoCache::instance();
+  if(auto info = cache.find(path))
+    return info;
 
-    const auto& suffix = fi.suffix().toLower();
-    if(suffix == "wav" || suffix == "w64")
-    {
-      if(auto ret = probe_drwav(fi))
-      {
-        AudioDecoder::database().insert(path, *ret);
-        return ret;
-      }
-    }
-    else if(suffix == "aif" || suffix == "aiff")
-    {
-      if(auto ret = SndfileDecoder::do_probe(path))
-      {
-        AudioDecoder::database().insert(path, *ret);
-        return ret;
-      }
-    }
-
-    if(auto ret = AudioDecoder::do_probe(path))
-    {
-      AudioDecoder::database().insert(path, *ret);
-      return ret;
-    }
+  QFileInfo fi{path};
+  if(!fi.exists() || !fi.isFile() || !fi.isReadable())
     return std::nullopt;
-  }
-  else
-  {
-    return *it;
-  }
+
+  std::optional<AudioInfo> ret;
+  const auto& suffix = fi.suffix().toLower();
+  if(suffix == "wav" || suffix == "w64")
+    ret = probe_drwav(fi);
+  else if(suffix == "aif" || suffix == "aiff")
+    ret = SndfileDecoder::do_probe(path);
+
+  if(!ret)
+    ret = AudioDecoder::do_probe(path);
+
+  if(ret)
+    cache.insert(path, *ret);
+  return ret;
 }
 
 }
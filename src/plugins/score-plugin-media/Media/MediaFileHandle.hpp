@@ -15,6 +15,7 @@
 #include <score_plugin_media_export.h>
 
 #include <array>
+#include <memory>
 #include <verdigris>
 namespace score
 {
@@ -184,6 +185,9 @@ public:
 
   std::optional<double> knownTempo() const noexcept;
 
+  //! Files shown or played get decoded before the others.
+  void setDecodingPriority(DecodingPool::Priority p);
+
 private:
   void load_ffmpeg(int rate);
   void load_drwav();
@@ -221,6 +225,32 @@ private:
 SCORE_PLUGIN_MEDIA_EXPORT
 void writeAudioArrayToFile(const QString& path, const ossia::audio_array& arr, int fs);
 
+/**
+ * @brief Saves an audio file as .wav (in 32-bit float format) progressively,
+ * e.g. while it is being rendered.
+ *
+ * The header is completed when the writer is destroyed.
+ */
+class SCORE_PLUGIN_MEDIA_EXPORT AudioFileWriter
+{
+public:
+  AudioFileWriter(const QString& path, int channels, int fs);
+  ~AudioFileWriter();
+  AudioFileWriter(const AudioFileWriter&) = delete;
+  AudioFileWriter& operator=(const AudioFileWriter&) = delete;
+
+  bool isOpen() const noexcept { return bool(m_impl); }
+  int channels() const noexcept { return m_channels; }
+
+  //! Writes frames of channels() interleaved samples.
+  bool write(const float* data, int64_t frames);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+  int m_channels{};
+};
+
 std::optional<double> estimateTempo(const AudioFile& file);
 std::optional<double> estimateTempo(const QString& filePath);
 
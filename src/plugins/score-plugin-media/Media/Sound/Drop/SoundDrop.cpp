@@ -4,6 +4,7 @@
 
 #include <Audio/Settings/Model.hpp>
 #include <Media/AudioDecoder.hpp>
+#include <Media/AudioInfoCache.hpp>
 #include <Media/Commands/ChangeAudioFile.hpp>
 #include <Media/Sound/SoundModel.hpp>
 
@@ -18,20 +19,24 @@ namespace Sound
 DroppedAudioFiles::DroppedAudioFiles(
     const score::DocumentContext& ctx, const QMimeData& mime)
 {
-  const auto& urls = mime.urls();
-  for(const auto& url : urls)
+  std::vector<QString> filenames;
+  for(const auto& url : mime.urls())
   {
     QString filename = url.toLocalFile();
-    if(!AudioFile::isSupported(QFile{filename}))
-      continue;
+    if(AudioFile::isSupported(QFile{filename}))
+      filenames.push_back(std::move(filename));
+  }
 
-    if(auto info_opt = probe(filename))
+  // The files which were not probed yet are probed in parallel
+  const auto infos = AudioInfoCache::instance().probe(filenames);
+  for(std::size_t i = 0; i < filenames.size(); i++)
+  {
+    if(const auto& info = infos[i])
     {
-      auto info = *info_opt;
-      if(info.channels > 0 && info.fileLength > 0)
+      if(info->channels > 0 && info->fileLength > 0)
       {
-        auto dur = info.duration();
-        files.emplace_back(std::make_pair(filename, dur));
+        auto dur = info->duration();
+        files.emplace_back(std::make_pair(filenames[i], dur));
         maxDuration = std::max(maxDuration, dur);
       }
     }
@@ -284,6 +284,7 @@ SoundComponent::SoundComponent(
 
   if(auto& file = element.file())
   {
+    file->setDecodingPriority(Media::DecodingPool::Playing);
     file->on_finishedDecoding.connect<&SoundComponent::Recomputer::recompute>(
         m_recomputer);
   }
@@ -295,6 +296,7 @@ void SoundComponent::on_fileChanged()
 
   if(auto& file = process().file())
   {
+    file->setDecodingPriority(Media::DecodingPool::Playing);
     if(file->finishedDecoding())
     {
       recompute();
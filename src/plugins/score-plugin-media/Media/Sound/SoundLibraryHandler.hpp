@@ -6,6 +6,7 @@
 #include <Audio/Settings/Model.hpp>
 #include <Engine/ApplicationPlugin.hpp>
 #include <Library/LibraryInterface.hpp>
+#include <Media/AudioInfoCache.hpp>
 #include <Media/MediaFileHandle.hpp>
 
 #include <score/tools/ThreadPool.hpp>
@@ -133,6 +134,13 @@ class LibraryHandler final : public Library::LibraryInterface
   {
     return new AudioPreviewWidget{path, parent};
   }
+
+  void addPath(std::string_view path) override
+  {
+    // So that the samples of the library can be dropped without waiting
+    AudioInfoCache::instance().prefetch(
+        {QString::fromUtf8(path.data(), path.size())});
+  }
 };
 
 }
@@ -23,11 +23,15 @@ LayerPresenter::LayerPresenter(
     , m_view{view}
 {
   con(layer, &ProcessModel::fileChanged, this, [&]() {
+    if(auto& file = layer.file())
+      file->setDecodingPriority(DecodingPool::Visible);
     m_view->setData(layer.file());
     updateTempo();
     m_view->recompute(m_ratio);
   });
 
+  if(auto& file = layer.file())
+    file->setDecodingPriority(DecodingPool::Visible);
   m_view->setData(layer.file());
   updateTempo();
   //m_view->recompute(m_ratio);
@@ -33,6 +33,40 @@ inline bool formatNeedsDecoding(AVPixelFormat fmt)
 #endif
     case AV_PIX_FMT_GRAY8:
     case AV_PIX_FMT_GRAY16:
+
+    case AV_PIX_FMT_NV12:
+    case AV_PIX_FMT_NV21:
+    case AV_PIX_FMT_P010:
+
+    case AV_PIX_FMT_YUV444P:
+    case AV_PIX_FMT_YUVJ444P:
+    case AV_PIX_FMT_YUV420P10:
+    case AV_PIX_FMT_YUV422P10:
+    case AV_PIX_FMT_YUV444P10:
+    case AV_PIX_FMT_YUV420P12:
+    case AV_PIX_FMT_YUV422P12:
+    case AV_PIX_FMT_YUV444P12:
+
+    case AV_PIX_FMT_YUVA420P:
+    case AV_PIX_FMT_YUVA422P:
+    case AV_PIX_FMT_YUVA444P:
+    case AV_PIX_FMT_YUVA420P10:
+    case AV_PIX_FMT_YUVA422P10:
+    case AV_PIX_FMT_YUVA444P10:
+#if defined(AV_PIX_FMT_YUVA444P12)
+    case AV_PIX_FMT_YUVA422P12:
+    case AV_PIX_FMT_YUVA444P12:
+#endif
+
+    case AV_PIX_FMT_RGB48:
+    case AV_PIX_FMT_RGBA64:
+
+    case AV_PIX_FMT_GBRP:
+    case AV_PIX_FMT_GBRP10:
+    case AV_PIX_FMT_GBRP12:
+    case AV_PIX_FMT_GBRAP:
+    case AV_PIX_FMT_GBRAP10:
+    case AV_PIX_FMT_GBRAP12:
       return false;
 
     // Other formats get rgb'd
@@ -3,6 +3,7 @@
 #include <Scenario/Application/ScenarioApplicationPlugin.hpp>
 
 #include <Library/LibraryInterface.hpp>
+#include <Media/AudioInfoCache.hpp>
 #include <Media/Effect/Settings/Factory.hpp>
 #include <Media/Inspector/Factory.hpp>
 #include <Media/Libav.hpp>
@@ -59,7 +60,10 @@ score_plugin_media::score_plugin_media()
 #endif
 }
 
-score_plugin_media::~score_plugin_media() { }
+score_plugin_media::~score_plugin_media()
+{
+  Media::AudioInfoCache::instance().save();
+}
 
 std::pair<const CommandGroupKey, CommandGeneratorMap> score_plugin_media::make_commands()
 {
@@ -11,6 +11,7 @@
 #include <score/command/AggregateCommand.hpp>
 #include <score/command/PropertyCommand.hpp>
 #include <score/document/DocumentContext.hpp>
+#include <score/model/path/PathSerialization.hpp>
 #include <score/plugins/SerializableHelpers.hpp>
 #include <score/tools/IdentifierGeneration.hpp>
 
@@ -94,3 +95,6 @@ private:
   Dataflow::SerializedCables m_old_cables, m_new_cables;
 };
 }
+
+PROPERTY_COMMAND_T(Nodal, SetFrozen, Model::p_frozen, "Freeze nodes")
+SCORE_COMMAND_DECL_T(Nodal::SetFrozen)
@@ -6,22 +6,147 @@
 
 #include <Scenario/Document/Interval/IntervalExecutionHelpers.hpp>
 
+#include <Media/AudioDecoder.hpp>
+#include <Media/DecodingPool.hpp>
+#include <Nodal/Freeze.hpp>
 #include <Nodal/Process.hpp>
 
-#include <score/application/ApplicationContext.hpp>
 #include <score/document/DocumentContext.hpp>
 #include <score/tools/Bind.hpp>
+#include <score/widgets/MessageBox.hpp>
 
 #include <ossia/dataflow/node_chain_process.hpp>
 #include <ossia/dataflow/nodes/forward_node.hpp>
 #include <ossia/dataflow/port.hpp>
 #include <ossia/detail/flat_set.hpp>
+
+#include <QDebug>
+#include <QFile>
+
+#include <algorithm>
+#include <cmath>
 namespace ossia
 {
+/**
+ * @brief Output node of the nodal processes.
+ *
+ * Forwards the output of the nodes, and can either record it for freezing,
+ * or replace it by a recording when the process is frozen.
+ */
+struct freeze_node final : public ossia::nodes::forward_node
+{
+  void run(const ossia::token_request& t, ossia::exec_state_facade e) noexcept override
+  {
+    if(frozen)
+    {
+      if(playback.empty())
+        decoded.try_dequeue(playback);
+      play(t, e);
+    }
+    else
+    {
+      forward_node::run(t, e);
+      if(recording)
+        record(t, e);
+    }
+  }
+
+  void play(const ossia::token_request& t, ossia::exec_state_facade e) noexcept
+  {
+    const auto [tick_start, d] = e.timings(t);
+    const int64_t pos = t.prev_date.impl * e.modelToSamples();
+    const auto& src = playback;
+
+    auto& out = audio_out.target<ossia::audio_port>()->get();
+    out.resize(src.size());
+    for(std::size_t c = 0; c < src.size(); c++)
+    {
+      auto& channel = out[c];
+      channel.resize(e.bufferSize());
+
+      const int64_t frames = src[c].size();
+      for(int64_t i = std::max(int64_t(0), -pos); i < d && pos + i < frames; i++)
+        channel[tick_start + i] = src[c][pos + i];
+    }
+  }
+
+  void record(const ossia::token_request& t, ossia::exec_state_facade e) noexcept
+  {
+    // Only a contiguous rendering at the nominal speed can be played back
+    if(t.speed != 1.)
+      return;
+
+    auto& rec = *recording;
+    const auto [tick_start, d] = e.timings(t);
+    const int64_t pos = t.prev_date.impl * e.modelToSamples();
+    if(pos > rec.recorded || pos + d <= rec.recorded || rec.recorded >= rec.frames
+       || rec.overrun.load(std::memory_order_relaxed))
+      return;
+
+    const auto& in = audio_out.target<ossia::audio_port>()->get();
+    const std::size_t channels = std::clamp<std::size_t>(
+        in.size(), 1, ossia::freeze_recording::max_channels);
+
+    const int64_t end = std::min(pos + d, rec.frames);
+    while(rec.recorded < end)
+    {
+      auto* chunk = rec.current;
+      if(chunk && chunk->channels != channels)
+      {
+        rec.filled.enqueue(chunk);
+        chunk = rec.current = nullptr;
+      }
+
+      if(!chunk)
+      {
+        // The chunks are recycled by the writer thread
+        if(!rec.free.try_dequeue(chunk))
+        {
+          rec.overrun.store(true, std::memory_order_relaxed);
+          return;
+        }
+        chunk->channels = channels;
+        chunk->frames = 0;
+        rec.current = chunk;
+      }
+
+      const int64_t capacity = int64_t(chunk->samples.size() / channels);
+      const int64_t n = std::min(end - rec.recorded, capacity - chunk->frames);
+      const int64_t first = tick_start + (rec.recorded - pos);
+      float* out = chunk->samples.data() + chunk->frames * channels;
+      for(int64_t i = first; i < first + n; i++)
+        for(std::size_t c = 0; c < channels; c++)
+          *out++ = c < in.size() && i < int64_t(in[c].size()) ? in[c][i] : 0.f;
+
+      chunk->frames += n;
+      rec.recorded += n;
+      if(chunk->frames == capacity)
+      {
+        rec.filled.enqueue(chunk);
+        rec.current = nullptr;
+      }
+    }
+
+    if(rec.recorded == rec.frames)
+    {
+      if(rec.current)
+        rec.filled.enqueue(rec.current);
+      rec.current = nullptr;
+      rec.complete.store(true, std::memory_order_release);
+    }
+  }
+
+  // Given by the decoding thread, then played back
+  ossia::spsc_queue<ossia::audio_array, 2> decoded;
+  ossia::audio_array playback;
+  bool frozen{};
+
+  std::shared_ptr<freeze_recording> recording;
+};
 
 struct node_graph_process final : public looping_process<node_graph_process>
 {
-  node_graph_process() { node = std::make_shared<ossia::nodes::forward_node>(); }
+  node_graph_process() { node = std::make_shared<ossia::freeze_node>(); }
 
   void state_impl(const ossia::token_request& req)
   {
@@ -127,10 +252,69 @@ NodalExecutorBase::NodalExecutorBase(
   m_ossia_process = std::make_shared<ossia::node_graph_process>();
   m_ossia_process->node->prepare(*ctx.execState);
   this->node = m_ossia_process->node;
+
+  if(element.frozen())
+    setupFreeze();
 }
 
 NodalExecutorBase::~NodalExecutorBase() { }
 
+void NodalExecutorBase::setupFreeze()
+{
+  auto& fz = static_cast<ossia::freeze_node&>(*this->node);
+  const int rate = system().execState->sampleRate;
+  m_freezeFile = freezeCacheFile(process(), rate);
+  if(m_freezeFile.isEmpty())
+    return;
+
+  if(QFile::exists(m_freezeFile))
+  {
+    // The nodes are not instantiated at all: the freeze node stays silent
+    // until the rendered file is decoded.
+    fz.frozen = true;
+    m_playingFreeze = true;
+    auto decode = [node = std::static_pointer_cast<ossia::freeze_node>(this->node),
+                   file = m_freezeFile, rate] {
+      if(auto res = Media::AudioDecoder::decode_synchronous(file, rate))
+      {
+        node->decoded.enqueue(std::move(res->second));
+      }
+      else
+      {
+        qDebug() << "Nodal: cannot decode" << file;
+        QFile::remove(file);
+      }
+    };
+    Media::DecodingPool::instance().submit(
+        std::move(decode), Media::DecodingPool::Playing);
+    return;
+  }
+
+  // Nothing rendered for the current state of the nodes: record them while they play
+  if(!canFreeze(process()))
+  {
+    score::warning(
+        nullptr, QObject::tr("Cannot freeze"),
+        QObject::tr("Only nodes lasting at most %1 minutes can be frozen: "
+           "they will be played without being rendered.")
+            .arg(maxFreezeDuration / 60.));
+    return;
+  }
+
+  m_recording = std::make_shared<ossia::freeze_recording>(
+      int64_t(std::ceil(process().duration().sec() * rate)));
+  fz.recording = m_recording;
+  writeFreeze(m_recording, m_freezeFile, rate);
+}
+
+void NodalExecutorBase::stopFreeze()
+{
+  // The writer thread finishes the file if the nodes played from start to end
+  if(m_recording)
+    m_recording->stopped = true;
+  m_recording.reset();
+}
+
 struct AddNode
 {
   std::weak_ptr<ossia::graph_node> fw_node;
@@ -182,6 +366,9 @@ void NodalExecutorBase::reg(const RegisteredNode& fx, Execution::Transaction& ve
 Execution::ProcessComponent* NodalExecutorBase::make(
     Execution::ProcessComponentFactory& factory, Process::ProcessModel& proc)
 {
+  if(m_playingFreeze)
+    return nullptr;
+
   Execution::Transaction commands{system()};
   auto comp = factory.make(proc, this->system(), this);
   if(comp)
@@ -262,6 +449,7 @@ std::function<void()> NodalExecutorBase::removing(
 
 void NodalExecutor::cleanup()
 {
+  stopFreeze();
   clear();
   ::Execution::ProcessComponent::cleanup();
 }
@@ -7,6 +7,10 @@
 
 #include <ossia/dataflow/node_process.hpp>
 #include <ossia/detail/hash_map.hpp>
+namespace ossia
+{
+struct freeze_recording;
+}
 namespace Nodal
 {
 class NodalExecutorBase
@@ -56,9 +60,18 @@ public:
     return process().nodes;
   }
 
+protected:
+  //! Ends the recording of the output of the nodes, if any.
+  void stopFreeze();
+
 private:
   void reg(const RegisteredNode& fx, Execution::Transaction& vec);
   void unreg(const RegisteredNode& fx, Execution::Transaction& vec);
+  void setupFreeze();
+
+  QString m_freezeFile;
+  std::shared_ptr<ossia::freeze_recording> m_recording;
+  bool m_playingFreeze{};
 };
 
 class HierarchyManager
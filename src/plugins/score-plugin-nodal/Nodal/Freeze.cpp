@@ -0,0 +1,163 @@
+#include "Freeze.hpp"
+
+#include <Media/MediaFileHandle.hpp>
+#include <Nodal/Commands.hpp>
+#include <Nodal/Process.hpp>
+
+#include <score/command/Dispatchers/CommandDispatcher.hpp>
+#include <score/tools/SafeCast.hpp>
+#include <score/widgets/MessageBox.hpp>
+
+#include <QDebug>
+#include <QDir>
+#include <QStandardPaths>
+
+#include <chrono>
+#include <optional>
+#include <thread>
+
+namespace ossia
+{
+freeze_recording::freeze_recording(int64_t frames)
+    : frames{frames}
+{
+  for(auto& chunk : chunks)
+  {
+    chunk.samples.resize(chunk_samples);
+    free.enqueue(&chunk);
+  }
+}
+}
+
+namespace Nodal
+{
+// The oldest rendered files are removed past this size
+static constexpr qint64 maxFreezeCacheSize = 4LL * 1024 * 1024 * 1024;
+
+bool canFreeze(const Model& model) noexcept
+{
+  const auto dur = model.duration();
+  return !dur.infinite() && dur.sec() <= maxFreezeDuration;
+}
+
+QString freezeCacheFile(const Model& model, int rate)
+{
+  const auto dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if(dir.isEmpty())
+    return {};
+
+  QDir cache_dir{dir};
+  cache_dir.mkpath("freeze");
+  cache_dir.cd("freeze");
+
+  return cache_dir.absoluteFilePath(
+      QStringLiteral("%1-%2.wav").arg(model.freezeKey()).arg(rate));
+}
+
+static void trimFreezeCache(const QString& keep)
+{
+  const QFileInfo kept{keep};
+  QDir cache_dir = kept.absoluteDir();
+
+  qint64 total = 0;
+  for(const auto& file : cache_dir.entryInfoList({"*.wav"}, QDir::Files, QDir::Time))
+  {
+    total += file.size();
+    if(total > maxFreezeCacheSize && file != kept)
+      QFile::remove(file.absoluteFilePath());
+  }
+}
+
+static void writeChunk(
+    Media::AudioFileWriter& writer, const ossia::freeze_chunk& chunk,
+    std::vector<float>& buffer)
+{
+  const std::size_t channels = writer.channels();
+  if(chunk.channels == channels)
+  {
+    writer.write(chunk.samples.data(), chunk.frames);
+    return;
+  }
+
+  // The number of channels of the first chunk is kept for the whole file
+  buffer.assign(chunk.frames * channels, 0.f);
+  const std::size_t copied = std::min(channels, chunk.channels);
+  for(int64_t i = 0; i < chunk.frames; i++)
+    for(std::size_t c = 0; c < copied; c++)
+      buffer[i * channels + c] = chunk.samples[i * chunk.channels + c];
+  writer.write(buffer.data(), chunk.frames);
+}
+
+void writeFreeze(std::shared_ptr<ossia::freeze_recording> rec, QString file, int rate)
+{
+  std::thread{[rec = std::move(rec), file = std::move(file), rate] {
+    const QString part = file + ".part";
+    std::optional<Media::AudioFileWriter> writer;
+    std::vector<float> buffer;
+
+    for(;;)
+    {
+      // Read before draining: once set, every chunk is in the queue
+      const bool complete = rec->complete.load(std::memory_order_acquire);
+
+      ossia::freeze_chunk* chunk{};
+      while(rec->filled.try_dequeue(chunk))
+      {
+        if(!writer)
+          writer.emplace(part, int(chunk->channels), rate);
+        if(writer->isOpen())
+          writeChunk(*writer, *chunk, buffer);
+
+        chunk->frames = 0;
+        rec->free.enqueue(chunk);
+      }
+
+      if(complete && writer && writer->isOpen())
+      {
+        writer.reset();
+        QFile::remove(file);
+        QFile::rename(part, file);
+        trimFreezeCache(file);
+        return;
+      }
+
+      if(complete || rec->overrun || rec->stopped)
+      {
+        if(rec->overrun)
+          qDebug() << "Nodal: the rendering could not be written fast enough";
+        writer.reset();
+        QFile::remove(part);
+        return;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }}.detach();
+}
+
+QString FreezeAction::title() const noexcept
+{
+  return QObject::tr("Freeze / unfreeze nodes");
+}
+
+UuidKey<Process::ProcessModel> FreezeAction::target() const noexcept
+{
+  return Metadata<ConcreteKey_k, Nodal::Model>::get();
+}
+
+void FreezeAction::apply(Process::ProcessModel& proc, const score::DocumentContext& ctx)
+{
+  auto& model = safe_cast<Nodal::Model&>(proc);
+  if(!model.frozen() && !canFreeze(model))
+  {
+    score::warning(
+        ctx.app.mainWindow, QObject::tr("Cannot freeze"),
+        QObject::tr("Only nodes lasting at most %1 minutes can be frozen.")
+            .arg(maxFreezeDuration / 60.));
+    return;
+  }
+
+  CommandDispatcher<> disp{ctx.commandStack};
+  disp.submit(new SetFrozen{model, !model.frozen()});
+}
+}
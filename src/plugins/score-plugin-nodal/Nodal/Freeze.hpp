@@ -0,0 +1,86 @@
+#pragma once
+#include <Process/OfflineAction/OfflineAction.hpp>
+
+#include <ossia/dataflow/audio_port.hpp>
+#include <ossia/detail/lockfree_queue.hpp>
+
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace ossia
+{
+//! Interleaved frames of a freeze recording.
+struct freeze_chunk
+{
+  std::vector<float> samples;
+  int64_t frames{};
+  std::size_t channels{};
+};
+
+/**
+ * @brief Output of the nodes being recorded for freezing.
+ *
+ * The execution thread fills the chunks and hands them to the writer thread,
+ * which streams them to the file and gives them back: the memory used does
+ * not depend on the duration of the process nor on its number of channels.
+ */
+struct freeze_recording
+{
+  static constexpr std::size_t chunk_samples = 1 << 17;
+  static constexpr std::size_t chunk_count = 16;
+  static constexpr std::size_t max_channels = 256;
+
+  explicit freeze_recording(int64_t frames);
+
+  std::array<freeze_chunk, chunk_count> chunks;
+  ossia::spsc_queue<freeze_chunk*, chunk_count> free;
+  ossia::spsc_queue<freeze_chunk*, chunk_count> filled;
+
+  // Only accessed by the execution thread
+  freeze_chunk* current{};
+  int64_t recorded{};
+
+  const int64_t frames{};
+
+  //! Set by the execution thread once the last chunk is filled
+  std::atomic_bool complete{};
+  //! Set by the execution thread if the writer could not keep up
+  std::atomic_bool overrun{};
+  //! Set when the recording is abandoned, e.g. when the execution stops
+  std::atomic_bool stopped{};
+};
+}
+
+namespace Nodal
+{
+class Model;
+
+//! Longest duration of the nodes which can be frozen, in seconds.
+constexpr double maxFreezeDuration = 600.;
+bool canFreeze(const Model& model) noexcept;
+
+//! Path of the file in which the output of the nodes is rendered.
+QString freezeCacheFile(const Model& model, int rate);
+
+/**
+ * @brief Writes the recording to the file while it is being recorded.
+ *
+ * The file only appears once the recording is complete, and the oldest
+ * rendered files are then removed if the cache gets too large.
+ * An abandoned recording is discarded.
+ */
+void writeFreeze(std::shared_ptr<ossia::freeze_recording> rec, QString file, int rate);
+
+class FreezeAction final : public Process::OfflineAction
+{
+  SCORE_CONCRETE("2c51fb0d-91c4-4b8e-9d5a-7e6f4a8c3b12")
+
+  QString title() const noexcept override;
+  UuidKey<Process::ProcessModel> target() const noexcept override;
+  void apply(Process::ProcessModel& proc, const score::DocumentContext&) override;
+};
+}
@@ -14,6 +14,7 @@
 #include <score/tools/std/Invoke.hpp>
 
 #include <QApplication>
+#include <QCryptographicHash>
 
 #include <wobjectimpl.h>
 W_OBJECT_IMPL(Nodal::Model)
@@ -70,6 +71,23 @@ void Model::ancestorTempoChanged()
     n.ancestorTempoChanged();
 }
 
+void Model::setFrozen(bool b)
+{
+  if(b != m_frozen)
+  {
+    m_frozen = b;
+    frozenChanged(b);
+  }
+}
+
+QString Model::freezeKey() const noexcept
+{
+  QCryptographicHash h{QCryptographicHash::Sha1};
+  h.addData(savePreset().data);
+  h.addData(QByteArray::number((qint64)duration().impl));
+  return QString::fromLatin1(h.result().toHex());
+}
+
 bool NodeEditor::copy(
     JSONReader& r, const Selection& s, const score::DocumentContext& ctx)
 {
@@ -153,6 +171,8 @@ void DataStreamReader::read(const Nodal::Model& proc)
   for(const auto& node : proc.nodes)
     readFrom(node);
 
+  m_stream << proc.m_frozen;
+
   insertDelimiter();
 }
 
@@ -179,6 +199,9 @@ void DataStreamWriter::write(Nodal::Model& process)
       SCORE_TODO;
     }
   }
+
+  m_stream >> process.m_frozen;
+
   checkDelimiter();
 }
 
@@ -188,6 +211,7 @@ void JSONReader::read(const Nodal::Model& proc)
   obj["Nodes"] = proc.nodes;
   obj["Inlet"] = *proc.inlet;
   obj["Outlet"] = *proc.outlet;
+  obj["Frozen"] = proc.m_frozen;
 }
 
 template <>
@@ -213,4 +237,6 @@ void JSONWriter::write(Nodal::Model& proc)
     else
       SCORE_TODO;
   }
+
+  assign_with_default(proc.m_frozen, obj.tryGet("Frozen"), false);
 }
@@ -43,6 +43,20 @@ public:
 
   score::EntityMap<Process::ProcessModel> nodes;
 
+  /**
+   * @brief Whether the output of the nodes is played back from a rendered cache.
+   *
+   * The render is done during the first execution after the nodes changed,
+   * thus this is only meaningful for nodes whose output only depends on time.
+   */
+  bool frozen() const noexcept { return m_frozen; }
+  void setFrozen(bool b);
+  void frozenChanged(bool b) W_SIGNAL(frozenChanged, b);
+  PROPERTY(bool, frozen READ frozen WRITE setFrozen NOTIFY frozenChanged)
+
+  //! Changes whenever the nodes, their cables or the duration change.
+  QString freezeKey() const noexcept;
+
 private:
   void loadPreset(const Process::Preset& preset) override;
   Process::Preset savePreset() const noexcept override;
@@ -57,6 +71,7 @@ private:
   void ancestorTempoChanged() override;
 
   const score::DocumentContext& m_context;
+  bool m_frozen{};
 };
 
 using ProcessFactory = Process::ProcessFactory_T<Nodal::Model>;
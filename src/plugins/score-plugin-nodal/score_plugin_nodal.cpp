@@ -8,6 +8,7 @@
 
 #include <Nodal/CommandFactory.hpp>
 #include <Nodal/Executor.hpp>
+#include <Nodal/Freeze.hpp>
 #include <Nodal/Layer.hpp>
 #include <Nodal/Process.hpp>
 
@@ -196,7 +197,8 @@ std::vector<std::unique_ptr<score::InterfaceBase>> score_plugin_nodal::factories
       score::ApplicationContext, FW<Process::ProcessModelFactory, Nodal::ProcessFactory>,
       FW<Process::LayerFactory, Nodal::LayerFactory>,
       FW<Execution::ProcessComponentFactory, Nodal::ProcessExecutorComponentFactory>,
-      FW<score::ObjectEditor, Nodal::NodeEditor>
+      FW<score::ObjectEditor, Nodal::NodeEditor>,
+      FW<Process::OfflineAction, Nodal::FreezeAction>
       //, FW<score::PanelDelegateFactory, Nodal::PanelDelegateFactory>
       //, FW<LocalTree::ProcessComponentFactory,
       //   Nodal::LocalTreeProcessComponentFactory>
@@ -39,7 +39,7 @@ Device::DeviceInterface* ArtnetProtocolFactory::makeDevice(
     const Device::DeviceSettings& settings, const Explorer::DeviceDocumentPlugin& plugin,
     const score::DocumentContext& ctx)
 {
-  return new ArtnetDevice{settings, plugin.networkContext()};
+  return new ArtnetDevice{settings, plugin.newDeviceContext()};
 }
 
 const Device::DeviceSettings& ArtnetProtocolFactory::defaultSettings() const noexcept
@@ -8,6 +8,7 @@
 #include <Explorer/DeviceLogging.hpp>
 
 #include <Protocols/HTTP/HTTPSpecificSettings.hpp>
+#include <Protocols/ScriptThread.hpp>
 
 #include <ossia/network/generic/generic_device.hpp>
 #include <ossia/network/generic/generic_parameter.hpp>
@@ -30,6 +31,11 @@ HTTPDevice::HTTPDevice(const Device::DeviceSettings& settings)
   m_capas.canSerialize = false;
 }
 
+HTTPDevice::~HTTPDevice()
+{
+  disconnect();
+}
+
 bool HTTPDevice::reconnect()
 {
   disconnect();
@@ -38,12 +44,30 @@ bool HTTPDevice::reconnect()
   {
     auto stgs = settings().deviceSpecificSettings.value<HTTPSpecificSettings>();
 
-    m_dev = std::make_unique<ossia::net::http_device>(
-        std::make_unique<ossia::net::http_protocol>(stgs.text.toUtf8()),
-        settings().name.toStdString());
+    auto create = [&] {
+      m_dev = std::make_unique<ossia::net::http_device>(
+          std::make_unique<ossia::net::http_protocol>(stgs.text.toUtf8()),
+          settings().name.toStdString());
+
+      // Replies may create nodes on the script thread as soon as it runs
+      enableCallbacks();
+    };
+
+    if(stgs.separateThread)
+    {
+      // The QML engine and the network replies then live on that thread
+      if(!m_thread)
+        m_thread = std::make_unique<ScriptThread>("HTTP: " + settings().name);
+      m_thread->run(create);
+    }
+    else
+    {
+      m_thread.reset();
+      create();
+    }
+
     deviceChanged(nullptr, m_dev.get());
 
-    enableCallbacks();
     setLogging_impl(Device::get_cur_logging(isLogging()));
   }
   catch(std::exception& e)
@@ -57,4 +81,22 @@ bool HTTPDevice::reconnect()
 
   return connected();
 }
+
+void HTTPDevice::disconnect()
+{
+  if(m_thread && m_owned && m_dev)
+  {
+    // The tree and the script callbacks are used by the script thread:
+    // they are torn down there, while this thread waits.
+    deviceChanged(m_dev.get(), nullptr);
+    m_thread->run([this] {
+      DeviceInterface::disconnect();
+      m_dev.reset();
+    });
+  }
+  else
+  {
+    OwningDeviceInterface::disconnect();
+  }
+}
 }
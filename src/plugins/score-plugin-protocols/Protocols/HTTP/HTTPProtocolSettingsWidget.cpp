@@ -13,6 +13,7 @@
 
 #include <score/widgets/TextLabel.hpp>
 
+#include <QCheckBox>
 #include <QCodeEditor>
 #include <QGridLayout>
 #include <QLabel>
@@ -31,10 +32,17 @@ HTTPProtocolSettingsWidget::HTTPProtocolSettingsWidget(QWidget* parent)
   m_codeEdit = Process::createScriptWidget("JS");
   checkForChanges(m_codeEdit);
 
+  m_separateThread = new QCheckBox{tr("Run the script on a separate thread"), this};
+  m_separateThread->setToolTip(
+      tr("Keeps the user interface responsive while the script handles large "
+         "messages"));
+  checkForChanges(m_separateThread);
+
   QGridLayout* gLayout = new QGridLayout;
 
   gLayout->addWidget(deviceNameLabel, 0, 0, 1, 1);
   gLayout->addWidget(m_deviceNameEdit, 0, 1, 1, 1);
+  gLayout->addWidget(m_separateThread, 2, 1, 1, 1);
   gLayout->addWidget(m_codeEdit, 3, 0, 1, 2);
 
   setLayout(gLayout);
@@ -49,6 +57,7 @@ void HTTPProtocolSettingsWidget::setDefaults()
 
   m_deviceNameEdit->setText("newDevice");
   m_codeEdit->setPlainText("");
+  m_separateThread->setChecked(true);
 }
 
 Device::DeviceSettings HTTPProtocolSettingsWidget::getSettings() const
@@ -61,6 +70,7 @@ Device::DeviceSettings HTTPProtocolSettingsWidget::getSettings() const
 
   HTTPSpecificSettings specific;
   specific.text = m_codeEdit->toPlainText();
+  specific.separateThread = m_separateThread->isChecked();
 
   s.deviceSpecificSettings = QVariant::fromValue(specific);
   return s;
@@ -74,6 +84,7 @@ void HTTPProtocolSettingsWidget::setSettings(const Device::DeviceSettings& setti
   {
     specific = settings.deviceSpecificSettings.value<HTTPSpecificSettings>();
     m_codeEdit->setPlainText(specific.text);
+    m_separateThread->setChecked(specific.separateThread);
   }
 }
 }
@@ -2,6 +2,7 @@
 
 #include <Device/Protocol/DeviceSettings.hpp>
 #include <Device/Protocol/ProtocolSettingsWidget.hpp>
+class QCheckBox;
 class QLineEdit;
 class QTextEdit;
 class QSpinBox;
@@ -24,5 +25,6 @@ protected:
 protected:
   QLineEdit* m_deviceNameEdit{};
   QTextEdit* m_codeEdit{};
+  QCheckBox* m_separateThread{};
 };
 }
@@ -8,6 +8,9 @@ namespace Protocols
 struct HTTPSpecificSettings
 {
   QString text;
+
+  // Runs the script on its own thread instead of the GUI thread
+  bool separateThread{true};
 };
 }
 Q_DECLARE_METATYPE(Protocols::HTTPSpecificSettings)
@@ -8,14 +8,14 @@
 template <>
 void DataStreamReader::read(const Protocols::HTTPSpecificSettings& n)
 {
-  m_stream << n.text;
+  m_stream << n.text << n.separateThread;
   insertDelimiter();
 }
 
 template <>
 void DataStreamWriter::write(Protocols::HTTPSpecificSettings& n)
 {
-  m_stream >> n.text;
+  m_stream >> n.text >> n.separateThread;
   checkDelimiter();
 }
 
@@ -23,10 +23,17 @@ template <>
 void JSONReader::read(const Protocols::HTTPSpecificSettings& n)
 {
   obj["Text"] = n.text;
+  obj["SeparateThread"] = n.separateThread;
 }
 
 template <>
 void JSONWriter::write(Protocols::HTTPSpecificSettings& n)
 {
   n.text = obj["Text"].toString();
+
+  // Older devices ran on the GUI thread
+  if(auto it = obj.tryGet("SeparateThread"))
+    n.separateThread = it->toBool();
+  else
+    n.separateThread = false;
 }
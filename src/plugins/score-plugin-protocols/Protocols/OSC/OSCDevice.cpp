@@ -9,6 +9,7 @@
 #include <Explorer/DocumentPlugin/DeviceDocumentPlugin.hpp>
 
 #include <Protocols/OSC/OSCSpecificSettings.hpp>
+#include <Protocols/ScheduledProtocol.hpp>
 
 #include <score/application/ApplicationContext.hpp>
 #include <score/document/DocumentContext.hpp>
@@ -43,6 +44,7 @@ bool OSCDevice::reconnect()
         = settings().deviceSpecificSettings.value<OSCSpecificSettings>();
     if(auto proto = ossia::net::make_osc_protocol(m_ctx, stgs.configuration))
     {
+      m_oscProtocol = static_cast<ossia::net::osc_protocol_base*>(proto.get());
       if(stgs.rate)
       {
         auto rate = std::make_unique<ossia::net::rate_limiting_protocol>(
@@ -50,6 +52,13 @@ bool OSCDevice::reconnect()
         m_dev = std::make_unique<ossia::net::generic_device>(
             std::move(rate), settings().name.toStdString());
       }
+      else if(stgs.latency)
+      {
+        auto scheduled = std::make_unique<ScheduledProtocol>(
+            std::chrono::milliseconds{*stgs.latency}, std::move(proto));
+        m_dev = std::make_unique<ossia::net::generic_device>(
+            std::move(scheduled), settings().name.toStdString());
+      }
       else
       {
         m_dev = std::make_unique<ossia::net::generic_device>(
@@ -84,17 +93,23 @@ void OSCDevice::recreate(const Device::Node& n)
   }
 }
 
+void OSCDevice::disconnect()
+{
+  OwningDeviceInterface::disconnect();
+  m_oscProtocol = nullptr;
+}
+
 bool OSCDevice::isLearning() const
 {
-  auto& proto = static_cast<ossia::net::osc_protocol_base&>(m_dev->get_protocol());
-  return proto.learning();
+  return m_oscProtocol && m_oscProtocol->learning();
 }
 
 void OSCDevice::setLearning(bool b)
 {
-  if(!m_dev)
+  if(!m_dev || !m_oscProtocol)
     return;
-  auto& proto = static_cast<ossia::net::osc_protocol_base&>(m_dev->get_protocol());
+  // The OSC protocol may be wrapped, e.g. for rate limiting
+  auto& proto = *m_oscProtocol;
   auto& dev = *m_dev;
   if(b)
   {
@@ -1,6 +1,11 @@
 #pragma once
 #include <Device/Protocol/DeviceInterface.hpp>
 
+namespace ossia::net
+{
+class osc_protocol_base;
+}
+
 namespace Protocols
 {
 class OSCDevice final : public Device::OwningDeviceInterface
@@ -10,6 +15,7 @@ public:
       const Device::DeviceSettings& stngs, const ossia::net::network_context_ptr& ctx);
 
   bool reconnect() override;
+  void disconnect() override;
   void recreate(const Device::Node&) final override;
 
   bool isLearning() const final override;
@@ -17,5 +23,6 @@ public:
 
 private:
   const ossia::net::network_context_ptr& m_ctx;
+  ossia::net::osc_protocol_base* m_oscProtocol{};
 };
 }
@@ -179,7 +179,7 @@ Device::DeviceInterface* OSCProtocolFactory::makeDevice(
     const Device::DeviceSettings& settings, const Explorer::DeviceDocumentPlugin& plugin,
     const score::DocumentContext& ctx)
 {
-  return new OSCDevice{settings, plugin.networkContext()};
+  return new OSCDevice{settings, plugin.newDeviceContext()};
 }
 
 const Device::DeviceSettings& OSCProtocolFactory::defaultSettings() const noexcept
@@ -363,6 +363,13 @@ OSCProtocolSettingsWidget::OSCProtocolSettingsWidget(QWidget* parent)
   m_rate = new RateWidget{this};
   m_rate->setRate({});
 
+  m_latency = new RateWidget{this};
+  m_latency->setRate({});
+  m_latency->setToolTip(
+      tr("Send the values computed during an audio buffer at a fixed delay after "
+         "the start of the buffer, instead of as soon as they are computed. "
+         "Not used when the rate is limited."));
+
   m_transport = new QComboBox{this};
   m_transport->addItems(
       {"UDP", "TCP", "Serial port", "Unix Datagram", "Unix Stream", "Websocket Client",
@@ -402,6 +409,7 @@ OSCProtocolSettingsWidget::OSCProtocolSettingsWidget(QWidget* parent)
   layout->addRow(tr("Name"), m_deviceNameEdit);
   layout->addRow(tr("OSC Version"), m_oscVersion);
   layout->addRow(tr("Rate limit"), m_rate);
+  layout->addRow(tr("Scheduled output"), m_latency);
   layout->addRow(tr("Protocol"), m_transport);
   layout->addRow(m_transportLayout);
 }
@@ -451,6 +459,7 @@ Device::DeviceSettings OSCProtocolSettingsWidget::getSettings() const
   using osc_version_t = decltype(ossia::net::osc_protocol_configuration::version);
   osc.configuration.version = static_cast<osc_version_t>(m_oscVersion->currentIndex());
   osc.rate = m_rate->rate();
+  osc.latency = m_latency->rate();
   osc.jsonToLoad.clear();
 
   // TODO list.append(m_namespaceFilePathEdit->text());
@@ -489,6 +498,7 @@ void OSCProtocolSettingsWidget::setSettings(const Device::DeviceSettings& settin
     m_settings = settings.deviceSpecificSettings.value<OSCSpecificSettings>();
     m_oscVersion->setCurrentIndex(m_settings.configuration.version);
     m_rate->setRate(m_settings.rate);
+    m_latency->setRate(m_settings.latency);
     struct vis
     {
       OSCProtocolSettingsWidget& self;
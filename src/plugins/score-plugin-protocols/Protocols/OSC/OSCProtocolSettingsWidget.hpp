@@ -38,6 +38,7 @@ private:
   void setDefaults();
   QLineEdit* m_deviceNameEdit{};
   RateWidget* m_rate{};
+  RateWidget* m_latency{};
   QComboBox* m_transport{};
   QComboBox* m_oscVersion{};
   QStackedLayout* m_transportLayout{};
@@ -13,6 +13,10 @@ struct OSCSpecificSettings
   ossia::net::osc_protocol_configuration configuration;
   std::optional<int> rate{};
 
+  // When set, values computed during a tick are sent this many milliseconds
+  // after its start, see ScheduledProtocol
+  std::optional<int> latency{};
+
   // Note: this one is not saved, it is only used
   // to allow loading a .json file as an OSC device
   QByteArray jsonToLoad;
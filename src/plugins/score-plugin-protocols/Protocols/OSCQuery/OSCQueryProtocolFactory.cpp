@@ -214,7 +214,7 @@ Device::DeviceInterface* OSCQueryProtocolFactory::makeDevice(
     const Device::DeviceSettings& settings, const Explorer::DeviceDocumentPlugin& plugin,
     const score::DocumentContext& ctx)
 {
-  return new OSCQueryDevice{settings, plugin.networkContext()};
+  return new OSCQueryDevice{settings, plugin.newDeviceContext()};
 }
 
 const Device::DeviceSettings& OSCQueryProtocolFactory::defaultSettings() const noexcept
@@ -0,0 +1,117 @@
+#include "ScheduledProtocol.hpp"
+
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/network/base/device.hpp>
+#include <ossia/network/base/parameter.hpp>
+
+namespace Protocols
+{
+namespace
+{
+// Set by the audio thread for the duration of a tick
+thread_local bool g_inTick{};
+thread_local ScheduledProtocol::clock::time_point g_tickStart{};
+
+// Lets the senders poll less often while nothing is executing
+std::atomic<ScheduledProtocol::clock::rep> g_lastTick{};
+}
+
+void TickClockAction::startTick(const ossia::audio_tick_state& st)
+{
+  g_inTick = true;
+  g_tickStart = ScheduledProtocol::clock::now();
+  g_lastTick.store(g_tickStart.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+void TickClockAction::endTick(const ossia::audio_tick_state& st)
+{
+  g_inTick = false;
+}
+
+ScheduledProtocol::ScheduledProtocol(
+    std::chrono::microseconds latency, std::unique_ptr<ossia::net::protocol_base> proto)
+    : protocol_base{flags{}}
+    , m_proto{std::move(proto)}
+    , m_latency{latency}
+    , m_queue{1024}
+{
+  m_thread = std::thread{[this] { run(); }};
+}
+
+ScheduledProtocol::~ScheduledProtocol()
+{
+  m_running = false;
+  m_thread.join();
+}
+
+bool ScheduledProtocol::push(const ossia::net::parameter_base& p, const ossia::value& v)
+{
+  if(!g_inTick)
+    return m_proto->push(p, v);
+
+  const auto seq = m_sequence.fetch_add(1, std::memory_order_relaxed);
+  return m_queue.enqueue(Message{&p, v, g_tickStart + m_latency, seq});
+}
+
+void ScheduledProtocol::set_device(ossia::net::device_base& dev)
+{
+  m_proto->set_device(dev);
+  dev.on_parameter_removing.connect<&ScheduledProtocol::onParameterRemoving>(this);
+}
+
+void ScheduledProtocol::onParameterRemoving(const ossia::net::parameter_base& p)
+{
+  // Messages already queued for the parameter get dropped.
+  // Taking the lock waits for a message being sent to this parameter.
+  std::lock_guard lock{m_sendMutex};
+  m_removed.push_back({&p, m_sequence.load(std::memory_order_relaxed)});
+}
+
+bool ScheduledProtocol::wasRemoved(const Message& m) noexcept
+{
+  // The messages of a tick are all queued by the audio thread, in order:
+  // once one posted after a removal comes, the removal does not apply anymore.
+  bool removed = false;
+  ossia::remove_erase_if(m_removed, [&](const Removed& r) {
+    if(m.sequence >= r.sequence)
+      return true;
+    removed |= r.parameter == m.parameter;
+    return false;
+  });
+  return removed;
+}
+
+void ScheduledProtocol::run()
+{
+  // Short compared to the latency while ticking, so that messages are not late
+  static constexpr auto activePoll = std::chrono::microseconds{500};
+  static constexpr auto idlePoll = std::chrono::milliseconds{20};
+  static constexpr auto idleDelay = std::chrono::milliseconds{100};
+
+  Message m;
+  while(m_running)
+  {
+    if(!m_queue.try_dequeue(m))
+    {
+      const clock::duration last{g_lastTick.load(std::memory_order_relaxed)};
+      if(clock::now().time_since_epoch() - last < idleDelay)
+        std::this_thread::sleep_for(activePoll);
+      else
+        std::this_thread::sleep_for(idlePoll);
+      continue;
+    }
+
+    // Sleep most of the way, then spin for precision:
+    // OS timers are often only accurate to the millisecond.
+    static constexpr auto spin = std::chrono::microseconds{1500};
+    if(auto now = clock::now(); m.date - now > spin)
+      std::this_thread::sleep_until(m.date - spin);
+    while(clock::now() < m.date)
+      std::this_thread::yield();
+
+    std::lock_guard lock{m_sendMutex};
+    if(m_removed.empty() || !wasRemoved(m))
+      m_proto->push(*m.parameter, m.value);
+  }
+}
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <Process/ExecutionAction.hpp>
+
+#include <ossia/network/base/protocol.hpp>
+#include <ossia/network/value/value.hpp>
+
+#include <concurrentqueue.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Protocols
+{
+/**
+ * @brief Gives the scheduled protocols the time at which the current tick started.
+ *
+ * Registered as an application-wide execution action: it is called by the
+ * audio thread at the start and end of each tick.
+ */
+class TickClockAction final : public Execution::ExecutionAction
+{
+  SCORE_CONCRETE("5c9a3c1e-6c3e-4f0e-a1a4-8f5b6e2b7d41")
+public:
+  void startTick(const ossia::audio_tick_state& st) override;
+  void endTick(const ossia::audio_tick_state& st) override;
+};
+
+/**
+ * @brief Sends the values pushed during a tick at a fixed delay after its start.
+ *
+ * All the values committed to a device by a tick are pushed at once, at a
+ * moment which depends on how long the tick took to compute. This wraps the
+ * protocol of a device so that those values are handed to it on a dedicated
+ * thread at the start of the tick plus a constant latency instead: the output
+ * is then as regular as the audio callback.
+ *
+ * Values pushed outside of a tick, e.g. from the device explorer, are sent
+ * immediately.
+ */
+class ScheduledProtocol final : public ossia::net::protocol_base
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  ScheduledProtocol(
+      std::chrono::microseconds latency,
+      std::unique_ptr<ossia::net::protocol_base> proto);
+  ~ScheduledProtocol() override;
+
+  bool pull(ossia::net::parameter_base& p) override { return m_proto->pull(p); }
+  bool push(const ossia::net::parameter_base& p, const ossia::value& v) override;
+  bool push_raw(const ossia::net::full_parameter_data& d) override
+  {
+    return m_proto->push_raw(d);
+  }
+  bool observe(ossia::net::parameter_base& p, bool b) override
+  {
+    return m_proto->observe(p, b);
+  }
+  bool update(ossia::net::node_base& n) override { return m_proto->update(n); }
+  void set_device(ossia::net::device_base& dev) override;
+  void set_logger(const ossia::net::network_logger& l) override
+  {
+    m_proto->set_logger(l);
+  }
+  const ossia::net::network_logger& get_logger() const noexcept override
+  {
+    return m_proto->get_logger();
+  }
+  void stop() override { m_proto->stop(); }
+
+private:
+  struct Message
+  {
+    const ossia::net::parameter_base* parameter{};
+    ossia::value value;
+    clock::time_point date{};
+    uint64_t sequence{};
+  };
+
+  //! A parameter removed once the messages before sequence were queued.
+  struct Removed
+  {
+    const ossia::net::parameter_base* parameter{};
+    uint64_t sequence{};
+  };
+
+  void onParameterRemoving(const ossia::net::parameter_base&);
+  bool wasRemoved(const Message& m) noexcept;
+  void run();
+
+  std::unique_ptr<ossia::net::protocol_base> m_proto;
+  std::chrono::microseconds m_latency{};
+
+  // Polled by the sender: the audio thread only does a lock-free enqueue
+  moodycamel::ConcurrentQueue<Message> m_queue;
+  std::atomic<uint64_t> m_sequence{};
+
+  // Protected by m_sendMutex
+  std::vector<Removed> m_removed;
+  std::mutex m_sendMutex;
+  std::atomic_bool m_running{true};
+  std::thread m_thread;
+};
+}
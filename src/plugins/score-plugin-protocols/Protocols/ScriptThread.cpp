@@ -0,0 +1,39 @@
+#include "ScriptThread.hpp"
+
+#include <exception>
+
+namespace Protocols
+{
+ScriptThread::ScriptThread(const QString& name)
+{
+  m_thread.setObjectName(name);
+  m_context.moveToThread(&m_thread);
+  m_thread.start();
+}
+
+ScriptThread::~ScriptThread()
+{
+  m_thread.quit();
+  m_thread.wait();
+}
+
+void ScriptThread::run(std::function<void()> f)
+{
+  // Exceptions are given back to the caller instead of escaping the event loop
+  std::exception_ptr error;
+  auto call = [&] {
+    try
+    {
+      f();
+    }
+    catch(...)
+    {
+      error = std::current_exception();
+    }
+  };
+  QMetaObject::invokeMethod(&m_context, call, Qt::BlockingQueuedConnection);
+
+  if(error)
+    std::rethrow_exception(error);
+}
+}
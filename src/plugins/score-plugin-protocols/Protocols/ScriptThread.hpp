@@ -0,0 +1,29 @@
+#pragma once
+#include <QObject>
+#include <QThread>
+
+#include <functional>
+
+namespace Protocols
+{
+/**
+ * @brief Thread on which the script-based devices (HTTP, WebSockets) can run.
+ *
+ * Their QML engine, network objects and reply handlers are created on it:
+ * parsing a large reply in a script then does not block the user interface.
+ * Their device tree is also torn down and destroyed on it.
+ */
+class ScriptThread
+{
+public:
+  explicit ScriptThread(const QString& name);
+  ~ScriptThread();
+
+  //! Calls f on the thread and waits for it to return; rethrows its exceptions.
+  void run(std::function<void()> f);
+
+private:
+  QThread m_thread;
+  QObject m_context;
+};
+}
@@ -47,7 +47,7 @@ Device::DeviceInterface* SerialProtocolFactory::makeDevice(
     const Device::DeviceSettings& settings, const Explorer::DeviceDocumentPlugin& plugin,
     const score::DocumentContext& ctx)
 {
-  return new SerialDevice{settings, plugin.networkContext()};
+  return new SerialDevice{settings, plugin.newDeviceContext()};
 }
 
 const Device::DeviceSettings& SerialProtocolFactory::defaultSettings() const noexcept
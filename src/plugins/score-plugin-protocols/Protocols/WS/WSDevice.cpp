@@ -7,6 +7,7 @@
 #include <Explorer/DeviceList.hpp>
 #include <Explorer/DeviceLogging.hpp>
 
+#include <Protocols/ScriptThread.hpp>
 #include <Protocols/WS/WSSpecificSettings.hpp>
 
 #include <ossia/network/generic/generic_device.hpp>
@@ -29,6 +30,11 @@ WSDevice::WSDevice(const Device::DeviceSettings& settings)
   m_capas.canSetProperties = false;
 }
 
+WSDevice::~WSDevice()
+{
+  disconnect();
+}
+
 bool WSDevice::reconnect()
 {
   disconnect();
@@ -37,12 +43,28 @@ bool WSDevice::reconnect()
   {
     auto stgs = settings().deviceSpecificSettings.value<WSSpecificSettings>();
 
-    m_dev = std::make_unique<ossia::net::ws_generic_client_device>(
-        std::make_unique<ossia::net::ws_generic_client_protocol>(
-            stgs.address.toUtf8(), stgs.text.toUtf8()),
-        settings().name.toStdString());
+    auto create = [&] {
+      m_dev = std::make_unique<ossia::net::ws_generic_client_device>(
+          std::make_unique<ossia::net::ws_generic_client_protocol>(
+              stgs.address.toUtf8(), stgs.text.toUtf8()),
+          settings().name.toStdString());
+
+      // Messages may create nodes on the script thread as soon as it connects
+      enableCallbacks();
+    };
 
-    enableCallbacks();
+    if(stgs.separateThread)
+    {
+      // The QML engine and the socket then live on that thread
+      if(!m_thread)
+        m_thread = std::make_unique<ScriptThread>("WS: " + settings().name);
+      m_thread->run(create);
+    }
+    else
+    {
+      m_thread.reset();
+      create();
+    }
 
     setLogging_impl(Device::get_cur_logging(isLogging()));
 
@@ -59,4 +81,22 @@ bool WSDevice::reconnect()
 
   return connected();
 }
+
+void WSDevice::disconnect()
+{
+  if(m_thread && m_owned && m_dev)
+  {
+    // The tree and the script callbacks are used by the script thread:
+    // they are torn down there, while this thread waits.
+    deviceChanged(m_dev.get(), nullptr);
+    m_thread->run([this] {
+      DeviceInterface::disconnect();
+      m_dev.reset();
+    });
+  }
+  else
+  {
+    OwningDeviceInterface::disconnect();
+  }
+}
 }
@@ -1,13 +1,21 @@
 #pragma once
 #include <Device/Protocol/DeviceInterface.hpp>
 
+#include <memory>
+
 namespace Protocols
 {
+class ScriptThread;
 class WSDevice final : public Device::OwningDeviceInterface
 {
 public:
   WSDevice(const Device::DeviceSettings& settings);
+  ~WSDevice() override;
 
   bool reconnect() override;
+  void disconnect() override;
+
+private:
+  std::unique_ptr<ScriptThread> m_thread;
 };
 }
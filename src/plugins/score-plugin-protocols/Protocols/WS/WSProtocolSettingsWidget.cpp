@@ -14,6 +14,7 @@
 #include <score/tools/Debug.hpp>
 #include <score/widgets/TextLabel.hpp>
 
+#include <QCheckBox>
 #include <QCodeEditor>
 #include <QDebug>
 #include <QGridLayout>
@@ -38,6 +39,12 @@ WSProtocolSettingsWidget::WSProtocolSettingsWidget(QWidget* parent)
   m_codeEdit = Process::createScriptWidget("JS");
   checkForChanges(m_codeEdit);
 
+  m_separateThread = new QCheckBox{tr("Run the script on a separate thread"), this};
+  m_separateThread->setToolTip(
+      tr("Keeps the user interface responsive while the script handles large "
+         "messages"));
+  checkForChanges(m_separateThread);
+
   connect(
       static_cast<QCodeEditor*>(m_codeEdit), &QCodeEditor::editingFinished, this,
       &WSProtocolSettingsWidget::parseHost);
@@ -48,6 +55,7 @@ WSProtocolSettingsWidget::WSProtocolSettingsWidget(QWidget* parent)
   layout->addWidget(m_deviceNameEdit, 0, 1, 1, 1);
   layout->addWidget(addrLabel, 1, 0, 1, 1);
   layout->addWidget(m_addressNameEdit, 1, 1, 1, 1);
+  layout->addWidget(m_separateThread, 2, 1, 1, 1);
   layout->addWidget(m_codeEdit, 3, 0, 1, 2);
 
   setLayout(layout);
@@ -62,6 +70,7 @@ void WSProtocolSettingsWidget::setDefaults()
 
   m_deviceNameEdit->setText("newDevice");
   m_codeEdit->setPlainText("");
+  m_separateThread->setChecked(true);
   m_addressNameEdit->clear();
 }
 
@@ -102,6 +111,7 @@ Device::DeviceSettings WSProtocolSettingsWidget::getSettings() const
   WSSpecificSettings specific;
   specific.address = m_addressNameEdit->text();
   specific.text = m_codeEdit->toPlainText();
+  specific.separateThread = m_separateThread->isChecked();
 
   s.deviceSpecificSettings = QVariant::fromValue(specific);
   return s;
@@ -116,6 +126,7 @@ void WSProtocolSettingsWidget::setSettings(const Device::DeviceSettings& setting
     specific = settings.deviceSpecificSettings.value<WSSpecificSettings>();
 
     m_addressNameEdit->setText(specific.address);
+    m_separateThread->setChecked(specific.separateThread);
     if(specific.text != m_codeEdit->toPlainText())
     {
       m_codeEdit->setPlainText(specific.text);
@@ -2,6 +2,7 @@
 
 #include <Device/Protocol/DeviceSettings.hpp>
 #include <Device/Protocol/ProtocolSettingsWidget.hpp>
+class QCheckBox;
 class QLineEdit;
 class QTextEdit;
 class QSpinBox;
@@ -26,5 +27,6 @@ protected:
   QLineEdit* m_deviceNameEdit{};
   QLineEdit* m_addressNameEdit{};
   QTextEdit* m_codeEdit{};
+  QCheckBox* m_separateThread{};
 };
 }
@@ -9,6 +9,9 @@ struct WSSpecificSettings
 {
   QString address;
   QString text;
+
+  // Runs the script on its own thread instead of the GUI thread
+  bool separateThread{true};
 };
 }
 Q_DECLARE_METATYPE(Protocols::WSSpecificSettings)
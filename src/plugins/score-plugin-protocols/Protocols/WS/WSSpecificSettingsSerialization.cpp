@@ -8,14 +8,14 @@
 template <>
 void DataStreamReader::read(const Protocols::WSSpecificSettings& n)
 {
-  m_stream << n.address << n.text;
+  m_stream << n.address << n.text << n.separateThread;
   insertDelimiter();
 }
 
 template <>
 void DataStreamWriter::write(Protocols::WSSpecificSettings& n)
 {
-  m_stream >> n.address >> n.text;
+  m_stream >> n.address >> n.text >> n.separateThread;
   checkDelimiter();
 }
 
@@ -24,6 +24,7 @@ void JSONReader::read(const Protocols::WSSpecificSettings& n)
 {
   obj[strings.Address] = n.address;
   obj["Text"] = n.text;
+  obj["SeparateThread"] = n.separateThread;
 }
 
 template <>
@@ -31,4 +32,10 @@ void JSONWriter::write(Protocols::WSSpecificSettings& n)
 {
   n.address = obj[strings.Address].toString();
   n.text = obj["Text"].toString();
+
+  // Older devices ran on the GUI thread
+  if(auto it = obj.tryGet("SeparateThread"))
+    n.separateThread = it->toBool();
+  else
+    n.separateThread = false;
 }
@@ -6,6 +6,7 @@
 #include <Device/Protocol/ProtocolFactoryInterface.hpp>
 
 #include <Protocols/ProtocolLibrary.hpp>
+#include <Protocols/ScheduledProtocol.hpp>
 #include <Protocols/Settings/Factory.hpp>
 
 #include <score/plugins/FactorySetup.hpp>
@@ -134,6 +135,7 @@ std::vector<std::unique_ptr<score::InterfaceBase>> score_plugin_protocols::facto
 #endif
          >,
       FW<score::SettingsDelegateFactory, Protocols::Settings::Factory>,
+      FW<Execution::ExecutionAction, Protocols::TickClockAction>,
       FW<Library::LibraryInterface, Protocols::OSCLibraryHandler
 #if __has_include(<QQmlEngine>)
          ,
@@ -2,6 +2,11 @@
 
 #include <Explorer/DocumentPlugin/DeviceDocumentPlugin.hpp>
 
+#include <State/ValueSerialization.hpp>
+
+#include <Process/Dataflow/Port.hpp>
+#include <Process/Process.hpp>
+
 #include <Scenario/Application/ScenarioActions.hpp>
 
 #include <JS/ConsolePanel.hpp>
@@ -18,6 +23,7 @@
 #include <core/document/DocumentModel.hpp>
 
 #include <QBuffer>
+#include <QDataStream>
 
 #include <RemoteControl/DocumentPlugin.hpp>
 #include <RemoteControl/Scenario/Scenario.hpp>
@@ -25,6 +31,95 @@
 namespace RemoteControl
 {
 using namespace std::literals;
+namespace
+{
+static constexpr quint8 binary_protocol_version = 1;
+
+enum FrameSection : quint8
+{
+  IntervalsSection = 1,
+  ControlsSection = 2,
+  AddressesSection = 3
+};
+
+void writeString(QDataStream& s, const char* data, std::size_t size)
+{
+  s << quint32(size);
+  s.writeRawData(data, size);
+}
+
+struct BinaryValueWriter
+{
+  QDataStream& s;
+  void operator()() const { s << quint8(0); }
+  void operator()(const ossia::impulse&) const { s << quint8(0); }
+  void operator()(float f) const { s << quint8(1) << f; }
+  void operator()(int i) const { s << quint8(2) << qint32(i); }
+  void operator()(bool b) const { s << quint8(3) << quint8(b); }
+  void operator()(const std::string& str) const
+  {
+    s << quint8(4);
+    writeString(s, str.data(), str.size());
+  }
+  void operator()(const ossia::vec2f& v) const { s << quint8(5) << v[0] << v[1]; }
+  void operator()(const ossia::vec3f& v) const
+  {
+    s << quint8(6) << v[0] << v[1] << v[2];
+  }
+  void operator()(const ossia::vec4f& v) const
+  {
+    s << quint8(7) << v[0] << v[1] << v[2] << v[3];
+  }
+  void operator()(const std::vector<ossia::value>& v) const
+  {
+    s << quint8(8) << quint32(v.size());
+    for(const auto& val : v)
+      val.apply(*this);
+  }
+};
+
+template <typename F>
+QString intervalsMessage(const std::vector<IntervalProgress>& intervals, F watches)
+{
+  JSONReader r;
+  r.stream.StartObject();
+
+  r.stream.Key("Intervals");
+  r.stream.StartArray();
+  for(const auto& itv : intervals)
+  {
+    if(!watches(itv.handle))
+      continue;
+
+    r.stream.StartObject();
+
+    r.obj[score::StringConstant().Path] = *itv.path;
+
+    r.stream.Key("Progress");
+    r.stream.Double(itv.progress);
+
+    r.stream.Key("Speed");
+    r.stream.Double(itv.speed);
+
+    r.stream.Key("Gain");
+    r.stream.Double(itv.gain);
+
+    r.stream.EndObject();
+  }
+  r.stream.EndArray();
+  r.stream.EndObject();
+
+  return r.toString();
+}
+}
+
+// JSON messages shared by the text clients during a frame
+struct Receiver::TextCache
+{
+  QString intervals;
+  std::vector<QString> controls;
+  std::vector<QString> values;
+};
 DocumentPlugin::DocumentPlugin(const score::DocumentContext& doc, QObject* parent)
     : score::DocumentPlugin{doc, "RemoteControl::DocumentPlugin", parent}
     , receiver{doc, 10212}
@@ -46,7 +141,8 @@ DocumentPlugin::DocumentPlugin(const score::DocumentContext& doc, QObject* paren
       Qt::QueuedConnection);
 
   // TODO put this as a setting instead
-  startTimer(100);
+  // One frame of updates, see Receiver::flush
+  startTimer(16);
 }
 
 DocumentPlugin::~DocumentPlugin() { }
@@ -56,35 +152,25 @@ void DocumentPlugin::timerEvent(QTimerEvent* event)
   if(receiver.clients().size() == 0)
     return;
 
-  JSONReader r;
-  r.stream.StartObject();
+  // The progress of the intervals is sent around 10 times per second
+  if(m_frame++ % 6 != 0)
+  {
+    receiver.flush(nullptr);
+    return;
+  }
 
-  r.stream.Key("Intervals");
-  r.stream.StartArray();
+  m_progress.clear();
   for(auto& it : this->m_intervals)
   {
-    if(*it.second.progress > 0.)
+    auto& itv = it.second;
+    if(*itv.progress > 0.)
     {
-      r.stream.StartObject();
-
-      r.obj[score::StringConstant().Path] = it.second.p;
-
-      r.stream.Key("Progress");
-      r.stream.Double(*it.second.progress);
-
-      r.stream.Key("Speed");
-      r.stream.Double(it.second.model->duration.speed());
-
-      r.stream.Key("Gain");
-      r.stream.Double(it.second.model->outlet->gain());
-
-      r.stream.EndObject();
+      m_progress.push_back(IntervalProgress{
+          receiver.handle(itv.model), &itv.p, float(*itv.progress),
+          float(itv.model->duration.speed()), float(itv.model->outlet->gain())});
     }
   }
-  r.stream.EndArray();
-  r.stream.EndObject();
-
-  receiver.sendMessage(r.toString());
+  receiver.flush(&m_progress);
 }
 
 void DocumentPlugin::registerInterval(Scenario::IntervalModel& m)
@@ -95,6 +181,7 @@ void DocumentPlugin::registerInterval(Scenario::IntervalModel& m)
 void DocumentPlugin::unregisterInterval(Scenario::IntervalModel& m)
 {
   m_intervals.erase(m.id().val());
+  receiver.releaseHandle(&m);
 }
 
 void DocumentPlugin::on_documentClosing()
@@ -213,28 +300,62 @@ Receiver::Receiver(const score::DocumentContext& doc, quint16 port)
         auto d = m_dev.list().findDevice(addr.device);
         if(d)
         {
-          d->valueUpdated.connect<&Receiver::on_valueUpdated>(*this);
-          d->setListening(addr, true);
+          auto& listeners = m_listenedAddresses[addr];
+          if(listeners.empty())
+          {
+            d->valueUpdated.connect<&Receiver::on_valueUpdated>(*this);
+            d->setListening(addr, true);
+          }
 
-          m_listenedAddresses.insert(std::make_pair(addr, c));
+          if(ossia::find(listeners, c) == listeners.end())
+            listeners.push_back(c);
         }
       }));
 
   m_answers.insert(std::make_pair(
-      "DisableListening", [&](const rapidjson::Value& obj, const WSClient&) {
+      "DisableListening", [&](const rapidjson::Value& obj, const WSClient& c) {
         auto it = obj.FindMember(score::StringConstant().Address);
         if(it == obj.MemberEnd())
           return;
 
         auto addr = score::unmarshall<::State::Address>(it->value);
+        auto listeners = m_listenedAddresses.find(addr);
+        if(listeners == m_listenedAddresses.end())
+          return;
+
+        // Other clients may still listen to the address
+        auto& clts = listeners.value();
+        ossia::remove_erase(clts, c);
+        if(!clts.empty())
+          return;
+
+        m_listenedAddresses.erase(listeners);
         auto d = m_dev.list().findDevice(addr.device);
         if(d)
         {
           d->valueUpdated.disconnect<&Receiver::on_valueUpdated>(*this);
           d->setListening(addr, false);
-          m_listenedAddresses.erase(addr);
         }
       }));
+
+  m_answers.insert(std::make_pair(
+      "EnableBinary", [this](const rapidjson::Value&, const WSClient& c) {
+        auto& st = m_states[c.socket];
+        st.binary = true;
+        st.sentIntervals.clear();
+      }));
+  m_answers.insert(std::make_pair(
+      "EnableBatching", [this](const rapidjson::Value&, const WSClient& c) {
+        m_states[c.socket].batched = true;
+      }));
+  m_answers.insert(std::make_pair(
+      "Subscribe", [this](const rapidjson::Value& obj, const WSClient& c) {
+        subscribe(obj, c, true);
+      }));
+  m_answers.insert(std::make_pair(
+      "Unsubscribe", [this](const rapidjson::Value& obj, const WSClient& c) {
+        subscribe(obj, c, false);
+      }));
 }
 
 Receiver::~Receiver()
@@ -350,6 +471,7 @@ void Receiver::onNewConnection()
   }
 
   m_clients.push_back(client);
+  m_states[client.socket] = ClientState{};
 }
 
 void Receiver::processTextMessage(const QString& message, const WSClient& w)
@@ -409,34 +531,278 @@ void Receiver::socketDisconnected()
         h.onClientDisconnection(clt);
     }
 
+    for(auto it = m_listenedAddresses.begin(); it != m_listenedAddresses.end();)
     {
-      auto it = ossia::find_if(m_listenedAddresses, [=](const auto& pair) {
-        if(pair.second.socket == pClient)
-          return true;
-        return false;
-      });
-      if(it != m_listenedAddresses.end())
-        m_listenedAddresses.erase(it);
+      ossia::remove_erase(it.value(), clt);
+      if(it->second.empty())
+        it = m_listenedAddresses.erase(it);
+      else
+        ++it;
     }
 
+    m_states.erase(pClient);
     ossia::remove_erase(m_clients, clt);
     pClient->deleteLater();
   }
 }
 
 void Receiver::on_valueUpdated(const ::State::Address& addr, const ossia::value& v)
+{
+  if(m_listenedAddresses.find(addr) == m_listenedAddresses.end())
+    return;
+
+  auto [it, inserted] = m_pendingValueIndex.try_emplace(addr, m_pendingValues.size());
+  if(inserted)
+    m_pendingValues.emplace_back(addr, v);
+  else
+    m_pendingValues[it->second].second = v;
+}
+
+void Receiver::subscribe(const rapidjson::Value& obj, const WSClient& c, bool sub)
+{
+  auto it = obj.FindMember("Handles");
+  if(it == obj.MemberEnd() || !it->value.IsArray())
+    return;
+
+  auto& st = m_states[c.socket];
+  st.filtered = true;
+  for(const auto& h : it->value.GetArray())
+  {
+    if(!h.IsUint())
+      continue;
+
+    if(sub)
+    {
+      st.subscriptions.insert(h.GetUint());
+    }
+    else
+    {
+      st.subscriptions.erase(h.GetUint());
+      st.sentIntervals.erase(h.GetUint());
+    }
+  }
+}
+
+uint32_t Receiver::handle(const QObject* obj)
+{
+  auto [it, inserted] = m_handles.try_emplace(obj, m_nextHandle);
+  if(inserted)
+    m_nextHandle++;
+  return it->second;
+}
+
+void Receiver::releaseHandle(const QObject* obj)
+{
+  auto it = m_handles.find(obj);
+  if(it == m_handles.end())
+    return;
+
+  const uint32_t h = it->second;
+  m_handles.erase(it);
+  for(auto it = m_states.begin(); it != m_states.end(); ++it)
+  {
+    it.value().subscriptions.erase(h);
+    it.value().sentIntervals.erase(h);
+  }
+}
+
+void Receiver::pushControl(
+    const Process::ProcessModel& proc, const Process::ControlInlet& inl)
+{
+  if(m_clients.empty())
+    return;
+
+  PendingControl ctl{handle(&proc), &proc, &inl};
+  auto [it, inserted]
+      = m_pendingControlIndex.try_emplace(&inl, m_pendingControls.size());
+  if(inserted)
+    m_pendingControls.push_back(std::move(ctl));
+  else
+    m_pendingControls[it->second] = std::move(ctl);
+}
+
+void Receiver::flush(const std::vector<IntervalProgress>* intervals)
+{
+  m_frame++;
+
+  TextCache cache;
+  for(auto& clt : m_clients)
+  {
+    auto& st = m_states[clt.socket];
+    if(st.binary)
+      sendBinaryFrame(clt, st, intervals);
+    else
+      sendTextFrame(clt, st, intervals, cache);
+  }
+
+  m_pendingControls.clear();
+  m_pendingControlIndex.clear();
+  m_pendingValues.clear();
+  m_pendingValueIndex.clear();
+}
+
+bool Receiver::listens(const ::State::Address& addr, const WSClient& clt) const noexcept
 {
   auto it = m_listenedAddresses.find(addr);
-  if(it != m_listenedAddresses.end())
+  return it != m_listenedAddresses.end() && ossia::contains(it->second, clt);
+}
+
+void Receiver::sendTextFrame(
+    const WSClient& clt, const ClientState& st,
+    const std::vector<IntervalProgress>* intervals, TextCache& cache)
+{
+  auto sock = clt.socket;
+
+  // Batching clients get all the messages of the frame in a JSON array
+  QString batch;
+  auto send = [&](const QString& json) {
+    if(!st.batched)
+    {
+      sock->sendTextMessage(json);
+      return;
+    }
+    batch += batch.isEmpty() ? u'[' : u',';
+    batch += json;
+  };
+
+  if(intervals)
+  {
+    if(!st.filtered)
+    {
+      if(cache.intervals.isEmpty())
+        cache.intervals = intervalsMessage(*intervals, [](uint32_t) { return true; });
+      send(cache.intervals);
+    }
+    else
+    {
+      send(intervalsMessage(*intervals, [&st](uint32_t h) { return st.watches(h); }));
+    }
+  }
+
+  cache.controls.resize(m_pendingControls.size());
+  for(std::size_t i = 0; i < m_pendingControls.size(); i++)
+  {
+    const auto& ctl = m_pendingControls[i];
+    if(!ctl.process || !ctl.inlet || !st.watches(ctl.handle))
+      continue;
+
+    auto& json = cache.controls[i];
+    if(json.isEmpty())
+    {
+      JSONReader r;
+      r.stream.StartObject();
+      r.obj[score::StringConstant().Message] = "ControlSurfaceControl"sv;
+      r.obj[score::StringConstant().Path] = Path{*ctl.process};
+      r.obj["Control"] = ctl.inlet->id();
+      r.obj[score::StringConstant().Value] = ctl.inlet->value();
+      r.stream.EndObject();
+      json = r.toString();
+    }
+    send(json);
+  }
+
+  cache.values.resize(m_pendingValues.size());
+  for(std::size_t i = 0; i < m_pendingValues.size(); i++)
+  {
+    const auto& [addr, v] = m_pendingValues[i];
+    if(!listens(addr, clt))
+      continue;
+
+    auto& json = cache.values[i];
+    if(json.isEmpty())
+    {
+      ::State::Message m{::State::AddressAccessor{addr}, v};
+
+      JSONObject::Serializer s;
+      s.readFrom(m);
+      s.obj[score::StringConstant().Message] = score::StringConstant().Message;
+      json = s.toString();
+    }
+    send(json);
+  }
+
+  if(!batch.isEmpty())
+  {
+    batch += u']';
+    sock->sendTextMessage(batch);
+  }
+}
+
+void Receiver::sendBinaryFrame(
+    const WSClient& clt, ClientState& st, const std::vector<IntervalProgress>* intervals)
+{
+  QByteArray buf;
+  QDataStream s{&buf, QIODevice::WriteOnly};
+  s.setByteOrder(QDataStream::BigEndian);
+  s.setFloatingPointPrecision(QDataStream::SinglePrecision);
+  s << binary_protocol_version << quint32(m_frame);
+  const auto header_size = buf.size();
+
+  if(intervals)
   {
-    ::State::Message m{::State::AddressAccessor{addr}, v};
+    // Only the intervals whose state changed since the last frame are sent
+    std::vector<const IntervalProgress*> changed;
+    for(const auto& itv : *intervals)
+    {
+      if(!st.watches(itv.handle))
+        continue;
+
+      const IntervalState cur{itv.progress, itv.speed, itv.gain};
+      auto [it, inserted] = st.sentIntervals.try_emplace(itv.handle, cur);
+      if(!inserted)
+      {
+        if(it->second == cur)
+          continue;
+        it.value() = cur;
+      }
+      changed.push_back(&itv);
+    }
 
-    JSONObject::Serializer s;
-    s.readFrom(m);
-    s.obj[score::StringConstant().Message] = score::StringConstant().Message;
-    QWebSocket* w = it->second.socket;
-    w->sendTextMessage(s.toString());
+    if(!changed.empty())
+    {
+      s << quint8(IntervalsSection) << quint32(changed.size());
+      for(auto itv : changed)
+        s << quint32(itv->handle) << itv->progress << itv->speed << itv->gain;
+    }
   }
+
+  {
+    std::vector<const PendingControl*> controls;
+    for(const auto& ctl : m_pendingControls)
+      if(ctl.process && ctl.inlet && st.watches(ctl.handle))
+        controls.push_back(&ctl);
+
+    if(!controls.empty())
+    {
+      s << quint8(ControlsSection) << quint32(controls.size());
+      for(auto ctl : controls)
+      {
+        s << quint32(ctl->handle) << qint32(ctl->inlet->id().val());
+        ctl->inlet->value().apply(BinaryValueWriter{s});
+      }
+    }
+  }
+
+  {
+    std::vector<const std::pair<::State::Address, ossia::value>*> values;
+    for(const auto& val : m_pendingValues)
+      if(listens(val.first, clt))
+        values.push_back(&val);
+
+    if(!values.empty())
+    {
+      s << quint8(AddressesSection) << quint32(values.size());
+      for(auto val : values)
+      {
+        const auto addr = val->first.toString().toUtf8();
+        writeString(s, addr.constData(), addr.size());
+        val->second.apply(BinaryValueWriter{s});
+      }
+    }
+  }
+
+  if(buf.size() > header_size)
+    clt.socket->sendBinaryMessage(buf);
 }
 
 }
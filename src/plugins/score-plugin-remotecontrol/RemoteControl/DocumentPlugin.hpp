@@ -5,8 +5,11 @@
 #include <score/tools/std/StringHash.hpp>
 
 #include <ossia/detail/flat_map.hpp>
+#include <ossia/detail/flat_set.hpp>
 #include <ossia/detail/hash_map.hpp>
 
+#include <QPointer>
+
 #include <QtWebSockets/QWebSocket>
 #include <QtWebSockets/QWebSocketServer>
 
@@ -28,6 +31,11 @@ namespace Scenario
 class IntervalModel;
 class TimeSyncModel;
 }
+namespace Process
+{
+class ProcessModel;
+class ControlInlet;
+}
 namespace RemoteControl
 {
 class Interval;
@@ -79,6 +87,47 @@ struct Handler
   }
 };
 
+//! State of a running interval, sent periodically to the clients
+struct IntervalProgress
+{
+  uint32_t handle{};
+  const Path<Scenario::IntervalModel>* path{};
+  float progress{};
+  float speed{};
+  float gain{};
+};
+
+/**
+ * @brief WebSocket server of the remote control protocol.
+ *
+ * Notifications (device tree, triggers, intervals and control surfaces
+ * being added or removed...) are sent as JSON text messages.
+ * The "Added" messages carry a "Handle" which identifies the object in the
+ * updates, and in the following client messages:
+ *
+ * - {"Message": "EnableBinary"}: updates are sent in the binary format.
+ * - {"Message": "EnableBatching"}: the JSON updates of a frame are sent in a
+ *   single text message, as an array of the usual messages.
+ * - {"Message": "Subscribe", "Handles": [...]}: only the updates of the
+ *   given objects are sent. Clients which never subscribed get everything.
+ * - {"Message": "Unsubscribe", "Handles": [...]}
+ *
+ * Updates (interval progress, control and listened address values) are
+ * coalesced and sent once per frame, see flush().
+ * For binary clients, a frame is a single big-endian binary message:
+ *
+ * - u8 version, u32 frame number
+ * - sections, each one being u8 kind, u32 count, then the entries:
+ *   - 1 (intervals): u32 handle, f32 progress, f32 speed, f32 gain.
+ *     Intervals are only sent when their state changed since the previous
+ *     frame sent to the client.
+ *   - 2 (controls): u32 process handle, i32 control id, value
+ *   - 3 (addresses): u32 length + utf-8 address, value
+ *
+ * Values are an u8 tag followed by the data: 0 (none / impulse),
+ * 1 (f32), 2 (i32), 3 (u8 bool), 4 (u32 length + utf-8 string),
+ * 5 / 6 / 7 (2 / 3 / 4 f32), 8 (u32 count + values).
+ */
 struct SCORE_PLUGIN_REMOTECONTROL_EXPORT Receiver
     : public QObject
     , public Nano::Observer
@@ -105,8 +154,68 @@ public:
 
   const std::vector<WSClient>& clients() const noexcept { return m_clients; }
 
+  //! Identifier of an object in the updates, valid until releaseHandle.
+  uint32_t handle(const QObject* obj);
+  void releaseHandle(const QObject* obj);
+
+  //! The value of the control will be sent with the next frame.
+  void pushControl(const Process::ProcessModel& proc, const Process::ControlInlet& inl);
+
+  /**
+   * @brief Sends the pending updates to the clients.
+   *
+   * Binary clients get a single message per frame.
+   * intervals is null when the interval progress is not part of this frame.
+   */
+  void flush(const std::vector<IntervalProgress>* intervals);
+
 private:
+  struct IntervalState
+  {
+    float progress{};
+    float speed{};
+    float gain{};
+    friend bool operator==(const IntervalState& lhs, const IntervalState& rhs) noexcept
+    {
+      return lhs.progress == rhs.progress && lhs.speed == rhs.speed
+             && lhs.gain == rhs.gain;
+    }
+  };
+
+  struct ClientState
+  {
+    bool binary{};
+    bool batched{};
+    bool filtered{};
+    ossia::flat_set<uint32_t> subscriptions;
+
+    // Last state of the intervals sent to a binary client
+    score::hash_map<uint32_t, IntervalState> sentIntervals;
+
+    bool watches(uint32_t handle) const noexcept
+    {
+      return !filtered || subscriptions.find(handle) != subscriptions.end();
+    }
+  };
+
+  struct PendingControl
+  {
+    uint32_t handle{};
+    QPointer<const Process::ProcessModel> process;
+    QPointer<const Process::ControlInlet> inlet;
+  };
+
   void on_valueUpdated(const ::State::Address& addr, const ossia::value& v);
+  void subscribe(const rapidjson::Value& obj, const WSClient& c, bool sub);
+
+  struct TextCache;
+  void sendTextFrame(
+      const WSClient& clt, const ClientState& st,
+      const std::vector<IntervalProgress>* intervals, TextCache& cache);
+  void sendBinaryFrame(
+      const WSClient& clt, ClientState& st,
+      const std::vector<IntervalProgress>* intervals);
+  bool listens(const ::State::Address& addr, const WSClient& clt) const noexcept;
 
   QWebSocketServer m_server;
   std::vector<WSClient> m_clients;
@@ -116,9 +225,20 @@ private:
 
   score::hash_map<QString, std::function<void(const rapidjson::Value&, const WSClient&)>>
       m_answers;
-  score::hash_map<::State::Address, WSClient> m_listenedAddresses;
+  score::hash_map<::State::Address, std::vector<WSClient>> m_listenedAddresses;
 
   std::vector<std::pair<QObject*, Handler>> m_handlers;
+
+  score::hash_map<QWebSocket*, ClientState> m_states;
+  score::hash_map<const QObject*, uint32_t> m_handles;
+  uint32_t m_nextHandle{1};
+
+  // Updates coalesced until the next frame: only the latest value is sent
+  std::vector<PendingControl> m_pendingControls;
+  score::hash_map<const Process::ControlInlet*, std::size_t> m_pendingControlIndex;
+  std::vector<std::pair<::State::Address, ossia::value>> m_pendingValues;
+  score::hash_map<::State::Address, std::size_t> m_pendingValueIndex;
+  uint32_t m_frame{};
 };
 
 class SCORE_PLUGIN_REMOTECONTROL_EXPORT DocumentPlugin : public score::DocumentPlugin
@@ -148,6 +268,8 @@ private:
   };
 
   ossia::fast_hash_map<int64_t, IntervalData> m_intervals;
+  std::vector<IntervalProgress> m_progress;
+  int m_frame{};
 
   Interval* m_root{};
 };
@@ -30,6 +30,7 @@ public:
 struct RemoteMessages
 {
   Process::ProcessModel& process;
+  uint32_t handle{};
   QString initMessage() const
   {
     using namespace std::literals;
@@ -37,6 +38,7 @@ struct RemoteMessages
     r.stream.StartObject();
     r.obj[score::StringConstant().Message] = "ControlSurfaceAdded"sv;
     r.obj[score::StringConstant().Path] = Path{process};
+    r.obj["Handle"] = handle;
     r.obj[score::StringConstant().Name] = process.metadata().getName();
     r.obj[score::StringConstant().Label] = process.metadata().getLabel();
 
@@ -58,19 +60,6 @@ struct RemoteMessages
     return r.toString();
   }
 
-  QString controlMessage(const Process::ControlInlet& inl) const
-  {
-    using namespace std::literals;
-    JSONReader r;
-    r.stream.StartObject();
-    r.obj[score::StringConstant().Message] = "ControlSurfaceControl"sv;
-    r.obj[score::StringConstant().Path] = Path{process};
-    r.obj["Control"] = inl.id();
-    r.obj[score::StringConstant().Value] = inl.value();
-    r.stream.EndObject();
-    return r.toString();
-  }
-
   void
   controlSurface(const rapidjson::Value& obj, const score::DocumentContext& doc) const
   {
@@ -117,7 +106,7 @@ DefaultProcessComponent::DefaultProcessComponent(
 {
   con(proc, &Process::ProcessModel::startExecution, this, [this] {
     RemoteControl::Handler h;
-    RemoteMessages msgs{process()};
+    RemoteMessages msgs{process(), system().receiver.handle(&process())};
 
     h.setupDefaultHandler(msgs);
 
@@ -128,8 +117,7 @@ DefaultProcessComponent::DefaultProcessComponent(
 
     process().forEachControl([&](const Process::ControlInlet& inl, auto& val) {
       con(inl, &Process::ControlInlet::valueChanged, this, [this, &inl] {
-        RemoteMessages msgs{process()};
-        system().receiver.sendMessage(msgs.controlMessage(inl));
+        system().receiver.pushControl(process(), inl);
       });
     });
 
@@ -148,11 +136,13 @@ DefaultProcessComponent::DefaultProcessComponent(
 DefaultProcessComponent::~DefaultProcessComponent()
 {
   system().receiver.removeHandler(this);
+  system().receiver.releaseHandle(&process());
 }
 
 struct IntervalMessages
 {
   Scenario::IntervalModel& model;
+  uint32_t handle{};
   QString initMessage() const
   {
     using namespace std::literals;
@@ -160,6 +150,7 @@ struct IntervalMessages
     r.stream.StartObject();
     r.obj[score::StringConstant().Message] = "IntervalAdded"sv;
     r.obj[score::StringConstant().Path] = Path{model};
+    r.obj["Handle"] = handle;
     r.obj[score::StringConstant().Name] = model.metadata().getName();
     r.obj[score::StringConstant().Label] = model.metadata().getLabel();
     r.obj[score::StringConstant().Comment] = model.metadata().getComment();
@@ -249,7 +240,7 @@ IntervalBase::IntervalBase(
         recv.removeHandler(this);
 
         RemoteControl::Handler h;
-        IntervalMessages msgs{this->interval()};
+        IntervalMessages msgs{this->interval(), recv.handle(&this->interval())};
 
         h.setupDefaultHandler(msgs);
 
@@ -135,7 +135,7 @@ void ScenarioValidityChecker::checkValidity(const ProcessModel& scenar)
     */
   }
 
-  std::vector st(scenar.states.map().m_order.begin(), scenar.states.map().m_order.end());
+  auto st = scenar.states.map().as_vec();
   for(StateModel* sstate : st)
   {
     auto& state = *sstate;
@@ -19,18 +19,15 @@ PutProcessBefore::PutProcessBefore(
     , m_proc2{std::move(proc2)}
 {
   auto& id_map = cst.processes.map();
-  auto& hash = id_map.m_map;
-  auto& seq = id_map.m_order;
 
   // 1. Find elements
-  auto it2_hash = hash.find(proc2);
-  SCORE_ASSERT(it2_hash != hash.end());
+  auto it2 = id_map.find(proc2);
+  SCORE_ASSERT(it2 != id_map.end());
 
-  std::list<Process::ProcessModel*>::const_iterator it2_order = it2_hash.value().second;
-  auto next = it2_order++;
-  if(next != seq.end())
+  auto next = ++it2;
+  if(next != id_map.end())
   {
-    m_old_after_proc2 = (*next)->id();
+    m_old_after_proc2 = next->id();
   }
   else
   {
@@ -55,35 +52,11 @@ void PutProcessBefore::putBefore(
   auto& cst = m_path.find(ctx);
 
   auto& id_map = cst.processes.unsafe_map();
-  auto& hash = id_map.m_map;
-  auto& seq = id_map.m_order;
 
   if(t1 == t2)
     return;
 
-  // 1. Find elements
-  auto it2_hash = hash.find(t2);
-  SCORE_ASSERT(it2_hash != hash.end());
-  auto& it2_order = it2_hash.value().second;
-
-  if(t1)
-  {
-    // put before t1
-    auto it1_hash = hash.find(*t1);
-    SCORE_ASSERT(it1_hash != hash.end());
-    auto& it1_order = it1_hash.value().second;
-
-    auto new_it2 = seq.insert(it1_order, *it2_order);
-    seq.erase(it2_order);
-    it2_order = new_it2;
-  }
-  else
-  {
-    // put at end
-    auto new_it2 = seq.insert(seq.end(), *it2_order);
-    seq.erase(it2_order);
-    it2_order = new_it2;
-  }
+  id_map.put_before(t2, t1 ? &*t1 : nullptr);
 
   cst.processes.orderChanged();
 }
@@ -106,18 +79,15 @@ PutStateProcessBefore::PutStateProcessBefore(
     , m_proc2{std::move(proc2)}
 {
   auto& id_map = cst.stateProcesses.map();
-  auto& hash = id_map.m_map;
-  auto& seq = id_map.m_order;
 
   // 1. Find elements
-  auto it2_hash = hash.find(proc2);
-  SCORE_ASSERT(it2_hash != hash.end());
+  auto it2 = id_map.find(proc2);
+  SCORE_ASSERT(it2 != id_map.end());
 
-  std::list<Process::ProcessModel*>::const_iterator it2_order = it2_hash.value().second;
-  auto next = it2_order++;
-  if(next != seq.end())
+  auto next = ++it2;
+  if(next != id_map.end())
   {
-    m_old_after_proc2 = (*next)->id();
+    m_old_after_proc2 = next->id();
   }
   else
   {
@@ -142,35 +112,11 @@ void PutStateProcessBefore::putBefore(
   auto& cst = m_path.find(ctx);
 
   auto& id_map = cst.stateProcesses.unsafe_map();
-  auto& hash = id_map.m_map;
-  auto& seq = id_map.m_order;
 
   if(t1 == t2)
     return;
 
-  // 1. Find elements
-  auto it2_hash = hash.find(t2);
-  SCORE_ASSERT(it2_hash != hash.end());
-  auto& it2_order = it2_hash.value().second;
-
-  if(t1)
-  {
-    // put before t1
-    auto it1_hash = hash.find(*t1);
-    SCORE_ASSERT(it1_hash != hash.end());
-    auto& it1_order = it1_hash.value().second;
-
-    auto new_it2 = seq.insert(it1_order, *it2_order);
-    seq.erase(it2_order);
-    it2_order = new_it2;
-  }
-  else
-  {
-    // put at end
-    auto new_it2 = seq.insert(seq.end(), *it2_order);
-    seq.erase(it2_order);
-    it2_order = new_it2;
-  }
+  id_map.put_before(t2, t1 ? &*t1 : nullptr);
 
   cst.stateProcesses.orderChanged();
 }
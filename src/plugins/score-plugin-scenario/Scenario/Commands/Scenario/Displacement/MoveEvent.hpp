@@ -5,6 +5,7 @@
 #include <Scenario/Application/ScenarioValidity.hpp>
 #include <Scenario/Commands/Scenario/Displacement/SerializableMoveEvent.hpp>
 #include <Scenario/Commands/ScenarioCommandFactory.hpp>
+#include <Scenario/Process/Algorithms/DisplacementSolver.hpp>
 #include <Scenario/Process/Algorithms/StandardDisplacementPolicy.hpp>
 #include <Scenario/Process/ScenarioModel.hpp>
 #include <Scenario/Tools/dataStructures.hpp>
@@ -73,7 +74,7 @@ public:
       , m_lock{lock}
   {
     auto& s = const_cast<Scenario::ProcessModel&>(scenario);
-    DisplacementPolicy::init(s, {scenario.event(eventId).timeSync()});
+    DisplacementPolicy::init(s, {scenario.event(eventId).timeSync()}, m_solver);
     // we need to compute the new time delta and store this initial event id
     // for recalculate the delta on updates
     // NOTE: in the future in would be better to give directly the delta value
@@ -105,7 +106,7 @@ public:
 
     // the displacement is computed here and we don't need to know how.
     DisplacementPolicy::computeDisplacement(
-        scenario, draggedElements, deltaDate, m_savedElementsProperties);
+        scenario, draggedElements, deltaDate, m_savedElementsProperties, m_solver);
   }
 
   void undo(const score::DocumentContext& ctx) const override
@@ -157,6 +158,9 @@ private:
   ElementsProperties m_savedElementsProperties;
   Path<Scenario::ProcessModel> m_path;
 
+  // Subgraph affected by the move, computed when the move starts
+  DisplacementSolver m_solver;
+
   ExpandMode m_mode{ExpandMode::Scale};
   LockMode m_lock{LockMode::Free};
 
@@ -31,6 +31,7 @@
 #include <Scenario/Document/ScenarioDocument/MusicalGrid.hpp>
 #include <Scenario/Document/ScenarioDocument/ScenarioDocumentPresenter.hpp>
 #include <Scenario/Process/ScenarioModel.hpp>
+#include <Scenario/Process/ScenarioSpatialIndex.hpp>
 #include <Scenario/Settings/ScenarioSettingsModel.hpp>
 
 #include <Automation/AutomationColors.hpp>
@@ -621,16 +622,9 @@ Process::MagneticInfo FullViewIntervalPresenter::magneticPosition(
   {
     if(auto scenario = qobject_cast<Scenario::ProcessModel*>(given_ts->parent()))
     {
-      for(auto& ts : scenario->timeSyncs)
-      {
-        if(given_ts == &ts)
-          continue;
+      if(auto ts = scenario->spatialIndex().closestTimeSync(t, given_ts))
+        closestTimeSyncT = ts->date();
 
-        if(std::abs(ts.date().impl - t.impl) < std::abs(closestTimeSyncT.impl - t.impl))
-        {
-          closestTimeSyncT = ts.date();
-        }
-      }
       double delta = std::abs((closestTimeSyncT - t).toPixels(m_zoomRatio));
       if(delta < 10)
       {
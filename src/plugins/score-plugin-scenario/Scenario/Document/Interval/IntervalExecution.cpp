@@ -1,5 +1,6 @@
 // This is an open source non-commercial project. Dear PVS-Studio, please check
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <Process/Execution/FeedbackQueue.hpp>
 #include <Process/Execution/ProcessComponent.hpp>
 #include <Process/ExecutionContext.hpp>
 #include <Process/ExecutionSetup.hpp>
@@ -345,11 +346,12 @@ void IntervalComponent::onSetup(
 
     if(Q_UNLIKELY(interval().graphal()))
     {
-      in_exec([weak_self, ossia_cst, &edit = system().editionQueue] {
+      in_exec([weak_self, ossia_cst, &feedback = system().feedbackQueue] {
         ossia_cst->set_stateless_callback(
             smallfun::function<void(bool, ossia::time_value), 32>{
-                [weak_self, &edit](bool running, ossia::time_value date) {
-          edit.enqueue([weak_self, running, date] {
+                [weak_self, &feedback, key = ossia_cst.get()](
+                    bool running, ossia::time_value date) {
+          feedback.enqueue(key, [weak_self, running, date] {
             if(auto self = weak_self.lock())
               self->graph_slot_callback(running, date);
           });
@@ -358,11 +360,12 @@ void IntervalComponent::onSetup(
     }
     else
     {
-      in_exec([weak_self, ossia_cst, &edit = system().editionQueue] {
+      in_exec([weak_self, ossia_cst, &feedback = system().feedbackQueue] {
         ossia_cst->set_stateless_callback(
             smallfun::function<void(bool, ossia::time_value), 32>{
-                [weak_self, &edit](bool running, ossia::time_value date) {
-          edit.enqueue([weak_self, running, date] {
+                [weak_self, &feedback, key = ossia_cst.get()](
+                    bool running, ossia::time_value date) {
+          feedback.enqueue(key, [weak_self, running, date] {
             if(auto self = weak_self.lock())
               self->slot_callback(running, date);
           });
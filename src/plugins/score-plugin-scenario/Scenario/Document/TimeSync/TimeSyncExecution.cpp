@@ -2,6 +2,7 @@
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include "TimeSyncExecution.hpp"
 
+#include <Process/Execution/FeedbackQueue.hpp>
 #include <Process/ExecutionContext.hpp>
 
 #include <Explorer/DocumentPlugin/DeviceDocumentPlugin.hpp>
@@ -73,15 +74,15 @@ ossia::expression_ptr TimeSyncComponent::makeTrigger() const
 struct TimeSyncExecutionCallbacks : public ossia::time_sync_callback
 {
   explicit TimeSyncExecutionCallbacks(
-      EditionCommandQueue& e, const QPointer<const Scenario::TimeSyncModel>& p)
-      : edit{e}
+      FeedbackQueue& f, const QPointer<const Scenario::TimeSyncModel>& p)
+      : feedback{f}
       , score_node{p}
   {
   }
 
   void entered_triggering() override
   {
-    edit.enqueue([score_node = this->score_node] {
+    feedback.enqueue(this, [score_node = this->score_node] {
       if(score_node)
       {
         auto v = const_cast<Scenario::TimeSyncModel*>(score_node.data());
@@ -94,7 +95,7 @@ struct TimeSyncExecutionCallbacks : public ossia::time_sync_callback
 
   void left_evaluation() override
   {
-    edit.enqueue([score_node = this->score_node] {
+    feedback.enqueue(this, [score_node = this->score_node] {
       if(score_node)
       {
         auto v = const_cast<Scenario::TimeSyncModel*>(score_node.data());
@@ -106,7 +107,7 @@ struct TimeSyncExecutionCallbacks : public ossia::time_sync_callback
   void finished_evaluation(bool) override { left_evaluation(); }
 
 private:
-  EditionCommandQueue& edit;
+  FeedbackQueue& feedback;
   QPointer<const Scenario::TimeSyncModel> score_node;
 };
 
@@ -125,7 +126,7 @@ void TimeSyncComponent::onSetup(
     }
 
     m_ossia_node->callbacks.callbacks.push_back(
-        new TimeSyncExecutionCallbacks{system().editionQueue, this->m_score_node});
+        new TimeSyncExecutionCallbacks{system().feedbackQueue, this->m_score_node});
   }
 }
 
@@ -758,10 +758,10 @@ bool ObjectItemModel::canDropMimeData(
       return false;
     if(row < itv->processes.size())
     {
-      auto pb = itv->processes.map().m_order.begin();
+      auto pb = itv->processes.begin();
       std::advance(pb, row);
 
-      the_proc = *pb;
+      the_proc = &*pb;
       // Row: the row before the process
       if(other == the_proc)
         return false;
@@ -779,10 +779,10 @@ bool ObjectItemModel::canDropMimeData(
 
     if(row < sta->stateProcesses.size())
     {
-      auto pb = sta->stateProcesses.map().m_order.begin();
+      auto pb = sta->stateProcesses.begin();
       std::advance(pb, row);
 
-      the_proc = *pb;
+      the_proc = &*pb;
       // Row: the row before the process
       if(other == the_proc)
         return false;
@@ -834,10 +834,10 @@ bool ObjectItemModel::dropMimeData(
 
     if(row < itv->processes.size())
     {
-      auto pb = itv->processes.map().m_order.begin();
+      auto pb = itv->processes.begin();
       std::advance(pb, row);
 
-      auto the_proc = *pb;
+      auto the_proc = &*pb;
       // Row: the row before the process
       if(other == the_proc)
         return false;
@@ -861,10 +861,10 @@ bool ObjectItemModel::dropMimeData(
 
     if(row < sta->stateProcesses.size())
     {
-      auto pb = sta->stateProcesses.map().m_order.begin();
+      auto pb = sta->stateProcesses.begin();
       std::advance(pb, row);
 
-      auto the_proc = *pb;
+      auto the_proc = &*pb;
       // Row: the row before the process
       if(other == the_proc)
         return false;
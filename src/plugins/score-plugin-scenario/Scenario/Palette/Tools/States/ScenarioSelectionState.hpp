@@ -5,11 +5,14 @@
 #include <Scenario/Document/TimeSync/TimeSyncView.hpp>
 #include <Scenario/Palette/Tools/StateSelection.hpp>
 #include <Scenario/Process/ScenarioGlobalCommandManager.hpp>
+#include <Scenario/Process/ScenarioSpatialIndex.hpp>
 
 #include <score/statemachine/CommonSelectionState.hpp>
 
 #include <QPointF>
 
+#include <limits>
+
 namespace Scenario
 {
 class ToolPalette;
@@ -73,47 +76,86 @@ public:
     auto& presenter = m_parentSM.presenter();
     auto& model = m_parentSM.model();
 
-    for(const auto& elt : presenter.getIntervals())
-    {
-      if(area.intersects(elt.view()->boundingRect().translated(elt.view()->pos())))
-      {
-        sel.append(elt.model());
-      }
-    }
+    auto intersects = [&](const auto& view) {
+      return area.intersects(view.boundingRect().translated(view.pos()));
+    };
 
     if constexpr(std::is_same_v<
                      std::remove_const_t<std::remove_reference_t<decltype(presenter)>>,
                      Scenario::ScenarioPresenter>)
     {
+      // Only the elements indexed close to the area have to be checked.
+      // The margin accounts for the extent of the items around their position.
+      const double margin = 20.;
+      const auto topLeft
+          = presenter.toScenarioPoint(area.topLeft() - QPointF{margin, margin});
+      const auto bottomRight
+          = presenter.toScenarioPoint(area.bottomRight() + QPointF{margin, margin});
+      const auto& index = model.spatialIndex();
+
+      auto presenterOf = [](const auto& presenters, const auto& elt) {
+        auto it = presenters.m_map.find(elt->id());
+        return it != presenters.m_map.end() ? it->second : nullptr;
+      };
+
+      // The rack of an interval extends below it
+      for(auto itv : index.intervals(
+              topLeft.date, bottomRight.date, std::numeric_limits<double>::lowest(),
+              bottomRight.y))
+      {
+        if(auto p = presenterOf(presenter.getIntervals(), itv))
+          if(intersects(*p->view()))
+            sel.append(*itv);
+      }
+
       for(const auto& elt : presenter.getGraphIntervals())
       {
-        if(area.intersects(elt.boundingRect().translated(elt.pos())))
-        {
+        if(intersects(elt))
           sel.append(elt.model());
-        }
       }
-    }
 
-    for(const auto& elt : presenter.getTimeSyncs())
-    {
-      if(area.intersects(elt.view()->boundingRect().translated(elt.view()->pos())))
+      for(auto ts : index.timeSyncs(topLeft.date, bottomRight.date))
       {
-        sel.append(elt.model());
+        if(auto p = presenterOf(presenter.getTimeSyncs(), ts))
+          if(intersects(*p->view()))
+            sel.append(*ts);
       }
-    }
-    for(const auto& elt : presenter.getEvents())
-    {
-      if(area.intersects(elt.view()->boundingRect().translated(elt.view()->pos())))
+
+      for(auto ev : index.events(topLeft.date, bottomRight.date))
       {
-        sel.append(elt.model());
+        if(auto p = presenterOf(presenter.getEvents(), ev))
+          if(intersects(*p->view()))
+            sel.append(*ev);
+      }
+
+      for(auto st : index.states(topLeft.date, bottomRight.date, topLeft.y, bottomRight.y))
+      {
+        if(auto p = presenterOf(presenter.getStates(), st))
+          if(intersects(*p->view()))
+            doStateSelection(sel, *st, model);
       }
     }
-    for(const auto& elt : presenter.getStates())
+    else
     {
-      auto& m = elt.model();
-      if(area.intersects(elt.view()->boundingRect().translated(elt.view()->pos())))
+      for(const auto& elt : presenter.getIntervals())
+      {
+        if(intersects(*elt.view()))
+          sel.append(elt.model());
+      }
+      for(const auto& elt : presenter.getTimeSyncs())
+      {
+        if(intersects(*elt.view()))
+          sel.append(elt.model());
+      }
+      for(const auto& elt : presenter.getEvents())
+      {
+        if(intersects(*elt.view()))
+          sel.append(elt.model());
+      }
+      for(const auto& elt : presenter.getStates())
       {
-        doStateSelection(sel, m, model);
+        if(intersects(*elt.view()))
+          doStateSelection(sel, elt.model(), model);
       }
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <Scenario/Process/Algorithms/Accessors.hpp>
 #include <Scenario/Process/Algorithms/ContainersAccessors.hpp>
+#include <Scenario/Process/Algorithms/DisplacementSolver.hpp>
 #include <Scenario/Process/Algorithms/StandardDisplacementPolicy.hpp>
 #include <Scenario/Tools/dataStructures.hpp>
 
@@ -12,12 +13,12 @@ class ConstrainedDisplacementPolicy
 public:
   static void init(
       Scenario::ProcessModel& scenario,
-      const QVector<Id<TimeSyncModel>>& draggedElements);
+      const QVector<Id<TimeSyncModel>>& draggedElements, DisplacementSolver& solver);
 
   static void computeDisplacement(
       Scenario::ProcessModel& scenario,
       const QVector<Id<TimeSyncModel>>& draggedElements, const TimeVal& deltaTime,
-      ElementsProperties& elementsProperties);
+      ElementsProperties& elementsProperties, DisplacementSolver& solver);
 
   static QString name();
 
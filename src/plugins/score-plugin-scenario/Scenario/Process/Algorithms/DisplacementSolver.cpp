@@ -0,0 +1,160 @@
+#include "DisplacementSolver.hpp"
+
+#include <Scenario/Document/Event/EventModel.hpp>
+#include <Scenario/Document/Interval/IntervalDurations.hpp>
+#include <Scenario/Document/Interval/IntervalModel.hpp>
+#include <Scenario/Document/State/StateModel.hpp>
+#include <Scenario/Document/TimeSync/TimeSyncModel.hpp>
+#include <Scenario/Process/Algorithms/Accessors.hpp>
+#include <Scenario/Process/ScenarioModel.hpp>
+#include <Scenario/Tools/dataStructures.hpp>
+
+#include <score/document/DocumentInterface.hpp>
+
+namespace Scenario
+{
+void DisplacementSolver::clear(const Id<TimeSyncModel>& dragged)
+{
+  m_dragged = dragged;
+  m_initialized = true;
+  m_syncs.clear();
+  m_edges.clear();
+  m_syncIndex.clear();
+  m_minDelta = std::numeric_limits<int64_t>::min();
+  m_maxDelta = std::numeric_limits<int64_t>::max();
+}
+
+void DisplacementSolver::addSync(
+    const Scenario::ProcessModel& scenario, const Id<TimeSyncModel>& id)
+{
+  m_syncIndex[id] = m_syncs.size();
+  m_syncs.push_back({id, scenario.timeSyncs.at(id).date()});
+}
+
+void DisplacementSolver::addEdge(
+    const Scenario::ProcessModel& scenario, const IntervalModel& itv)
+{
+  Edge e;
+  e.id = itv.id();
+
+  const auto& start = Scenario::startTimeSync(itv, scenario);
+  const auto& end = Scenario::endTimeSync(itv, scenario);
+  if(auto it = m_syncIndex.find(start.id()); it != m_syncIndex.end())
+    e.start = it->second;
+  if(auto it = m_syncIndex.find(end.id()); it != m_syncIndex.end())
+    e.end = it->second;
+  e.startDate = start.date();
+  e.endDate = end.date();
+
+  e.defaultDuration = itv.duration.defaultDuration();
+  e.minDuration = itv.duration.minDuration();
+  e.maxDuration = itv.duration.maxDuration();
+
+  // An interval which has only one of its ends moving bounds the delta
+  if(e.start == -1 && e.end != -1)
+    m_minDelta = std::max(m_minDelta, -e.defaultDuration.impl);
+  else if(e.start != -1 && e.end == -1)
+    m_maxDelta = std::min(m_maxDelta, e.defaultDuration.impl);
+
+  m_edges.push_back(e);
+}
+
+void DisplacementSolver::initFollowing(
+    const Scenario::ProcessModel& scenario, const Id<TimeSyncModel>& dragged)
+{
+  clear(dragged);
+
+  // The start of the scenario does not move
+  if(dragged.val() == Scenario::startId_val)
+    return;
+
+  // Breadth-first traversal of the non-graphal intervals after the time sync
+  addSync(scenario, dragged);
+  for(std::size_t i = 0; i < m_syncs.size(); i++)
+  {
+    const auto& tn = scenario.timeSyncs.at(m_syncs[i].id);
+    for(const auto& itv_id : Scenario::nextNonGraphIntervals(tn, scenario))
+    {
+      const auto& next = Scenario::endTimeSync(scenario.intervals.at(itv_id), scenario);
+      if(!m_syncIndex.contains(next.id()))
+        addSync(scenario, next.id());
+    }
+  }
+
+  // The intervals which end on a moving time sync get resized
+  for(std::size_t i = 0; i < m_syncs.size(); i++)
+  {
+    const auto& tn = scenario.timeSyncs.at(m_syncs[i].id);
+    for(const auto& itv_id : Scenario::previousNonGraphIntervals(tn, scenario))
+      addEdge(scenario, scenario.intervals.at(itv_id));
+  }
+}
+
+void DisplacementSolver::initSingle(
+    const Scenario::ProcessModel& scenario, const Id<TimeSyncModel>& dragged)
+{
+  clear(dragged);
+
+  addSync(scenario, dragged);
+
+  const auto& tn = scenario.timeSyncs.at(dragged);
+  for(const auto& itv_id : Scenario::previousNonGraphIntervals(tn, scenario))
+    addEdge(scenario, scenario.intervals.at(itv_id));
+  for(const auto& itv_id : Scenario::nextNonGraphIntervals(tn, scenario))
+    addEdge(scenario, scenario.intervals.at(itv_id));
+}
+
+void DisplacementSolver::apply(
+    const Scenario::ProcessModel& scenario, TimeVal delta, bool clampMin,
+    ElementsProperties& props) const
+{
+  for(const auto& sync : m_syncs)
+  {
+    auto it = props.timesyncs.find(sync.id);
+    if(it == props.timesyncs.end())
+    {
+      TimenodeProperties t;
+      t.oldDate = sync.date;
+      it = props.timesyncs.emplace(sync.id, std::move(t)).first;
+    }
+
+    auto& val = it.value();
+    val.newDate = val.oldDate + delta;
+  }
+
+  QObjectList processesToSave;
+  for(const auto& e : m_edges)
+  {
+    const TimeVal start = e.start != -1 ? m_syncs[e.start].date + delta : e.startDate;
+    const TimeVal end = e.end != -1 ? m_syncs[e.end].date + delta : e.endDate;
+    const TimeVal deltaBounds = (end - start) - e.defaultDuration;
+
+    auto it = props.intervals.find(e.id);
+    if(it == props.intervals.end())
+    {
+      auto& itv = scenario.intervals.at(e.id);
+      IntervalProperties c{itv, false};
+      c.oldDate = e.start != -1 ? m_syncs[e.start].date : e.startDate;
+      c.oldDefault = e.defaultDuration;
+      c.oldMin = e.minDuration;
+      c.oldMax = e.maxDuration;
+      it = props.intervals.emplace(e.id, std::move(c)).first;
+
+      for(auto& proc : itv.processes)
+        processesToSave.append(&proc);
+    }
+
+    auto& c = it.value();
+    c.newMin = c.oldMin + deltaBounds;
+    if(clampMin)
+      c.newMin = std::max(TimeVal::zero(), c.newMin);
+    c.newMax = c.oldMax + deltaBounds;
+  }
+
+  if(!processesToSave.empty())
+  {
+    props.cables = Dataflow::saveCables(
+        processesToSave, score::IDocument::documentContext(scenario));
+  }
+}
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <Process/TimeValue.hpp>
+
+#include <score/model/Identifier.hpp>
+#include <score/tools/std/HashMap.hpp>
+
+#include <score_plugin_scenario_export.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace Scenario
+{
+class ProcessModel;
+class TimeSyncModel;
+class IntervalModel;
+struct ElementsProperties;
+
+/**
+ * @brief Temporal constraints affected by the displacement of a time sync.
+ *
+ * The part of the scenario which is affected by a drag is extracted once,
+ * when the drag starts: the time syncs which move along with the dragged one,
+ * and the intervals which start or end on them, indexed by their position in
+ * the list of moving time syncs.
+ * The range of deltas for which every interval keeps a positive duration is
+ * computed at the same time.
+ *
+ * Each mouse move then only has to apply the delta to this subgraph, instead
+ * of going through the scenario again.
+ */
+class SCORE_PLUGIN_SCENARIO_EXPORT DisplacementSolver
+{
+public:
+  //! The dragged time sync and every time sync after it move together.
+  void initFollowing(
+      const Scenario::ProcessModel& scenario, const Id<TimeSyncModel>& dragged);
+
+  //! Only the dragged time sync moves, the intervals around it are resized.
+  void initSingle(
+      const Scenario::ProcessModel& scenario, const Id<TimeSyncModel>& dragged);
+
+  bool initialized(const Id<TimeSyncModel>& dragged) const noexcept
+  {
+    return m_initialized && m_dragged == dragged;
+  }
+
+  bool accepts(TimeVal delta) const noexcept
+  {
+    return delta.impl >= m_minDelta && delta.impl <= m_maxDelta;
+  }
+
+  TimeVal clamp(TimeVal delta) const noexcept
+  {
+    return TimeVal{std::clamp(delta.impl, m_minDelta, m_maxDelta)};
+  }
+
+  /**
+   * @brief Writes the new dates and durations for a delta.
+   *
+   * Elements which are not in the properties yet are saved from the scenario,
+   * along with the cables of their processes.
+   * If clampMin is set, the minimal durations do not go below zero.
+   */
+  void apply(
+      const Scenario::ProcessModel& scenario, TimeVal delta, bool clampMin,
+      ElementsProperties& props) const;
+
+private:
+  struct Sync
+  {
+    Id<TimeSyncModel> id;
+    TimeVal date;
+  };
+
+  struct Edge
+  {
+    Id<IntervalModel> id;
+
+    // Index of the start and end time syncs in m_syncs, -1 if they do not move
+    int32_t start{-1};
+    int32_t end{-1};
+    TimeVal startDate;
+    TimeVal endDate;
+
+    TimeVal defaultDuration;
+    TimeVal minDuration;
+    TimeVal maxDuration;
+  };
+
+  void clear(const Id<TimeSyncModel>& dragged);
+  void addSync(const Scenario::ProcessModel& scenario, const Id<TimeSyncModel>& id);
+  void addEdge(const Scenario::ProcessModel& scenario, const IntervalModel& itv);
+
+  Id<TimeSyncModel> m_dragged;
+  bool m_initialized{};
+
+  std::vector<Sync> m_syncs;
+  std::vector<Edge> m_edges;
+  score::hash_map<Id<TimeSyncModel>, int32_t> m_syncIndex;
+
+  int64_t m_minDelta{std::numeric_limits<int64_t>::min()};
+  int64_t m_maxDelta{std::numeric_limits<int64_t>::max()};
+};
+}
@@ -14,6 +14,7 @@
 namespace Scenario
 {
 struct ElementsProperties;
+class DisplacementSolver;
 class TimeSyncModel;
 class ProcessModel;
 class GoodOldDisplacementPolicy
@@ -21,18 +22,12 @@ class GoodOldDisplacementPolicy
 public:
   static void init(
       Scenario::ProcessModel& scenario,
-      const QVector<Id<TimeSyncModel>>& draggedElements)
-  {
-  }
+      const QVector<Id<TimeSyncModel>>& draggedElements, DisplacementSolver& solver);
 
   static void computeDisplacement(
       Scenario::ProcessModel& scenario,
       const QVector<Id<TimeSyncModel>>& draggedElements, const TimeVal& deltaTime,
-      ElementsProperties& elementsProperties);
-
-  static void getRelatedTimeSyncs(
-      Scenario::ProcessModel& scenario, const Id<TimeSyncModel>& firstTimeSyncMovedId,
-      std::vector<Id<TimeSyncModel>>& translatedTimeSyncs);
+      ElementsProperties& elementsProperties, DisplacementSolver& solver);
 
   static QString name() { return QString{"Old way"}; }
 
@@ -62,20 +62,32 @@ public:
 
       TimeVal defaultDuration = endDate - date;
 
+      // This is called on every step of a drag: intervals which
+      // did not change since the previous step are left untouched.
+      auto& dur = curInterval.duration;
+      const bool moved = curInterval.date() != date;
+      const bool resized = dur.defaultDuration() != defaultDuration;
+      if(!moved && !resized && dur.minDuration() == curIntervalPropertiesToUpdate.newMin
+         && dur.maxDuration() == curIntervalPropertiesToUpdate.newMax)
+        continue;
+
       // set start date and default duration
       using namespace ossia;
-      if(curInterval.date() != date)
+      if(moved)
       {
         curInterval.setStartDate(date);
       }
-      curInterval.duration.setDefaultDuration(defaultDuration);
+      dur.setDefaultDuration(defaultDuration);
 
-      curInterval.duration.setMinDuration(curIntervalPropertiesToUpdate.newMin);
-      curInterval.duration.setMaxDuration(curIntervalPropertiesToUpdate.newMax);
+      dur.setMinDuration(curIntervalPropertiesToUpdate.newMin);
+      dur.setMaxDuration(curIntervalPropertiesToUpdate.newMax);
 
-      for(auto& process : curInterval.processes)
+      if(resized)
       {
-        scaleMethod(process, defaultDuration);
+        for(auto& process : curInterval.processes)
+        {
+          scaleMethod(process, defaultDuration);
+        }
       }
 
       scenario.intervalMoved(&curInterval);
@@ -24,6 +24,7 @@
 #include <Scenario/Process/Algorithms/Accessors.hpp>
 #include <Scenario/Process/Algorithms/ProcessPolicy.hpp>
 #include <Scenario/Process/ScenarioProcessMetadata.hpp>
+#include <Scenario/Process/ScenarioSpatialIndex.hpp>
 
 #include <score/command/Dispatchers/CommandDispatcher.hpp>
 #include <score/document/DocumentContext.hpp>
@@ -83,6 +84,7 @@ void ProcessModel::init()
   m_outlets.push_back(outlet.get());
 
   m_graph = std::make_unique<TimenodeGraph>(*this);
+  m_spatialIndex = std::make_unique<SpatialIndex>(*this);
 
   auto stopExec = [this] {
     for(EventModel& ev : events)
@@ -27,6 +27,7 @@
 namespace Scenario
 {
 struct TimenodeGraph;
+class SpatialIndex;
 
 /**
  * @brief The core hierarchical and temporal process of score
@@ -60,6 +61,7 @@ public:
   const score::DocumentContext& context() const noexcept { return m_context; }
   void init();
   bool hasCycles() const noexcept;
+  const SpatialIndex& spatialIndex() const noexcept { return *m_spatialIndex; }
 
   ~ProcessModel() override;
 
@@ -188,6 +190,7 @@ private:
   // that goes to the startEvent and add a new state
 
   std::unique_ptr<TimenodeGraph> m_graph;
+  std::unique_ptr<SpatialIndex> m_spatialIndex;
 };
 }
 // TODO this ought to go in Selection.hpp ?
@@ -16,12 +16,14 @@
 #include <Scenario/Commands/Scenario/Displacement/MoveCommentBlock.hpp>
 #include <Scenario/Document/Interval/Graph/GraphIntervalPresenter.hpp>
 #include <Scenario/Document/State/ItemModel/MessageItemModel.hpp>
+#include <Scenario/Process/ScenarioSpatialIndex.hpp>
 #include <Scenario/Process/ScenarioView.hpp>
 
 #include <score/actions/ActionManager.hpp>
 
 #include <QAction>
 #include <QDebug>
+#include <QGraphicsView>
 #include <QMenu>
 #include <QTimer>
 
@@ -412,14 +414,11 @@ void ScenarioPresenter::on_askUpdate()
 
 void ScenarioPresenter::on_intervalExecutionTimer()
 {
-  // TODO optimize me by storing a list of the currently running intervals
-  // TODO loop
-
-  for(TemporalIntervalPresenter& cst : m_intervals)
-  {
+  // Only the intervals in the visible part of the scenario need to be redrawn
+  auto updateInterval = [this](TemporalIntervalPresenter& cst) {
     const auto& m = cst.model();
     if(!m.executing())
-      continue;
+      return;
 
     auto& v = *cst.view();
     const auto& dur = m.duration;
@@ -456,9 +455,39 @@ void ScenarioPresenter::on_intervalExecutionTimer()
       QRectF toUpdate = {r.x() + v.minWidth() - 2., r.y(), new_w, 6.};
       v.update(toUpdate);
     }
+  };
+
+  const auto visible = visibleRect();
+  if(!visible || m_zoomRatio <= 0.)
+  {
+    for(TemporalIntervalPresenter& cst : m_intervals)
+      updateInterval(cst);
+    return;
+  }
+  if(visible->isEmpty())
+    return;
+
+  const auto start = TimeVal::fromPixels(visible->left(), m_zoomRatio);
+  const auto end = TimeVal::fromPixels(visible->right(), m_zoomRatio);
+  for(auto itv : model().spatialIndex().intervals(
+          start, end, std::numeric_limits<double>::lowest(),
+          std::numeric_limits<double>::max()))
+  {
+    if(auto it = m_intervals.m_map.find(itv->id()); it != m_intervals.m_map.end())
+      updateInterval(*it->second);
   }
 }
 
+std::optional<QRectF> ScenarioPresenter::visibleRect() const noexcept
+{
+  auto view = getView(*m_view);
+  if(!view)
+    return std::nullopt;
+
+  const auto sceneRect = view->mapToScene(view->viewport()->rect()).boundingRect();
+  return m_view->mapRectFromScene(sceneRect).intersected(m_view->boundingRect());
+}
+
 void ScenarioPresenter::selectLeft()
 {
   CategorisedScenario selection{this->model()};
@@ -132,6 +132,9 @@ private:
 
   void updateAllElements();
 
+  //! Part of the scenario visible in the view, in item coordinates
+  std::optional<QRectF> visibleRect() const noexcept;
+
   ZoomRatio m_zoomRatio{1};
 
   // The order of deletion matters!
@@ -0,0 +1,306 @@
+#include "ScenarioSpatialIndex.hpp"
+
+#include <Scenario/Document/Event/EventModel.hpp>
+#include <Scenario/Document/Interval/IntervalDurations.hpp>
+#include <Scenario/Document/Interval/IntervalModel.hpp>
+#include <Scenario/Document/State/StateModel.hpp>
+#include <Scenario/Document/TimeSync/TimeSyncModel.hpp>
+#include <Scenario/Process/ScenarioModel.hpp>
+
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/equals.hpp>
+
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+namespace Scenario
+{
+namespace bgi = boost::geometry::index;
+
+template <typename T>
+void SpatialIndex::DateIndex<T>::update(const T& elt, TimeVal date)
+{
+  remove(elt);
+  items[&elt] = dates.emplace(date.impl, &elt);
+}
+
+template <typename T>
+void SpatialIndex::DateIndex<T>::remove(const T& elt)
+{
+  if(auto it = items.find(&elt); it != items.end())
+  {
+    dates.erase(it->second);
+    items.erase(it);
+  }
+}
+
+template <typename T>
+std::vector<const T*> SpatialIndex::DateIndex<T>::query(TimeVal start, TimeVal end) const
+{
+  std::vector<const T*> res;
+  for(auto it = dates.lower_bound(start.impl), last = dates.upper_bound(end.impl);
+      it != last; ++it)
+    res.push_back(it->second);
+  return res;
+}
+
+template <typename T>
+void SpatialIndex::DateIndex<T>::clear()
+{
+  dates.clear();
+  items.clear();
+}
+
+template <typename T>
+void SpatialIndex::BoxIndex<T>::update(const T& elt, const Box& box)
+{
+  if(auto it = items.find(&elt); it != items.end())
+  {
+    if(boost::geometry::equals(it->second, box))
+      return;
+    tree.remove(Value{it->second, &elt});
+    items.erase(it);
+  }
+
+  tree.insert(Value{box, &elt});
+  items[&elt] = box;
+}
+
+template <typename T>
+void SpatialIndex::BoxIndex<T>::remove(const T& elt)
+{
+  if(auto it = items.find(&elt); it != items.end())
+  {
+    tree.remove(Value{it->second, &elt});
+    items.erase(it);
+  }
+}
+
+template <typename T>
+std::vector<const T*> SpatialIndex::BoxIndex<T>::query(const Box& box) const
+{
+  std::vector<const T*> res;
+  for(auto it = tree.qbegin(bgi::intersects(box)); it != tree.qend(); ++it)
+    res.push_back(it->second);
+  return res;
+}
+
+template <typename T>
+void SpatialIndex::BoxIndex<T>::clear()
+{
+  tree.clear();
+  items.clear();
+}
+
+SpatialIndex::SpatialIndex(const Scenario::ProcessModel& scenar)
+    : m_scenario{scenar}
+{
+  scenar.timeSyncs.added.connect<&SpatialIndex::on_timeSyncAdded>(this);
+  scenar.timeSyncs.removing.connect<&SpatialIndex::on_timeSyncRemoving>(this);
+  scenar.timeSyncs.replaced.connect<&SpatialIndex::rebuild>(this);
+  scenar.events.added.connect<&SpatialIndex::on_eventAdded>(this);
+  scenar.events.removing.connect<&SpatialIndex::on_eventRemoving>(this);
+  scenar.events.replaced.connect<&SpatialIndex::rebuild>(this);
+  scenar.intervals.added.connect<&SpatialIndex::on_intervalAdded>(this);
+  scenar.intervals.removing.connect<&SpatialIndex::on_intervalRemoving>(this);
+  scenar.intervals.replaced.connect<&SpatialIndex::rebuild>(this);
+  scenar.states.added.connect<&SpatialIndex::on_stateAdded>(this);
+  scenar.states.removing.connect<&SpatialIndex::on_stateRemoving>(this);
+  scenar.states.replaced.connect<&SpatialIndex::rebuild>(this);
+
+  rebuild();
+}
+
+SpatialIndex::~SpatialIndex() { }
+
+const TimeSyncModel*
+SpatialIndex::closestTimeSync(TimeVal t, const TimeSyncModel* ignored) const noexcept
+{
+  const auto& dates = m_timeSyncs.dates;
+  const TimeSyncModel* closest{};
+  int64_t closestDelta = std::numeric_limits<int64_t>::max();
+  auto check = [&](auto it) {
+    if(it->second == ignored)
+      return false;
+
+    const int64_t delta = std::abs(it->first - t.impl);
+    if(delta < closestDelta)
+    {
+      closestDelta = delta;
+      closest = it->second;
+    }
+    return true;
+  };
+
+  // Walk away from t on both sides until a candidate is found
+  const auto pos = dates.lower_bound(t.impl);
+  for(auto it = pos; it != dates.end(); ++it)
+    if(check(it))
+      break;
+  for(auto it = std::make_reverse_iterator(pos); it != dates.rend(); ++it)
+    if(check(it))
+      break;
+
+  return closest;
+}
+
+std::vector<const TimeSyncModel*> SpatialIndex::timeSyncs(TimeVal start, TimeVal end) const
+{
+  return m_timeSyncs.query(start, end);
+}
+
+std::vector<const EventModel*> SpatialIndex::events(TimeVal start, TimeVal end) const
+{
+  return m_events.query(start, end);
+}
+
+std::vector<const IntervalModel*>
+SpatialIndex::intervals(TimeVal start, TimeVal end, double top, double bottom) const
+{
+  return m_intervals.query(queryBox(start, end, top, bottom));
+}
+
+std::vector<const StateModel*>
+SpatialIndex::states(TimeVal start, TimeVal end, double top, double bottom) const
+{
+  return m_states.query(queryBox(start, end, top, bottom));
+}
+
+SpatialIndex::Box
+SpatialIndex::queryBox(TimeVal start, TimeVal end, double top, double bottom) noexcept
+{
+  return Box{Point{double(start.impl), top}, Point{double(end.impl), bottom}};
+}
+
+void SpatialIndex::rebuild()
+{
+  // Elements which were replaced have already been deleted, thus only the
+  // current ones have to be disconnected before being added again
+  auto disconnectAll = [this](const auto& map) {
+    for(const auto& elt : map)
+      QObject::disconnect(&elt, nullptr, this, nullptr);
+  };
+  disconnectAll(m_scenario.timeSyncs);
+  disconnectAll(m_scenario.events);
+  disconnectAll(m_scenario.states);
+  for(const IntervalModel& itv : m_scenario.intervals)
+  {
+    QObject::disconnect(&itv, nullptr, this, nullptr);
+    QObject::disconnect(&itv.duration, nullptr, this, nullptr);
+  }
+
+  m_timeSyncs.clear();
+  m_events.clear();
+  m_intervals.clear();
+  m_states.clear();
+
+  for(const auto& ts : m_scenario.timeSyncs)
+    on_timeSyncAdded(ts);
+  for(const auto& ev : m_scenario.events)
+    on_eventAdded(ev);
+  for(const auto& itv : m_scenario.intervals)
+    on_intervalAdded(itv);
+  for(const auto& st : m_scenario.states)
+    on_stateAdded(st);
+}
+
+void SpatialIndex::on_timeSyncAdded(const TimeSyncModel& ts)
+{
+  m_timeSyncs.update(ts, ts.date());
+  connect(&ts, &TimeSyncModel::dateChanged, this, [this, &ts](const TimeVal& t) {
+    m_timeSyncs.update(ts, t);
+  });
+}
+
+void SpatialIndex::on_timeSyncRemoving(const TimeSyncModel& ts)
+{
+  QObject::disconnect(&ts, nullptr, this, nullptr);
+  m_timeSyncs.remove(ts);
+}
+
+void SpatialIndex::on_eventAdded(const EventModel& ev)
+{
+  updateEvent(ev);
+  connect(&ev, &EventModel::dateChanged, this, [this, &ev] { updateEvent(ev); });
+  connect(&ev, &EventModel::statesChanged, this, [this, &ev] { updateEvent(ev); });
+}
+
+void SpatialIndex::on_eventRemoving(const EventModel& ev)
+{
+  QObject::disconnect(&ev, nullptr, this, nullptr);
+  m_events.remove(ev);
+}
+
+void SpatialIndex::updateEvent(const EventModel& ev)
+{
+  m_events.update(ev, ev.date());
+
+  // States take the date of their event
+  for(const auto& id : ev.states())
+    if(auto st = m_scenario.findState(id))
+      updateState(*st);
+}
+
+void SpatialIndex::on_intervalAdded(const IntervalModel& itv)
+{
+  updateInterval(itv);
+
+  auto update = [this, &itv] { updateInterval(itv); };
+  connect(&itv, &IntervalModel::dateChanged, this, update);
+  connect(&itv, &IntervalModel::heightPercentageChanged, this, update);
+  connect(&itv.duration, &IntervalDurations::defaultDurationChanged, this, update);
+  connect(&itv.duration, &IntervalDurations::maxDurationChanged, this, update);
+  connect(&itv.duration, &IntervalDurations::maxInfiniteChanged, this, update);
+}
+
+void SpatialIndex::on_intervalRemoving(const IntervalModel& itv)
+{
+  QObject::disconnect(&itv, nullptr, this, nullptr);
+  QObject::disconnect(&itv.duration, nullptr, this, nullptr);
+  m_intervals.remove(itv);
+}
+
+void SpatialIndex::updateInterval(const IntervalModel& itv)
+{
+  // Flexible intervals are drawn up to their maximum duration
+  const auto& dur = itv.duration;
+  TimeVal length = dur.defaultDuration();
+  if(!dur.isMaxInfinite())
+    length = std::max(length, dur.maxDuration());
+
+  const double y = itv.heightPercentage();
+  const double start = itv.date().impl;
+  m_intervals.update(itv, Box{Point{start, y}, Point{start + length.impl, y}});
+}
+
+void SpatialIndex::on_stateAdded(const StateModel& st)
+{
+  updateState(st);
+
+  auto update = [this, &st] { updateState(st); };
+  connect(&st, &StateModel::heightPercentageChanged, this, update);
+  connect(&st, &StateModel::eventChanged, this, update);
+}
+
+void SpatialIndex::on_stateRemoving(const StateModel& st)
+{
+  QObject::disconnect(&st, nullptr, this, nullptr);
+  m_states.remove(st);
+}
+
+void SpatialIndex::updateState(const StateModel& st)
+{
+  // When pasting, states may be added before their event:
+  // they are indexed once the event is added.
+  auto ev = m_scenario.findEvent(st.eventId());
+  if(!ev)
+  {
+    m_states.remove(st);
+    return;
+  }
+
+  const Point p{double(ev->date().impl), st.heightPercentage()};
+  m_states.update(st, Box{p, p});
+}
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <Process/TimeValue.hpp>
+
+#include <score/tools/std/HashMap.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <QObject>
+
+#include <nano_observer.hpp>
+#include <score_plugin_scenario_export.h>
+
+#include <map>
+#include <vector>
+
+namespace Scenario
+{
+class TimeSyncModel;
+class IntervalModel;
+class EventModel;
+class StateModel;
+class ProcessModel;
+
+/**
+ * @brief Spatial index of the elements of a scenario.
+ *
+ * Elements are indexed in the scenario coordinates: dates on the horizontal
+ * axis, height percentages on the vertical axis.
+ * Time syncs and events only have a date and are kept sorted by date ;
+ * intervals and states are kept in an R-tree.
+ *
+ * The index is maintained incrementally from the signals of the elements,
+ * so that hit-testing, rubber-band selection, culling and magnetism do not
+ * have to go through every element of large scenarios.
+ *
+ * Queries are conservative for the vertical axis of intervals, as their
+ * rack extends below their height percentage: callers are expected to
+ * check the actual geometry of the returned elements.
+ */
+class SCORE_PLUGIN_SCENARIO_EXPORT SpatialIndex final
+    : public QObject
+    , public Nano::Observer
+{
+public:
+  explicit SpatialIndex(const Scenario::ProcessModel& scenar);
+  ~SpatialIndex();
+
+  //! Closest time sync to t, other than ignored
+  const TimeSyncModel*
+  closestTimeSync(TimeVal t, const TimeSyncModel* ignored = nullptr) const noexcept;
+
+  //! Elements whose date is in [start; end]
+  std::vector<const TimeSyncModel*> timeSyncs(TimeVal start, TimeVal end) const;
+  std::vector<const EventModel*> events(TimeVal start, TimeVal end) const;
+
+  //! Elements which intersect [start; end] x [top; bottom]
+  std::vector<const IntervalModel*>
+  intervals(TimeVal start, TimeVal end, double top, double bottom) const;
+  std::vector<const StateModel*>
+  states(TimeVal start, TimeVal end, double top, double bottom) const;
+
+private:
+  using Point = boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian>;
+  using Box = boost::geometry::model::box<Point>;
+
+  template <typename T>
+  struct DateIndex
+  {
+    std::multimap<int64_t, const T*> dates;
+    score::hash_map<const T*, typename std::multimap<int64_t, const T*>::iterator> items;
+
+    void update(const T& elt, TimeVal date);
+    void remove(const T& elt);
+    std::vector<const T*> query(TimeVal start, TimeVal end) const;
+    void clear();
+  };
+
+  template <typename T>
+  struct BoxIndex
+  {
+    using Value = std::pair<Box, const T*>;
+    boost::geometry::index::rtree<Value, boost::geometry::index::quadratic<16>> tree;
+    score::hash_map<const T*, Box> items;
+
+    void update(const T& elt, const Box& box);
+    void remove(const T& elt);
+    std::vector<const T*> query(const Box& box) const;
+    void clear();
+  };
+
+  void rebuild();
+
+  void on_timeSyncAdded(const TimeSyncModel& ts);
+  void on_timeSyncRemoving(const TimeSyncModel& ts);
+  void on_eventAdded(const EventModel& ev);
+  void on_eventRemoving(const EventModel& ev);
+  void on_intervalAdded(const IntervalModel& itv);
+  void on_intervalRemoving(const IntervalModel& itv);
+  void on_stateAdded(const StateModel& st);
+  void on_stateRemoving(const StateModel& st);
+
+  void updateEvent(const EventModel& ev);
+  void updateInterval(const IntervalModel& itv);
+  void updateState(const StateModel& st);
+
+  static Box queryBox(TimeVal start, TimeVal end, double top, double bottom) noexcept;
+
+  const Scenario::ProcessModel& m_scenario;
+
+  DateIndex<TimeSyncModel> m_timeSyncs;
+  DateIndex<EventModel> m_events;
+  BoxIndex<IntervalModel> m_intervals;
+  BoxIndex<StateModel> m_states;
+};
+}
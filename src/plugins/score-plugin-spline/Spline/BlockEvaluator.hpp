@@ -0,0 +1,125 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace Spline
+{
+/**
+ * @brief Evaluates a spline for whole blocks of positions.
+ *
+ * The curve is the same as the one drawn by the UI with ts::spline: a clamped,
+ * uniform B-spline of degree 3, or less when there are not enough points.
+ *
+ * Evaluation does not allocate and keeps the current knot span from one
+ * position to the next, so that it can run on the audio thread at audio rate.
+ */
+template <std::size_t N>
+class BlockEvaluator
+{
+public:
+  static constexpr int maxDegree = 3;
+
+  //! Points are given as N interleaved coordinates, e.g. ossia::spline_point.
+  void setPoints(const double* points, std::size_t count)
+  {
+    m_points.assign(points, points + count * N);
+    m_count = int(count);
+    m_degree = std::min(maxDegree, m_count - 1);
+
+    m_knots.clear();
+    if(m_count == 0)
+      return;
+
+    const int segments = m_count - m_degree;
+    m_knots.reserve(m_count + m_degree + 1);
+    for(int i = 0; i <= m_degree; i++)
+      m_knots.push_back(0.);
+    for(int i = 1; i < segments; i++)
+      m_knots.push_back(double(i) / segments);
+    for(int i = 0; i <= m_degree; i++)
+      m_knots.push_back(1.);
+
+    m_span = m_degree;
+  }
+
+  bool empty() const noexcept { return m_count == 0; }
+
+  std::array<double, N> evaluate(double t) noexcept
+  {
+    std::array<double, N> res{};
+    if(m_count > 0)
+      evaluate(t, res.data());
+    return res;
+  }
+
+  /**
+   * @brief Writes the curve at the positions t[0..n) in out[0..N)[0..n).
+   *
+   * Positions are clamped to [0; 1].
+   * The lookup of the knot span is amortized when they are sorted.
+   */
+  void evaluate(const double* t, double* const* out, std::size_t n) noexcept
+  {
+    if(m_count == 0)
+    {
+      for(std::size_t d = 0; d < N; d++)
+        std::fill_n(out[d], n, 0.);
+      return;
+    }
+
+    double res[N];
+    for(std::size_t i = 0; i < n; i++)
+    {
+      evaluate(t[i], res);
+      for(std::size_t d = 0; d < N; d++)
+        out[d][i] = res[d];
+    }
+  }
+
+private:
+  void evaluate(double t, double* res) noexcept
+  {
+    t = std::clamp(t, 0., 1.);
+    const int p = m_degree;
+    const double* knots = m_knots.data();
+
+    // Find k such as knots[k] <= t < knots[k + 1], starting from the last one
+    int k = m_span;
+    const int last = m_count - 1;
+    while(k < last && t >= knots[k + 1])
+      k++;
+    while(k > p && t < knots[k])
+      k--;
+    m_span = k;
+
+    // De Boor's algorithm
+    double d[maxDegree + 1][N];
+    for(int j = 0; j <= p; j++)
+      for(std::size_t c = 0; c < N; c++)
+        d[j][c] = m_points[(j + k - p) * N + c];
+
+    for(int r = 1; r <= p; r++)
+    {
+      for(int j = p; j >= r; j--)
+      {
+        const double k0 = knots[j + k - p];
+        const double k1 = knots[j + 1 + k - r];
+        const double alpha = k1 > k0 ? (t - k0) / (k1 - k0) : 0.;
+        for(std::size_t c = 0; c < N; c++)
+          d[j][c] = (1. - alpha) * d[j - 1][c] + alpha * d[j][c];
+      }
+    }
+
+    for(std::size_t c = 0; c < N; c++)
+      res[c] = d[p][c];
+  }
+
+  std::vector<double> m_points;
+  std::vector<double> m_knots;
+  int m_count{};
+  int m_degree{};
+  int m_span{};
+};
+}
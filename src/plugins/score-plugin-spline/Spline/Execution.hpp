@@ -25,6 +25,7 @@ public:
 
 private:
   void recompute();
+  void updateAudioRate();
 };
 using ComponentFactory = ::Execution::ProcessComponentFactory_T<Component>;
 }
@@ -17,6 +17,7 @@ ProcessModel::ProcessModel(
     : Process::
         ProcessModel{duration, id, Metadata<ObjectKey_k, ProcessModel>::get(), parent}
     , outlet{Process::make_value_outlet(Id<Process::Port>(0), this)}
+    , audio_outlet{Process::make_audio_outlet(Id<Process::Port>(1), this)}
 {
   m_spline.points.push_back({0., 0.});
 
@@ -37,7 +38,9 @@ ProcessModel::~ProcessModel() { }
 void ProcessModel::init()
 {
   outlet->setName("Out");
+  audio_outlet->setName("Audio");
   m_outlets.push_back(outlet.get());
+  m_outlets.push_back(audio_outlet.get());
   connect(
       outlet.get(), &Process::Port::addressChanged, this,
       [=](const State::AddressAccessor& arg) {
@@ -178,7 +181,7 @@ void DataStreamWriter::write(ossia::spline_data& autom)
 template <>
 void DataStreamReader::read(const Spline::ProcessModel& autom)
 {
-  m_stream << *autom.outlet << autom.m_spline << autom.m_tween;
+  m_stream << *autom.outlet << *autom.audio_outlet << autom.m_spline << autom.m_tween;
 
   insertDelimiter();
 }
@@ -186,6 +189,7 @@ template <>
 void DataStreamWriter::write(Spline::ProcessModel& autom)
 {
   autom.outlet = Process::load_value_outlet(*this, &autom);
+  autom.audio_outlet = Process::load_audio_outlet(*this, &autom);
   m_stream >> autom.m_spline >> autom.m_tween;
 
   checkDelimiter();
@@ -195,6 +199,7 @@ template <>
 void JSONReader::read(const Spline::ProcessModel& autom)
 {
   obj["Outlet"] = *autom.outlet;
+  obj["AudioOutlet"] = *autom.audio_outlet;
   obj["Spline"] = autom.m_spline.points;
   obj["Tween"] = autom.tween();
 }
@@ -205,6 +210,16 @@ void JSONWriter::write(Spline::ProcessModel& autom)
   JSONWriter writer{obj["Outlet"]};
   autom.outlet = Process::load_value_outlet(writer, &autom);
 
+  if(auto outl = obj.tryGet("AudioOutlet"))
+  {
+    JSONWriter writer{*outl};
+    autom.audio_outlet = Process::load_audio_outlet(writer, &autom);
+  }
+  else
+  {
+    autom.audio_outlet = Process::make_audio_outlet(Id<Process::Port>(1), &autom);
+  }
+
   autom.setTween(obj["Tween"].toBool());
   autom.m_spline.points <<= obj["Spline"];
 }
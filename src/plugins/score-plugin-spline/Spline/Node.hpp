@@ -0,0 +1,90 @@
+#pragma once
+#include <ossia/dataflow/graph_node.hpp>
+#include <ossia/dataflow/port.hpp>
+
+#include <Spline/BlockEvaluator.hpp>
+
+namespace Spline
+{
+/**
+ * @brief Execution of the Spline and Spline 3D processes.
+ *
+ * The value outlet gets the position on the curve once per tick.
+ * When the audio outlet is used, it gets one channel per coordinate with the
+ * position for each sample of the tick, e.g. to drive spatialization without
+ * zipper noise.
+ */
+template <std::size_t N>
+class Node final : public ossia::nonowning_graph_node
+{
+public:
+  ossia::value_outlet value_out;
+  ossia::audio_outlet audio_out;
+
+  Node()
+  {
+    m_outlets.push_back(&value_out);
+    m_outlets.push_back(&audio_out);
+  }
+
+  //! The previous evaluator is given back so that it gets freed outside of this thread.
+  void setSpline(BlockEvaluator<N>& spline) noexcept { std::swap(m_spline, spline); }
+  void setAudioRate(bool b) noexcept { m_audioRate = b; }
+
+  void run(const ossia::token_request& tk, ossia::exec_state_facade st) noexcept override
+  {
+    const auto [tick_start, d] = st.timings(tk);
+    const double end = tk.position();
+
+    const auto v = m_spline.evaluate(end);
+    if constexpr(N == 2)
+      value_out.target<ossia::value_port>()->write_value(
+          ossia::vec2f{float(v[0]), float(v[1])}, tick_start);
+    else
+      value_out.target<ossia::value_port>()->write_value(
+          ossia::vec3f{float(v[0]), float(v[1]), float(v[2])}, tick_start);
+
+    if(m_audioRate && d > 0)
+      runAudio(tk, st, tick_start, d, end);
+  }
+
+private:
+  void runAudio(
+      const ossia::token_request& tk, ossia::exec_state_facade st, int64_t tick_start,
+      int64_t d, double end) noexcept
+  {
+    auto& port = *audio_out.target<ossia::audio_port>();
+    port.set_channels(N);
+    auto& ap = port.get();
+
+    double* out[N];
+    for(std::size_t c = 0; c < N; c++)
+    {
+      ap[c].resize(st.bufferSize());
+      out[c] = ap[c].data() + tick_start;
+    }
+
+    // Positions are interpolated linearly across the tick,
+    // the last sample being at the position sent to the value outlet.
+    const double dur = tk.parent_duration.impl;
+    const double start = dur > 0 ? tk.prev_date.impl / dur : end;
+    const double step = (end - start) / d;
+
+    static constexpr int64_t block = 64;
+    double positions[block];
+    for(int64_t i = 0; i < d; i += block)
+    {
+      const int64_t n = std::min(block, d - i);
+      for(int64_t k = 0; k < n; k++)
+        positions[k] = start + step * (i + k + 1);
+
+      m_spline.evaluate(positions, out, n);
+      for(std::size_t c = 0; c < N; c++)
+        out[c] += n;
+    }
+  }
+
+  BlockEvaluator<N> m_spline;
+  bool m_audioRate{};
+};
+}
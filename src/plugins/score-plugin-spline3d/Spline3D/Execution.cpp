@@ -2,16 +2,17 @@
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include "Execution.hpp"
 
+#include <Process/Dataflow/Port.hpp>
 #include <Process/ExecutionContext.hpp>
 
 #include <score/tools/Bind.hpp>
 
-#include <ossia/dataflow/nodes/spline.hpp>
+#include <Spline/Node.hpp>
 namespace Spline3D
 {
 namespace RecreateOnPlay
 {
-using spline = ossia::nodes::spline3d;
+using spline = Spline::Node<3>;
 Component::Component(
     ::Spline3D::ProcessModel& element, const ::Execution::Context& ctx, QObject* parent)
     : ::Execution::ProcessComponent_T<Spline3D::ProcessModel, ossia::node_process>{
@@ -24,15 +25,38 @@ Component::Component(
   con(element, &Spline3D::ProcessModel::splineChanged, this,
       [this] { this->recompute(); });
 
+  // Per-sample positions are only computed when someone listens to them
+  auto& audio = *element.audio_outlet;
+  con(audio, &Process::Port::cablesChanged, this, [this] { this->updateAudioRate(); });
+  con(audio, &Process::Port::addressChanged, this, [this] { this->updateAudioRate(); });
+  con(audio, &Process::AudioOutlet::propagateChanged, this,
+      [this] { this->updateAudioRate(); });
+
   recompute();
+  updateAudioRate();
 }
 
 Component::~Component() { }
 
 void Component::recompute()
 {
+  const auto& points = process().spline().points;
+  Spline::BlockEvaluator<3> g;
+  g.setPoints(reinterpret_cast<const double*>(points.data()), points.size());
+
   in_exec([proc = std::dynamic_pointer_cast<spline>(OSSIAProcess().node),
-           g = process().spline()] { proc->set_spline(g); });
+           g = std::move(g)]() mutable { proc->setSpline(g); });
+}
+
+void Component::updateAudioRate()
+{
+  const auto& audio = *process().audio_outlet;
+  const bool used = !audio.cables().empty() || audio.propagate()
+                    || audio.address().isSet();
+
+  in_exec([proc = std::dynamic_pointer_cast<spline>(OSSIAProcess().node), used] {
+    proc->setAudioRate(used);
+  });
 }
 }
 }
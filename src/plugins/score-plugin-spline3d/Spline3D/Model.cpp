@@ -17,6 +17,7 @@ ProcessModel::ProcessModel(
     : Process::
         ProcessModel{duration, id, Metadata<ObjectKey_k, ProcessModel>::get(), parent}
     , outlet{Process::make_value_outlet(Id<Process::Port>(0), this)}
+    , audio_outlet{Process::make_audio_outlet(Id<Process::Port>(1), this)}
 {
   m_spline.points.push_back({0., 0., 0.});
 
@@ -37,7 +38,9 @@ ProcessModel::~ProcessModel() { }
 void ProcessModel::init()
 {
   outlet->setName("Out");
+  audio_outlet->setName("Audio");
   m_outlets.push_back(outlet.get());
+  m_outlets.push_back(audio_outlet.get());
   connect(
       outlet.get(), &Process::Port::addressChanged, this,
       [=](const State::AddressAccessor& arg) {
@@ -180,7 +183,7 @@ void DataStreamWriter::write(ossia::spline3d_data& autom)
 template <>
 void DataStreamReader::read(const Spline3D::ProcessModel& autom)
 {
-  m_stream << *autom.outlet << autom.m_spline << autom.m_tween;
+  m_stream << *autom.outlet << *autom.audio_outlet << autom.m_spline << autom.m_tween;
 
   insertDelimiter();
 }
@@ -188,6 +191,7 @@ template <>
 void DataStreamWriter::write(Spline3D::ProcessModel& autom)
 {
   autom.outlet = Process::load_value_outlet(*this, &autom);
+  autom.audio_outlet = Process::load_audio_outlet(*this, &autom);
   m_stream >> autom.m_spline >> autom.m_tween;
 
   checkDelimiter();
@@ -197,6 +201,7 @@ template <>
 void JSONReader::read(const Spline3D::ProcessModel& autom)
 {
   obj["Outlet"] = *autom.outlet;
+  obj["AudioOutlet"] = *autom.audio_outlet;
   obj["Spline"] = autom.m_spline.points;
   obj["Tween"] = autom.tween();
 }
@@ -207,6 +212,16 @@ void JSONWriter::write(Spline3D::ProcessModel& autom)
   JSONWriter writer{obj["Outlet"]};
   autom.outlet = Process::load_value_outlet(writer, &autom);
 
+  if(auto outl = obj.tryGet("AudioOutlet"))
+  {
+    JSONWriter writer{*outl};
+    autom.audio_outlet = Process::load_audio_outlet(writer, &autom);
+  }
+  else
+  {
+    autom.audio_outlet = Process::make_audio_outlet(Id<Process::Port>(1), &autom);
+  }
+
   autom.setTween(obj["Tween"].toBool());
   autom.m_spline.points <<= obj["Spline"];
 }
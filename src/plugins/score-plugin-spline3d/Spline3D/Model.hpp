@@ -65,6 +65,7 @@ public:
   }
 
   std::unique_ptr<Process::Outlet> outlet;
+  std::unique_ptr<Process::AudioOutlet> audio_outlet;
 
   void addressChanged(const ::State::AddressAccessor& arg_1)
       W_SIGNAL(addressChanged, arg_1);
@@ -1,5 +1,6 @@
 #pragma once
 #include <Process/Dataflow/TimeSignature.hpp>
+#include <Process/Execution/TickArena.hpp>
 
 #include <Vst/EffectModel.hpp>
 
@@ -283,8 +284,8 @@ public:
     std::memset(events, 0, sz);
     events->numEvents = n_mess;
 
-    ossia::small_vector<VstMidiEvent, 16> vec;
-    vec.resize(n_mess);
+    // Only needed until the plug-in has processed them
+    Execution::tick_vector<VstMidiEvent> vec(n_mess);
     std::size_t i = 0;
     for(libremidi::message& mess : ip)
     {
@@ -0,0 +1,149 @@
+#include <score/model/IdentifiedObjectMap.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Measures the IdContainer used by all the model objects (EntityMap):
+// insertion, removal, lookup by id and ordered iteration.
+
+struct BenchElement : IdentifiedObject<BenchElement>
+{
+  BenchElement(int32_t id)
+      : IdentifiedObject<BenchElement>{Id<BenchElement>{id}, "BenchElement", nullptr}
+  {
+  }
+
+  int64_t payload{};
+};
+
+using BenchContainer = IdContainer<BenchElement>;
+
+static std::vector<BenchElement*> makeElements(int64_t count)
+{
+  std::vector<BenchElement*> elts;
+  elts.reserve(count);
+  for(int32_t i = 0; i < count; i++)
+    elts.push_back(new BenchElement{i});
+  return elts;
+}
+
+static std::vector<int32_t> shuffledIds(int64_t count)
+{
+  std::vector<int32_t> ids(count);
+  for(int32_t i = 0; i < count; i++)
+    ids[i] = i;
+  std::shuffle(ids.begin(), ids.end(), std::mt19937{1234});
+  return ids;
+}
+
+static void idcontainer_insert(benchmark::State& state)
+{
+  const auto elts = makeElements(state.range(0));
+  for(auto _ : state)
+  {
+    BenchContainer c;
+    for(auto e : elts)
+      c.insert(e);
+    benchmark::DoNotOptimize(c.size());
+
+    // So that the elements are not deleted with the container
+    c.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+
+  for(auto e : elts)
+    delete e;
+}
+BENCHMARK(idcontainer_insert)->Arg(10000)->Arg(50000)->Arg(100000);
+
+static void idcontainer_remove(benchmark::State& state)
+{
+  const auto elts = makeElements(state.range(0));
+  const auto ids = shuffledIds(state.range(0));
+  for(auto _ : state)
+  {
+    state.PauseTiming();
+    auto c = std::make_unique<BenchContainer>();
+    for(auto e : elts)
+      c->insert(e);
+    state.ResumeTiming();
+
+    for(auto id : ids)
+      c->remove(Id<BenchElement>{id});
+    benchmark::DoNotOptimize(c->size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+
+  for(auto e : elts)
+    delete e;
+}
+BENCHMARK(idcontainer_remove)->Arg(10000)->Arg(50000)->Arg(100000);
+
+static void idcontainer_lookup(benchmark::State& state)
+{
+  BenchContainer c;
+  for(auto e : makeElements(state.range(0)))
+    c.insert(e);
+
+  std::vector<Id<BenchElement>> ids;
+  for(auto id : shuffledIds(state.range(0)))
+    ids.push_back(Id<BenchElement>{id});
+
+  for(auto _ : state)
+  {
+    int64_t sum = 0;
+    // Copies of identifiers do not carry the cached pointer to their object
+    for(Id<BenchElement> id : ids)
+      sum += c.at(id).payload;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(idcontainer_lookup)->Arg(10000)->Arg(50000)->Arg(100000);
+
+static void idcontainer_iterate(benchmark::State& state)
+{
+  BenchContainer c;
+  for(auto e : makeElements(state.range(0)))
+    c.insert(e);
+
+  for(auto _ : state)
+  {
+    int64_t sum = 0;
+    for(const BenchElement& e : c)
+      sum += e.payload;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(idcontainer_iterate)->Arg(10000)->Arg(50000)->Arg(100000);
+
+// Iteration after removing every other element, before any compaction
+static void idcontainer_iterate_sparse(benchmark::State& state)
+{
+  BenchContainer c;
+  const auto elts = makeElements(state.range(0));
+  for(auto e : elts)
+    c.insert(e);
+  for(std::size_t i = 0; i < elts.size(); i += 2)
+  {
+    c.remove(elts[i]->id());
+    delete elts[i];
+  }
+
+  for(auto _ : state)
+  {
+    int64_t sum = 0;
+    for(const BenchElement& e : c)
+      sum += e.payload;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * c.size());
+}
+BENCHMARK(idcontainer_iterate_sparse)->Arg(10000)->Arg(50000)->Arg(100000);
+
+BENCHMARK_MAIN();